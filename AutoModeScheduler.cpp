@@ -0,0 +1,196 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "AutoModeScheduler.h"
+#include "DataModel/Loco.h"
+#include "Utils/Utils.h"
+
+const unsigned char AutoModeScheduler::DefaultNrOfWorkers;
+const unsigned int AutoModeScheduler::RetryIntervalMs;
+
+AutoModeScheduler::AutoModeScheduler(const unsigned char nrOfWorkers)
+:	run(true)
+{
+	const unsigned char nr = nrOfWorkers == 0 ? DefaultNrOfWorkers : nrOfWorkers;
+	for (unsigned char i = 0; i < nr; ++i)
+	{
+		workers.push_back(std::thread(&AutoModeScheduler::Worker, this));
+	}
+}
+
+AutoModeScheduler::~AutoModeScheduler()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		run = false;
+	}
+	workAvailable.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void AutoModeScheduler::Trigger(DataModel::Loco* loco)
+{
+	if (loco == nullptr)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		EnqueueUnlocked(loco);
+	}
+	workAvailable.notify_one();
+}
+
+void AutoModeScheduler::TriggerAt(DataModel::Loco* loco, const Clock::time_point& time)
+{
+	if (loco == nullptr)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		RemoveTimerUnlocked(loco);
+		timers.insert(std::make_pair(time, loco));
+		timerOfLoco[loco] = time;
+	}
+	// the new timer may expire before the one a worker is waiting for
+	workAvailable.notify_one();
+}
+
+void AutoModeScheduler::TriggerWaiting()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		if (timers.empty())
+		{
+			return;
+		}
+		for (auto& timer : timers)
+		{
+			EnqueueUnlocked(timer.second);
+		}
+		timers.clear();
+		timerOfLoco.clear();
+	}
+	workAvailable.notify_all();
+}
+
+void AutoModeScheduler::Cancel(DataModel::Loco* loco)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	RemoveTimerUnlocked(loco);
+	if (readySet.erase(loco) > 0)
+	{
+		for (auto it = ready.begin(); it != ready.end(); ++it)
+		{
+			if (*it == loco)
+			{
+				ready.erase(it);
+				break;
+			}
+		}
+	}
+	triggeredWhileRunning.erase(loco);
+	while (running.count(loco) == 1)
+	{
+		if (running.at(loco) == std::this_thread::get_id())
+		{
+			// called from within the step of this loco
+			return;
+		}
+		stepFinished.wait(lock);
+	}
+}
+
+void AutoModeScheduler::EnqueueUnlocked(DataModel::Loco* loco)
+{
+	if (running.count(loco) == 1)
+	{
+		triggeredWhileRunning.insert(loco);
+		return;
+	}
+	if (readySet.insert(loco).second == false)
+	{
+		return;
+	}
+	ready.push_back(loco);
+}
+
+void AutoModeScheduler::RemoveTimerUnlocked(DataModel::Loco* loco)
+{
+	auto it = timerOfLoco.find(loco);
+	if (it == timerOfLoco.end())
+	{
+		return;
+	}
+	timers.erase(std::make_pair(it->second, loco));
+	timerOfLoco.erase(it);
+}
+
+void AutoModeScheduler::Worker()
+{
+	Utils::Utils::SetMinThreadPriority();
+	Utils::Utils::SetThreadName("AutoMode");
+	std::unique_lock<std::mutex> lock(mutex);
+	while (run)
+	{
+		const Clock::time_point now = Clock::now();
+		while (timers.empty() == false && timers.begin()->first <= now)
+		{
+			DataModel::Loco* loco = timers.begin()->second;
+			timers.erase(timers.begin());
+			timerOfLoco.erase(loco);
+			EnqueueUnlocked(loco);
+		}
+
+		if (ready.empty())
+		{
+			if (timers.empty())
+			{
+				workAvailable.wait(lock);
+			}
+			else
+			{
+				workAvailable.wait_until(lock, timers.begin()->first);
+			}
+			continue;
+		}
+
+		DataModel::Loco* loco = ready.front();
+		ready.pop_front();
+		readySet.erase(loco);
+		running[loco] = std::this_thread::get_id();
+
+		lock.unlock();
+		loco->AutoModeStep();
+		lock.lock();
+
+		running.erase(loco);
+		if (triggeredWhileRunning.erase(loco) > 0)
+		{
+			EnqueueUnlocked(loco);
+			workAvailable.notify_one();
+		}
+		stepFinished.notify_all();
+	}
+}
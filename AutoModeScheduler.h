@@ -0,0 +1,92 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace DataModel
+{
+	class Loco;
+}
+
+// Runs the automode steps of all locos on a small pool of worker threads.
+// A loco is stepped when it is triggered by an event (feedback reached, route
+// or track released, manual mode requested) or when its timer expires.
+// One loco is never stepped by two workers at the same time.
+class AutoModeScheduler
+{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		static const unsigned char DefaultNrOfWorkers = 2;
+		static const unsigned int RetryIntervalMs = 1000;
+
+		AutoModeScheduler() = delete;
+		AutoModeScheduler(const AutoModeScheduler&) = delete;
+		AutoModeScheduler& operator=(const AutoModeScheduler&) = delete;
+
+		AutoModeScheduler(const unsigned char nrOfWorkers);
+		~AutoModeScheduler();
+
+		// step the loco as soon as possible
+		void Trigger(DataModel::Loco* loco);
+
+		// step the loco at the given time unless it is triggered earlier
+		void TriggerAt(DataModel::Loco* loco, const Clock::time_point& time);
+
+		// step the loco after the retry interval
+		inline void TriggerRetry(DataModel::Loco* loco)
+		{
+			TriggerAt(loco, Clock::now() + std::chrono::milliseconds(RetryIntervalMs));
+		}
+
+		// something has been released. All locos waiting on a timer get a chance to go on now.
+		void TriggerWaiting();
+
+		// remove all pending steps of the loco and wait until a running step has finished
+		void Cancel(DataModel::Loco* loco);
+
+	private:
+		void Worker();
+		void EnqueueUnlocked(DataModel::Loco* loco);
+		void RemoveTimerUnlocked(DataModel::Loco* loco);
+
+		std::mutex mutex;
+		std::condition_variable workAvailable;
+		std::condition_variable stepFinished;
+
+		std::deque<DataModel::Loco*> ready;
+		std::set<DataModel::Loco*> readySet;
+		std::set<std::pair<Clock::time_point,DataModel::Loco*>> timers;
+		std::map<DataModel::Loco*,Clock::time_point> timerOfLoco;
+		std::map<DataModel::Loco*,std::thread::id> running;
+		std::set<DataModel::Loco*> triggeredWhileRunning;
+
+		volatile bool run;
+		std::vector<std::thread> workers;
+};
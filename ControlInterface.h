@@ -29,6 +29,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/LocoFunctions.h"
 #include "DataTypes.h"
 #include "Hardware/Capabilities.h"
+#include "Languages.h"
 
 namespace DataModel
 {
@@ -61,6 +62,7 @@ class ControlInterface
 		virtual void ArgumentTypes(__attribute__((unused)) std::map<unsigned char,ArgumentType>& argumentTypes) const {}
 		virtual void Booster(__attribute__((unused)) const ControlType controlType, __attribute__((unused)) const BoosterState state) {};
 		virtual Hardware::Capabilities GetCapabilities() const { return Hardware::CapabilityNone; }
+		virtual void GetStatistics(__attribute__((unused)) std::map<Languages::TextSelector,uint64_t>& statistics) const {}
 		inline bool CanHandle(const Hardware::Capabilities capability) const
 		{
 			Hardware::Capabilities hardwareCapabilities = GetCapabilities();
@@ -69,6 +71,13 @@ class ControlInterface
 		virtual void FeedbackDelete(__attribute__((unused)) const FeedbackID feedbackID, __attribute__((unused)) const std::string& name) {}
 		virtual void FeedbackSettings(__attribute__((unused)) const FeedbackID feedbackID, __attribute__((unused)) const std::string& name) {}
 		virtual void FeedbackState(__attribute__((unused)) const std::string& name, __attribute__((unused)) const FeedbackID feedbackID, __attribute__((unused)) const DataModel::Feedback::FeedbackState state) {};
+		virtual void FeedbackStates(const std::vector<DataModel::Feedback::StateChange>& changes)
+		{
+			for (auto& change : changes)
+			{
+				FeedbackState(change.name, change.feedbackID, change.state);
+			}
+		}
 		virtual void LayerDelete(__attribute__((unused)) const LayerID layerID, __attribute__((unused)) const std::string& name) {};
 		virtual void LayerSettings(__attribute__((unused)) const LayerID layerID, __attribute__((unused)) const std::string& name) {};
 		virtual void LocoDelete(__attribute__((unused)) const LocoID locoID, __attribute__((unused)) const std::string& name) {};
@@ -103,18 +112,13 @@ class ControlInterface
 		virtual void ClusterDelete(__attribute__((unused)) const ClusterID signalID, __attribute__((unused)) const std::string& name) {};
 		virtual void ClusterSettings(__attribute__((unused)) const ClusterID signalID, __attribute__((unused)) const std::string& name) {};
 
-		virtual void LocoSpeedOrientationFunctions(const DataModel::Loco* loco,
-			const Speed speed,
-			const Orientation orientation,
-			std::vector<DataModel::LocoFunctionEntry>& functions)
-		{
-			LocoSpeed(ControlTypeInternal, loco, speed);
-			LocoOrientation(ControlTypeInternal, loco, orientation);
-			for (const DataModel::LocoFunctionEntry& functionEntry : functions)
-			{
-				LocoFunction(ControlTypeInternal, loco, functionEntry.nr, functionEntry.state);
-			}
-		}
+		// sends the complete state of a loco of this control, used to sync the command station
+		virtual void LocoSpeedOrientationFunctions(__attribute__((unused)) const Protocol protocol,
+			__attribute__((unused)) const Address address,
+			__attribute__((unused)) const Speed speed,
+			__attribute__((unused)) const Orientation orientation,
+			__attribute__((unused)) std::vector<DataModel::LocoFunctionEntry>& functions)
+		{}
 
 		virtual void ProgramRead(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv) {}
 		virtual void ProgramWrite(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv, __attribute__((unused)) const CvValue value) {}
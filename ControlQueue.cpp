@@ -0,0 +1,250 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+
+#include "ControlInterface.h"
+#include "ControlQueue.h"
+#include "DataModel/Loco.h"
+#include "Utils/Utils.h"
+
+const size_t ControlQueue::QueueSize;
+
+ControlQueue::ControlQueue(const ControlID controlID, ControlInterface* control, const unsigned int locoSpeedIntervalMs)
+:	controlID(controlID),
+	control(control),
+	queue(QueueSize, Utils::QueueOverflowBlock),
+	enqueued(0),
+	maxDepth(0),
+	lastBarrier(0),
+	locoSpeedIntervalMs(locoSpeedIntervalMs),
+	coalesced(0),
+	executed(0)
+{
+	thread = std::thread(&ControlQueue::Worker, this);
+}
+
+ControlQueue::~ControlQueue()
+{
+	queue.Terminate();
+	thread.join();
+}
+
+void ControlQueue::Enqueue(Command&& command)
+{
+	{
+		std::lock_guard<std::mutex> guard(speedMutex);
+		lastBarrier = ++enqueued;
+	}
+	Push(QueueEntry { std::move(command), nullptr, nullptr });
+}
+
+void ControlQueue::EnqueueLocoSpeed(const ControlType controlType, const DataModel::Loco* loco, const Speed speed)
+{
+	const LocoID locoID = loco->GetID();
+	std::shared_ptr<PendingSpeed> pendingSpeed;
+	{
+		std::lock_guard<std::mutex> guard(speedMutex);
+		auto pending = pendingSpeeds.find(locoID);
+		if (pending != pendingSpeeds.end() && pending->second->sent == false && pending->second->sequence > lastBarrier)
+		{
+			// latest value wins
+			pending->second->controlType = controlType;
+			pending->second->speed = speed;
+			++coalesced;
+			return;
+		}
+		pendingSpeed = std::make_shared<PendingSpeed>();
+		pendingSpeed->sequence = ++enqueued;
+		pendingSpeed->controlType = controlType;
+		pendingSpeed->speed = speed;
+		pendingSpeed->sent = false;
+		pendingSpeeds[locoID] = pendingSpeed;
+	}
+	Push(QueueEntry { nullptr, loco, std::move(pendingSpeed) });
+}
+
+void ControlQueue::Push(QueueEntry&& entry)
+{
+	if (queue.Enqueue(std::move(entry)) == false)
+	{
+		// queue has been terminated, the command is counted as done for Flush
+		std::lock_guard<std::mutex> guard(executedMutex);
+		++executed;
+		return;
+	}
+	unsigned long long executedNow;
+	{
+		std::lock_guard<std::mutex> guard(executedMutex);
+		executedNow = executed;
+	}
+	const size_t depth = enqueued - executedNow;
+	size_t maxDepthNow = maxDepth;
+	while (depth > maxDepthNow && maxDepth.compare_exchange_weak(maxDepthNow, depth) == false)
+	{
+	}
+}
+
+void ControlQueue::SendLocoSpeed(const DataModel::Loco* loco, const std::shared_ptr<PendingSpeed>& pendingSpeed)
+{
+	const LocoID locoID = loco->GetID();
+	auto deferred = deferredSpeeds.find(locoID);
+	if (deferred != deferredSpeeds.end())
+	{
+		// keep the order of the speeds of a loco
+		SendLocoSpeedNow(deferred->second.loco, deferred->second.pendingSpeed);
+		deferredSpeeds.erase(deferred);
+	}
+	auto last = lastSpeedSent.find(locoID);
+	if (last != lastSpeedSent.end())
+	{
+		const std::chrono::steady_clock::time_point due = last->second + std::chrono::milliseconds(locoSpeedIntervalMs);
+		if (std::chrono::steady_clock::now() < due)
+		{
+			// newer speeds are still merged into this one until it is sent
+			deferredSpeeds[locoID] = DeferredSpeed { loco, pendingSpeed, due };
+			return;
+		}
+	}
+	SendLocoSpeedNow(loco, pendingSpeed);
+}
+
+void ControlQueue::SendLocoSpeedNow(const DataModel::Loco* loco, const std::shared_ptr<PendingSpeed>& pendingSpeed)
+{
+	const LocoID locoID = loco->GetID();
+	ControlType controlType;
+	Speed speed;
+	{
+		std::lock_guard<std::mutex> guard(speedMutex);
+		pendingSpeed->sent = true;
+		auto pending = pendingSpeeds.find(locoID);
+		if (pending != pendingSpeeds.end() && pending->second == pendingSpeed)
+		{
+			pendingSpeeds.erase(pending);
+		}
+		controlType = pendingSpeed->controlType;
+		speed = pendingSpeed->speed;
+	}
+	lastSpeedSent[locoID] = std::chrono::steady_clock::now();
+	control->LocoSpeed(controlType, loco, speed);
+	CommandExecuted();
+}
+
+void ControlQueue::SendDeferredSpeeds(const bool onlyDue)
+{
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	auto deferred = deferredSpeeds.begin();
+	while (deferred != deferredSpeeds.end())
+	{
+		if (onlyDue && deferred->second.due > now)
+		{
+			++deferred;
+			continue;
+		}
+		SendLocoSpeedNow(deferred->second.loco, deferred->second.pendingSpeed);
+		deferred = deferredSpeeds.erase(deferred);
+	}
+}
+
+std::chrono::steady_clock::time_point ControlQueue::NextDeferredSpeedDue() const
+{
+	std::chrono::steady_clock::time_point next = std::chrono::steady_clock::time_point::max();
+	for (auto& deferred : deferredSpeeds)
+	{
+		if (deferred.second.due < next)
+		{
+			next = deferred.second.due;
+		}
+	}
+	return next;
+}
+
+void ControlQueue::CommandExecuted()
+{
+	{
+		std::lock_guard<std::mutex> guard(executedMutex);
+		++executed;
+	}
+	executedChanged.notify_all();
+}
+
+void ControlQueue::Flush()
+{
+	if (std::this_thread::get_id() == thread.get_id())
+	{
+		// called by a command of this queue
+		return;
+	}
+	const unsigned long long target = enqueued;
+	std::unique_lock<std::mutex> lock(executedMutex);
+	while (executed < target)
+	{
+		executedChanged.wait(lock);
+	}
+}
+
+ControlQueue::Statistics ControlQueue::GetStatistics() const
+{
+	Statistics statistics;
+	{
+		std::lock_guard<std::mutex> guard(speedMutex);
+		statistics.coalesced = coalesced;
+	}
+	std::lock_guard<std::mutex> guard(executedMutex);
+	statistics.executed = executed;
+	statistics.depth = enqueued - executed;
+	statistics.maxDepth = maxDepth;
+	return statistics;
+}
+
+void ControlQueue::Worker()
+{
+	Utils::Utils::SetThreadName("Control " + std::to_string(controlID));
+	QueueEntry entry;
+	while (true)
+	{
+		// the thread never sleeps for a deferred speed, it only waits for the next command until the speed is due
+		const bool dequeued = deferredSpeeds.size() == 0
+			? queue.Dequeue(entry)
+			: queue.DequeueUntil(entry, NextDeferredSpeedDue());
+		if (dequeued == false)
+		{
+			if (queue.IsTerminated())
+			{
+				SendDeferredSpeeds(false);
+				return;
+			}
+			SendDeferredSpeeds(true);
+			continue;
+		}
+		SendDeferredSpeeds(true);
+		if (entry.pendingSpeed)
+		{
+			SendLocoSpeed(entry.loco, entry.pendingSpeed);
+			entry.pendingSpeed.reset();
+			continue;
+		}
+		// a deferred speed must not be overtaken by a later command
+		SendDeferredSpeeds(false);
+		entry.command(control);
+		entry.command = nullptr;
+		CommandExecuted();
+	}
+}
@@ -0,0 +1,147 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "DataTypes.h"
+#include "Utils/ThreadSafeQueue.h"
+
+class ControlInterface;
+
+namespace DataModel
+{
+	class Loco;
+}
+
+// Outbound commands of one control (webserver or hardware handler).
+// The commands are executed in order by the own thread of the queue, so the
+// caller does not wait for the I/O of the control and a slow command station
+// does not delay the other controls.
+// Loco speeds are coalesced: a speed that is still queued is replaced by a newer
+// one of the same loco, so only the latest value is sent when the control is busy.
+// A speed that comes too early after the last one of its loco is put aside until
+// it is due, the thread goes on with the other commands meanwhile.
+class ControlQueue
+{
+	public:
+		typedef std::function<void(ControlInterface*)> Command;
+
+		static const size_t QueueSize = 1024;
+
+		struct Statistics
+		{
+			size_t depth;
+			size_t maxDepth;
+			unsigned long long executed;
+			unsigned long long coalesced;
+		};
+
+		ControlQueue() = delete;
+		ControlQueue(const ControlQueue&) = delete;
+		ControlQueue& operator=(const ControlQueue&) = delete;
+
+		ControlQueue(const ControlID controlID, ControlInterface* control, const unsigned int locoSpeedIntervalMs);
+
+		// the commands that are still queued are executed before
+		~ControlQueue();
+
+		// blocks if the queue is full
+		void Enqueue(Command&& command);
+
+		// the speed is merged into a queued speed of the loco if no other command has been queued since
+		void EnqueueLocoSpeed(const ControlType controlType, const DataModel::Loco* loco, const Speed speed);
+
+		// minimum time between two speeds of the same loco
+		void SetLocoSpeedInterval(const unsigned int intervalMs)
+		{
+			locoSpeedIntervalMs = intervalMs;
+		}
+
+		// waits until all commands queued so far have been executed
+		void Flush();
+
+		Statistics GetStatistics() const;
+
+	private:
+		// value of a queued speed command, shared with the command
+		struct PendingSpeed
+		{
+			unsigned long long sequence;
+			ControlType controlType;
+			Speed speed;
+			bool sent;
+		};
+
+		// either a command or a loco speed
+		struct QueueEntry
+		{
+			Command command;
+			const DataModel::Loco* loco;
+			std::shared_ptr<PendingSpeed> pendingSpeed;
+		};
+
+		// speed waiting for the minimum interval of its loco
+		struct DeferredSpeed
+		{
+			const DataModel::Loco* loco;
+			std::shared_ptr<PendingSpeed> pendingSpeed;
+			std::chrono::steady_clock::time_point due;
+		};
+
+		void Push(QueueEntry&& entry);
+		void SendLocoSpeed(const DataModel::Loco* loco, const std::shared_ptr<PendingSpeed>& pendingSpeed);
+		void SendLocoSpeedNow(const DataModel::Loco* loco, const std::shared_ptr<PendingSpeed>& pendingSpeed);
+		// sends the deferred speeds that are due, or all of them if onlyDue is false
+		void SendDeferredSpeeds(const bool onlyDue);
+		std::chrono::steady_clock::time_point NextDeferredSpeedDue() const;
+		void CommandExecuted();
+		void Worker();
+
+		const ControlID controlID;
+		ControlInterface* const control;
+		Utils::ThreadSafeQueue<QueueEntry> queue;
+		std::atomic<unsigned long long> enqueued;
+		std::atomic<size_t> maxDepth;
+
+		// sequence of the last command that must not be overtaken by a coalesced speed
+		unsigned long long lastBarrier;
+		std::map<LocoID,std::shared_ptr<PendingSpeed>> pendingSpeeds;
+		std::atomic<unsigned int> locoSpeedIntervalMs;
+		unsigned long long coalesced;
+		mutable std::mutex speedMutex;
+
+		// only used by the thread of the queue
+		std::map<LocoID,std::chrono::steady_clock::time_point> lastSpeedSent;
+		std::map<LocoID,DeferredSpeed> deferredSpeeds;
+
+		unsigned long long executed;
+		mutable std::mutex executedMutex;
+		std::condition_variable executedChanged;
+		std::thread thread;
+};
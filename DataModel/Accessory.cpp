@@ -42,10 +42,8 @@ namespace DataModel
 
 	bool Accessory::Deserialize(const std::string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
-		string objectType = Utils::Utils::GetStringMapEntry(arguments, "objectType");
-		if (objectType.compare("Accessory") != 0)
+		SerializedArguments arguments(serialized);
+		if (arguments.Equals("objectType", "Accessory") == false)
 		{
 			return false;
 		}
@@ -43,16 +43,16 @@ namespace DataModel
 		return ss.str();
 	}
 
-	bool AccessoryBase::Deserialize(const map<string,string>& arguments)
+	bool AccessoryBase::Deserialize(const SerializedArguments& arguments)
 	{
 		HardwareHandle::Deserialize(arguments);
-		accessoryType = static_cast<AccessoryType>(Utils::Utils::GetIntegerMapEntry(arguments, "type"));
-		accessoryState = static_cast<AccessoryState>(Utils::Utils::GetIntegerMapEntry(arguments, "state", AccessoryStateOff));
-		duration = static_cast<AccessoryPulseDuration>(Utils::Utils::GetIntegerMapEntry(arguments, "timeout", DefaultAccessoryPulseDuration)); // FIXME: remove in later versions, is only here for conversion 2020-10-27
-		duration = static_cast<AccessoryPulseDuration>(Utils::Utils::GetIntegerMapEntry(arguments, "duration", DefaultAccessoryPulseDuration));
-		inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted");
-		lastUsed = Utils::Utils::GetIntegerMapEntry(arguments, "lastused", 0);
-		counter = Utils::Utils::GetIntegerMapEntry(arguments, "counter", 0);
+		accessoryType = static_cast<AccessoryType>(arguments.GetInteger("type"));
+		accessoryState = static_cast<AccessoryState>(arguments.GetInteger("state", AccessoryStateOff));
+		duration = static_cast<AccessoryPulseDuration>(arguments.GetInteger("timeout", DefaultAccessoryPulseDuration)); // FIXME: remove in later versions, is only here for conversion 2020-10-27
+		duration = static_cast<AccessoryPulseDuration>(arguments.GetInteger("duration", DefaultAccessoryPulseDuration));
+		inverted = arguments.GetBool("inverted");
+		lastUsed = arguments.GetInteger("lastused", 0);
+		counter = arguments.GetInteger("counter", 0);
 		return true;
 	}
 
@@ -134,7 +134,7 @@ namespace DataModel
 
 		protected:
 			virtual std::string Serialize() const;
-			virtual bool Deserialize(const std::map<std::string,std::string>& arguments);
+			virtual bool Deserialize(const SerializedArguments& arguments);
 
 			AccessoryType accessoryType;
 			AccessoryState accessoryState;
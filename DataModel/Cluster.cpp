@@ -47,14 +47,13 @@ namespace DataModel
 
 	bool Cluster::Deserialize(const string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
+		SerializedArguments arguments(serialized);
 		Object::Deserialize(arguments);
-		if (!arguments.count("objectType") || arguments.at("objectType").compare("Cluster") != 0)
+		if (arguments.Equals("objectType", "Cluster") == false)
 		{
 			return false;
 		}
-		orientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "orientation", OrientationRight));
+		orientation = static_cast<Orientation>(arguments.GetBool("orientation", OrientationRight));
 		return true;
 	}
 
@@ -38,17 +38,16 @@ namespace DataModel
 		str += ";controlID=" + to_string(controlID);
 		str += ";pin=" + to_string(pin);
 		str += ";inverted=" + to_string(inverted);
-		str += ";state=" + to_string(stateCounter > 0);
+		str += ";state=" + to_string(state);
+		str += ";debouncetime=" + to_string(debounceTime);
 		str += ";" + relatedObject.Serialize();
 		return str;
 	}
 
 	bool Feedback::Deserialize(const string& serialized)
 	{
-		map<string, string> arguments;
-		ParseArguments(serialized, arguments);
-		string objectType = Utils::Utils::GetStringMapEntry(arguments, "objectType");
-		if (objectType.compare("Feedback") != 0)
+		SerializedArguments arguments(serialized);
+		if (arguments.Equals("objectType", "Feedback") == false)
 		{
 			return false;
 		}
@@ -56,40 +55,52 @@ namespace DataModel
 		SetRotation(Rotation0);
 		SetHeight(Height1);
 		SetWidth(Width1);
-		controlID = Utils::Utils::GetIntegerMapEntry(arguments, "controlID", ControlIdNone);
-		pin = Utils::Utils::GetIntegerMapEntry(arguments, "pin");
-		inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted", false);
-		stateCounter = Utils::Utils::GetBoolMapEntry(arguments, "state", FeedbackStateFree) ? MaxStateCounter : 0;
+		controlID = arguments.GetInteger("controlID", ControlIdNone);
+		pin = arguments.GetInteger("pin");
+		inverted = arguments.GetBool("inverted", false);
+		state = static_cast<FeedbackState>(arguments.GetBool("state", FeedbackStateFree));
+		debounceTime = static_cast<FeedbackDebounceTime>(arguments.GetInteger("debouncetime", DefaultFeedbackDebounceTime));
 		relatedObject.Deserialize(arguments);
 		return true;
 	}
 
 	void Feedback::SetState(const FeedbackState newState)
 	{
-		FeedbackState state = static_cast<FeedbackState>(newState != inverted);
+		if (SetStateUnpublished(newState) == false)
+		{
+			return;
+		}
+
+		manager->FeedbackPublishState(this);
+		UpdateTrackState(FeedbackStateOccupied);
+	}
+
+	bool Feedback::SetStateUnpublished(const FeedbackState newState)
+	{
+		FeedbackState reportedState = static_cast<FeedbackState>(newState != inverted);
 		{
 			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (state == FeedbackStateFree)
+			if (reportedState == FeedbackStateOccupied)
 			{
-				if (stateCounter < MaxStateCounter)
+				freePending = false;
+				if (state == FeedbackStateOccupied)
 				{
-					return;
+					return false;
 				}
-				stateCounter = MaxStateCounter - 1;
-				return;
+				state = FeedbackStateOccupied;
+				return true;
 			}
 
-			unsigned char oldStateCounter = stateCounter;
-			stateCounter = MaxStateCounter;
-
-			if (oldStateCounter > 0)
+			if (state == FeedbackStateFree || freePending || debounceStopped)
 			{
-				return;
+				return false;
 			}
+			freePending = true;
+			// scheduled under the lock, so a timer of an earlier free report can not
+			// take this one over and no timer is scheduled after StopDebounce
+			manager->FeedbackDebounce(this, ++debounceGeneration);
 		}
-
-		manager->FeedbackPublishState(this);
-		UpdateTrackState(FeedbackStateOccupied);
+		return false;
 	}
 
 	void Feedback::UpdateTrack()
@@ -124,23 +135,27 @@ namespace DataModel
 		track->SetFeedbackState(GetID(), state);
 	}
 
-	void Feedback::Debounce()
+	void Feedback::Debounce(const unsigned int generation)
 	{
 		{
 			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (stateCounter == MaxStateCounter || stateCounter == 0)
-			{
-				return;
-			}
-
-			--stateCounter;
-			if (stateCounter != 0)
+			if (freePending == false || generation != debounceGeneration)
 			{
+				// occupied again in the meantime or outdated timer
 				return;
 			}
+			freePending = false;
+			state = FeedbackStateFree;
 		}
 		manager->FeedbackPublishState(this);
 		UpdateTrackState(FeedbackStateFree);
 	}
+
+	void Feedback::StopDebounce()
+	{
+		std::lock_guard<std::mutex> Guard(updateMutex);
+		debounceStopped = true;
+		freePending = false;
+	}
 } // namespace DataModel
 
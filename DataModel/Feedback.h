@@ -34,6 +34,10 @@ namespace DataModel
 {
 	class TrackBase;
 
+	typedef unsigned short FeedbackDebounceTime;
+	static const FeedbackDebounceTime DefaultFeedbackDebounceTime = 2000;
+	static const FeedbackDebounceTime MaxFeedbackDebounceTime = 60000;
+
 	class Feedback : public LayoutItem
 	{
 		public:
@@ -43,6 +47,19 @@ namespace DataModel
 				FeedbackStateOccupied = true
 			};
 
+			enum FeedbackBitOrder : bool
+			{
+				FeedbackBitOrderLsbFirst = false,
+				FeedbackBitOrderMsbFirst = true
+			};
+
+			struct StateChange
+			{
+				FeedbackID feedbackID;
+				std::string name;
+				FeedbackState state;
+			};
+
 			inline Feedback(Manager* manager,
 				const FeedbackID feedbackID)
 			:	LayoutItem(feedbackID),
@@ -52,13 +69,20 @@ namespace DataModel
 			 	inverted(false),
 			 	relatedObject(),
 			 	track(nullptr),
-				stateCounter(0)
+				state(FeedbackStateFree),
+				freePending(false),
+				debounceGeneration(0),
+				debounceStopped(false),
+				debounceTime(DefaultFeedbackDebounceTime)
 			{
 			}
 
 			inline Feedback(Manager* manager, const std::string& serialized)
 			:	manager(manager),
-				track(nullptr)
+				track(nullptr),
+				freePending(false),
+				debounceGeneration(0),
+				debounceStopped(false)
 			{
 				Deserialize(serialized);
 			}
@@ -89,12 +113,36 @@ namespace DataModel
 
 			void SetState(const FeedbackState state);
 
+			// sets the state like SetState but leaves publishing to the caller.
+			// Returns true if the feedback became occupied. In this case the caller
+			// has to publish the state and call UpdateTrackState.
+			bool SetStateUnpublished(const FeedbackState state);
+
+			void UpdateTrackState(const FeedbackState state);
+
 			inline FeedbackState GetState() const
 			{
-				return static_cast<FeedbackState>(stateCounter > 0);
+				return state;
 			}
 
-			void Debounce();
+			// called by the FeedbackDebouncer: the feedback has been reported free
+			// for its whole debounce time, so the free state is taken over now.
+			// A timer of an earlier free report (other generation) is ignored.
+			void Debounce(const unsigned int generation);
+
+			// no debounce is scheduled any more, called before the feedback is deleted
+			void StopDebounce();
+
+			// time in ms a free report has to last before the feedback turns free
+			inline void SetDebounceTime(const FeedbackDebounceTime debounceTime)
+			{
+				this->debounceTime = debounceTime;
+			}
+
+			inline FeedbackDebounceTime GetDebounceTime() const
+			{
+				return debounceTime;
+			}
 
 			inline void SetControlID(const ControlID controlID)
 			{
@@ -151,7 +199,6 @@ namespace DataModel
 
 		private:
 			void UpdateTrack();
-			void UpdateTrackState(const FeedbackState state);
 
 			ControlID controlID;
 			FeedbackPin pin;
@@ -160,8 +207,11 @@ namespace DataModel
 			bool inverted;
 			ObjectIdentifier relatedObject;
 			TrackBase* track;
-			unsigned char stateCounter;
-			static const unsigned char MaxStateCounter = 10;
+			FeedbackState state;
+			bool freePending; // free has been reported, the state changes when the debounce time expires
+			unsigned int debounceGeneration; // counts the free reports, a debounce timer is only valid for its own one
+			bool debounceStopped;
+			FeedbackDebounceTime debounceTime; // time in ms a free state must last before it is taken over
 			mutable std::mutex updateMutex;
 	};
 
@@ -36,11 +36,11 @@ namespace DataModel
 		return ss.str();
 	}
 
-	bool HardwareHandle::Deserialize(const map<string,string>& arguments)
+	bool HardwareHandle::Deserialize(const SerializedArguments& arguments)
 	{
-		controlID = Utils::Utils::GetIntegerMapEntry(arguments, "controlID", ControlIdNone);
-		protocol = static_cast<Protocol>(Utils::Utils::GetIntegerMapEntry(arguments, "protocol", ProtocolNone));
-		address = Utils::Utils::GetIntegerMapEntry(arguments, "address");
+		controlID = arguments.GetInteger("controlID", ControlIdNone);
+		protocol = static_cast<Protocol>(arguments.GetInteger("protocol", ProtocolNone));
+		address = arguments.GetInteger("address");
 		return true;
 	}
 } // namespace DataModel
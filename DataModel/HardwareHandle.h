@@ -48,7 +48,7 @@ namespace DataModel
 
 		protected:
 			virtual std::string Serialize() const;
-			virtual bool Deserialize(const std::map<std::string,std::string>& arguments);
+			virtual bool Deserialize(const SerializedArguments& arguments);
 
 		private:
 			ControlID controlID;
@@ -113,25 +113,24 @@ namespace DataModel
 
 	bool LayoutItem::Deserialize(const std::string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
+		SerializedArguments arguments(serialized);
 		return Deserialize(arguments);
 	}
 
-	bool LayoutItem::Deserialize(const map<string,string>& arguments)
+	bool LayoutItem::Deserialize(const SerializedArguments& arguments)
 	{
 		Object::Deserialize(arguments);
-		visible = static_cast<Visible>(Utils::Utils::GetIntegerMapEntry(arguments, "visible"));
+		visible = static_cast<Visible>(arguments.GetInteger("visible"));
 		if (visible > VisibleYes)
 		{
 			visible = VisibleYes;
 		}
-		posX = Utils::Utils::GetIntegerMapEntry(arguments, "posX", 0);
-		posY = Utils::Utils::GetIntegerMapEntry(arguments, "posY", 0);
-		posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posZ", 0);
-		width = Utils::Utils::GetIntegerMapEntry(arguments, "width", Width1);
-		height = Utils::Utils::GetIntegerMapEntry(arguments, "height", Height1);
-		rotation = static_cast<LayoutRotation>(Utils::Utils::GetIntegerMapEntry(arguments, "rotation", Rotation0));
+		posX = arguments.GetInteger("posX", 0);
+		posY = arguments.GetInteger("posY", 0);
+		posZ = arguments.GetInteger("posZ", 0);
+		width = arguments.GetInteger("width", Width1);
+		height = arguments.GetInteger("height", Height1);
+		rotation = static_cast<LayoutRotation>(arguments.GetInteger("rotation", Rotation0));
 		if (rotation > Rotation270)
 		{
 			rotation = Rotation0;
@@ -34,10 +34,10 @@ namespace DataModel
 
 	}
 
-	bool LockableItem::Deserialize(const map<string, string> arguments)
+	bool LockableItem::Deserialize(const SerializedArguments& arguments)
 	{
-		locoID = Utils::Utils::GetIntegerMapEntry(arguments, "locoID", LocoNone);
-		lockState = static_cast<LockState>(Utils::Utils::GetIntegerMapEntry(arguments, "lockState", LockStateFree));
+		locoID = arguments.GetInteger("locoID", LocoNone);
+		lockState = static_cast<LockState>(arguments.GetInteger("lockState", LockStateFree));
 		return true;
 	}
 
@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <mutex>
 
 #include "DataTypes.h"
+#include "DataModel/Serializable.h"
 #include "Logger/Logger.h"
 
 namespace DataModel
@@ -48,7 +49,7 @@ namespace DataModel
 			virtual ~LockableItem() {};
 
 			std::string Serialize() const;
-			bool Deserialize(const std::map<std::string,std::string> arguments);
+			bool Deserialize(const SerializedArguments& arguments);
 
 
 			inline LocoID GetLoco() const
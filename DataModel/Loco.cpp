@@ -22,6 +22,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <map>
 #include <string>
 
+#include "AutoModeScheduler.h"
 #include "DataModel/Loco.h"
 #include "DataModel/Track.h"
 #include "Manager.h"
@@ -84,35 +85,34 @@ namespace DataModel
 
 	bool Loco::Deserialize(const std::string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
+		SerializedArguments arguments(serialized);
 		Object::Deserialize(arguments);
-		if (!arguments.count("objectType") || arguments.at("objectType").compare("Loco") != 0)
+		if (arguments.Equals("objectType", "Loco") == false)
 		{
 			return false;
 		}
 		HardwareHandle::Deserialize(arguments);
-		ObjectIdentifier trackIdentifier = Utils::Utils::GetStringMapEntry(arguments, "track");
+		ObjectIdentifier trackIdentifier = arguments.GetString("track");
 		if (trackIdentifier.GetObjectID() == ObjectNone)
 		{
-			trackIdentifier = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "trackID", TrackNone));
+			trackIdentifier = static_cast<ObjectID>(arguments.GetInteger("trackID", TrackNone));
 			if (trackIdentifier.GetObjectID() != ObjectNone)
 			{
 				trackIdentifier = ObjectTypeTrack;
 			}
 		}
 		trackFrom = manager->GetTrackBase(trackIdentifier);
-		functions.Deserialize(Utils::Utils::GetStringMapEntry(arguments, "functions", "0"));
-		orientation = (Utils::Utils::GetStringMapEntry(arguments, "direction", "right").compare("right") == 0 ? OrientationRight : OrientationLeft); // FIXME: remove later 2020-10-27
-		orientation = (static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "orientation", orientation)));
-		length = static_cast<Length>(Utils::Utils::GetIntegerMapEntry(arguments, "length", 0));
-		pushpull = Utils::Utils::GetBoolMapEntry(arguments, "commuter", false);  // FIXME: remove later 2020-10-27
-		pushpull = Utils::Utils::GetBoolMapEntry(arguments, "pushpull", pushpull);
-		maxSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "maxspeed", MaxSpeed);
-		travelSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "travelspeed", DefaultTravelSpeed);
-		reducedSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "reducedspeed", DefaultReducedSpeed);
-		creepingSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "creepspeed", DefaultCreepingSpeed);
-		creepingSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "creepingspeed", creepingSpeed);
+		functions.Deserialize(arguments.GetString("functions", "0"));
+		orientation = (arguments.Has("direction") == false || arguments.Equals("direction", "right") ? OrientationRight : OrientationLeft); // FIXME: remove later 2020-10-27
+		orientation = (static_cast<Orientation>(arguments.GetBool("orientation", orientation)));
+		length = static_cast<Length>(arguments.GetInteger("length", 0));
+		pushpull = arguments.GetBool("commuter", false);  // FIXME: remove later 2020-10-27
+		pushpull = arguments.GetBool("pushpull", pushpull);
+		maxSpeed = arguments.GetInteger("maxspeed", MaxSpeed);
+		travelSpeed = arguments.GetInteger("travelspeed", DefaultTravelSpeed);
+		reducedSpeed = arguments.GetInteger("reducedspeed", DefaultReducedSpeed);
+		creepingSpeed = arguments.GetInteger("creepspeed", DefaultCreepingSpeed);
+		creepingSpeed = arguments.GetInteger("creepingspeed", creepingSpeed);
 		return true;
 	}
 
@@ -188,7 +188,6 @@ namespace DataModel
 		}
 		if (state == LocoStateTerminated)
 		{
-			locoThread.join();
 			state = LocoStateManual;
 		}
 		if (state != LocoStateManual)
@@ -198,7 +197,8 @@ namespace DataModel
 		}
 
 		state = LocoStateSearchingFirst;
-		locoThread = std::thread(&DataModel::Loco::AutoMode, this);
+		logger->Info(Languages::TextIsNowInAutoMode, name);
+		manager->GetAutoModeScheduler()->Trigger(this);
 
 		return true;
 	}
@@ -210,6 +210,7 @@ namespace DataModel
 			return;
 		}
 		requestManualMode = true;
+		manager->GetAutoModeScheduler()->Trigger(this);
 	}
 
 	bool Loco::GoToManualMode()
@@ -222,7 +223,7 @@ namespace DataModel
 		{
 			return false;
 		}
-		locoThread.join();
+		manager->GetAutoModeScheduler()->Cancel(this);
 		state = LocoStateManual;
 		return true;
 	}
@@ -240,119 +241,142 @@ namespace DataModel
 					break;
 
 				default:
-					state = LocoStateOff;
+					logger->Info(Languages::TextIsNowInManualMode, name);
+					state = LocoStateTerminated;
+					requestManualMode = false;
 					break;
 			}
 		}
-		locoThread.join();
+		manager->GetAutoModeScheduler()->Cancel(this);
 		state = LocoStateManual;
 	}
 
-	void Loco::AutoMode()
+	void Loco::AutoModeStep()
 	{
-		Utils::Utils::SetMinThreadPriority();
-		const string& name = GetName();
-		Utils::Utils::SetThreadName(name);
-		logger->Info(Languages::TextIsNowInAutoMode, name);
+		AutoModeScheduler* scheduler = manager->GetAutoModeScheduler();
+		std::lock_guard<std::mutex> Guard(stateMutex);
+		if (state == LocoStateManual || state == LocoStateTerminated)
+		{
+			// automode has already been left, nothing to do anymore
+			return;
+		}
 
-		while (true)
+		FeedbackID feedbackId;
+		if (feedbackIdsReached.TryDequeue(feedbackId))
 		{
-			{ // sleep must be outside of locked block
-				std::lock_guard<std::mutex> Guard(stateMutex);
-				if (feedbackIdsReached.IsEmpty() == false)
+			if (feedbackId == feedbackIdFirst)
+			{
+				FeedbackIdFirstReached();
+			}
+			if (feedbackId == feedbackIdStop)
+			{
+				if (feedbackIdFirst != FeedbackNone)
 				{
-					FeedbackID feedbackId = feedbackIdsReached.Dequeue();
-					if (feedbackId == feedbackIdFirst)
-					{
-						FeedbackIdFirstReached();
-					}
-					if (feedbackId == feedbackIdStop)
-					{
-						if (feedbackIdFirst != FeedbackNone)
-						{
-							FeedbackIdFirstReached();
-						}
-						FeedbackIdStopReached();
-					}
+					FeedbackIdFirstReached();
 				}
+				FeedbackIdStopReached();
+			}
+			if (feedbackIdsReached.IsEmpty() == false)
+			{
+				scheduler->Trigger(this);
+			}
+		}
 
-				switch (state)
+		switch (state)
+		{
+			case LocoStateOff:
+				// automode is turned off
+				logger->Info(Languages::TextIsNowInManualMode, name);
+				state = LocoStateTerminated;
+				requestManualMode = false;
+				return;
+
+			case LocoStateSearchingFirst:
+				if (requestManualMode)
 				{
-					case LocoStateOff:
-						// automode is turned off, terminate thread
-						logger->Info(Languages::TextIsNowInManualMode, name);
-						state = LocoStateTerminated;
-						requestManualMode = false;
-						return;
-
-					case LocoStateSearchingFirst:
-						if (requestManualMode)
-						{
-							state = LocoStateOff;
-							break;
-						}
-						if (wait > 0)
-						{
-							--wait;
-							break;
-						}
-						SearchDestinationFirst();
-						break;
-
-					case LocoStateSearchingSecond:
-						if (requestManualMode)
-						{
-							logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
-							state = LocoStateStopping;
-							break;
-						}
-						if (manager->GetNrOfTracksToReserve() <= 1)
-						{
-							break;
-						}
-						if (wait > 0)
-						{
-							break;
-						}
-						SearchDestinationSecond();
-						break;
-
-					case LocoStateRunning:
-						// loco is already running, waiting until destination reached
-						if (requestManualMode)
-						{
-							logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
-							state = LocoStateStopping;
-						}
-						break;
-
-					case LocoStateStopping:
-						logger->Info(Languages::TextHasNotReachedDestination, name);
-
-						break;
-
-					case LocoStateTerminated:
-						logger->Error(Languages::TextIsInTerminatedState, name);
-						state = LocoStateError;
-						break;
-
-					case LocoStateManual:
-						logger->Error(Languages::TextIsInManualState, name);
-						state = LocoStateError;
-						#include "Fallthrough.h"
-
-					case LocoStateError:
-						logger->Error(Languages::TextIsInErrorState, name);
-						manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
-						if (requestManualMode)
-						{
-							state = LocoStateOff;
-						}
-						break;
+					state = LocoStateOff;
+					break;
 				}
-			}
-			// FIXME: make configurable
-			Utils::Utils::SleepForSeconds(1);
+				if (wait > 0)
+				{
+					waitUntil = AutoModeScheduler::Clock::now() + std::chrono::seconds(wait);
+					wait = 0;
+				}
+				if (AutoModeScheduler::Clock::now() < waitUntil)
+				{
+					scheduler->TriggerAt(this, waitUntil);
+					return;
+				}
+				SearchDestinationFirst();
+				break;
+
+			case LocoStateSearchingSecond:
+				if (requestManualMode)
+				{
+					logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
+					state = LocoStateStopping;
+					break;
+				}
+				if (manager->GetNrOfTracksToReserve() <= 1)
+				{
+					return;
+				}
+				if (wait > 0)
+				{
+					return;
+				}
+				SearchDestinationSecond();
+				break;
+
+			case LocoStateRunning:
+				// loco is already running, waiting until destination reached
+				if (requestManualMode)
+				{
+					logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
+					state = LocoStateStopping;
+				}
+				break;
+
+			case LocoStateStopping:
+				logger->Info(Languages::TextHasNotReachedDestination, name);
+				break;
+
+			case LocoStateManual:
+			case LocoStateTerminated:
+				// already handled above
+				return;
+
+			case LocoStateError:
+				logger->Error(Languages::TextIsInErrorState, name);
+				manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
+				if (requestManualMode)
+				{
+					state = LocoStateOff;
+				}
+				break;
+		}
+
+		switch (state)
+		{
+			case LocoStateOff:
+				scheduler->Trigger(this);
+				break;
+
+			case LocoStateSearchingFirst:
+				// no route found, try again later or when something has been released
+				scheduler->TriggerRetry(this);
+				break;
+
+			case LocoStateSearchingSecond:
+				if (wait == 0 && manager->GetNrOfTracksToReserve() > 1)
+				{
+					scheduler->TriggerRetry(this);
+				}
+				break;
+
+			default:
+				// all other states are changed by events only
+				break;
 		}
 	}
 
@@ -579,7 +603,8 @@ namespace DataModel
 		if (feedbackID == feedbackIdStop)
 		{
 			manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
-			feedbackIdsReached.Enqueue(feedbackIdStop);
+			feedbackIdsReached.Enqueue(FeedbackID(feedbackIdStop));
+			manager->GetAutoModeScheduler()->Trigger(this);
 			return;
 		}
 
@@ -603,7 +628,8 @@ namespace DataModel
 
 		if (feedbackID == feedbackIdFirst)
 		{
-			feedbackIdsReached.Enqueue(feedbackIdFirst);
+			feedbackIdsReached.Enqueue(FeedbackID(feedbackIdFirst));
+			manager->GetAutoModeScheduler()->Trigger(this);
 			return;
 		}
 	}
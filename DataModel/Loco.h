@@ -20,9 +20,9 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
 #include "DataTypes.h"
@@ -74,8 +74,9 @@ namespace DataModel
 				feedbackIdCreep(FeedbackNone),
 				feedbackIdStop(FeedbackNone),
 				feedbackIdOver(FeedbackNone),
-				feedbackIdsReached(),
-				wait(0)
+				feedbackIdsReached(FeedbackIdsReachedSize, Utils::QueueOverflowReject),
+				wait(0),
+				waitUntil()
 			{
 				logger = Logger::Logger::GetLogger(GetName());
 			}
@@ -104,8 +105,9 @@ namespace DataModel
 				feedbackIdCreep(FeedbackNone),
 				feedbackIdStop(FeedbackNone),
 				feedbackIdOver(FeedbackNone),
-				feedbackIdsReached(),
-				wait(0)
+				feedbackIdsReached(FeedbackIdsReachedSize, Utils::QueueOverflowReject),
+				wait(0),
+				waitUntil()
 			{
 				Deserialize(serialized);
 				logger = Logger::Logger::GetLogger(GetName());
@@ -137,6 +139,9 @@ namespace DataModel
 			void RequestManualMode();
 			bool GoToManualMode();
 
+			// called by the AutoModeScheduler only
+			void AutoModeStep();
+
 			bool SetTrack(const DataModel::ObjectIdentifier& identifier);
 			bool Release();
 			bool IsRunningFromTrack(const TrackID trackID) const;
@@ -270,8 +275,9 @@ namespace DataModel
 			}
 
 		private:
-			void SetMinThreadPriorityAndThreadName();
-			void AutoMode();
+			// only the first and the stop feedback of the current routes are queued
+			static const size_t FeedbackIdsReachedSize = 8;
+
 			void SearchDestinationFirst();
 			void SearchDestinationSecond();
 			DataModel::Route* SearchDestination(DataModel::TrackBase* oldToTrack, const bool allowLocoTurn);
@@ -294,7 +300,6 @@ namespace DataModel
 
 			Manager* manager;
 			mutable std::mutex stateMutex;
-			std::thread locoThread;
 
 			Length length;
 			bool pushpull;
@@ -322,6 +327,7 @@ namespace DataModel
 			volatile FeedbackID feedbackIdOver;
 			Utils::ThreadSafeQueue<FeedbackID> feedbackIdsReached;
 			Pause wait;
+			std::chrono::steady_clock::time_point waitUntil;
 
 			LocoFunctions functions;
 
@@ -40,15 +40,14 @@ namespace DataModel
 
 	bool Object::Deserialize(const std::string& serialized)
 	{
-		map<string, string> arguments;
-		ParseArguments(serialized, arguments);
+		SerializedArguments arguments(serialized);
 		return Deserialize(arguments);
 	}
 
-	bool Object::Deserialize(const map<string, string>& arguments)
+	bool Object::Deserialize(const SerializedArguments& arguments)
 	{
-		objectID = Utils::Utils::GetIntegerMapEntry(arguments, "objectID", ObjectNone);
-		name = Utils::Utils::GetStringMapEntry(arguments, "name");
+		objectID = arguments.GetInteger("objectID", ObjectNone);
+		name = arguments.GetString("name");
 		return true;
 	}
 
@@ -64,7 +64,7 @@ namespace DataModel
 			}
 
 		protected:
-			virtual bool Deserialize(const std::map<std::string,std::string>& arguments);
+			virtual bool Deserialize(const SerializedArguments& arguments);
 
 			ObjectID objectID;
 			std::string name;
@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <string>
 
 #include "DataTypes.h"
+#include "DataModel/Serializable.h"
 #include "Utils/Utils.h"
 
 namespace DataModel
@@ -73,15 +74,15 @@ namespace DataModel
 				return GetObjectTypeAsString() + "=" + std::to_string(objectID);
 			}
 
-			inline bool Deserialize(const std::map<std::string,std::string>& arguments)
+			inline bool Deserialize(const SerializedArguments& arguments)
 			{
-				objectID = static_cast<TrackID>(Utils::Utils::GetIntegerMapEntry(arguments, "track", ObjectNone));
+				objectID = static_cast<TrackID>(arguments.GetInteger("track", ObjectNone));
 				if (objectID != ObjectNone)
 				{
 					objectType = ObjectTypeTrack;
 					return true;
 				}
-				objectID = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "signal", ObjectNone));
+				objectID = static_cast<ObjectID>(arguments.GetInteger("signal", ObjectNone));
 				if (objectID != ObjectNone)
 				{
 					objectType = ObjectTypeSignal;
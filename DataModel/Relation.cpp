@@ -48,17 +48,16 @@ namespace DataModel
 
 	bool Relation::Deserialize(const std::string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
+		SerializedArguments arguments(serialized);
 		LockableItem::Deserialize(arguments);
-		object1 = static_cast<ObjectType>(Utils::Utils::GetIntegerMapEntry(arguments, "objectType1"));
-		type = static_cast<Type>(Utils::Utils::GetIntegerMapEntry(arguments, "type", ObjectType1() << 3)); // FIXME: remove default later and reorder 2020-10-27
-		object1 = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "objectID1"));
-		object2 = static_cast<ObjectType>(Utils::Utils::GetIntegerMapEntry(arguments, "objectType2"));
-		object2 = static_cast<ObjectID>(Utils::Utils::GetIntegerMapEntry(arguments, "objectID2"));
-		priority = Utils::Utils::GetIntegerMapEntry(arguments, "priority");
-		data = Utils::Utils::GetIntegerMapEntry(arguments, "accessoryState"); // FIXME: remove later 2020-10-27
-		data = Utils::Utils::GetIntegerMapEntry(arguments, "data", data);
+		object1 = static_cast<ObjectType>(arguments.GetInteger("objectType1"));
+		type = static_cast<Type>(arguments.GetInteger("type", ObjectType1() << 3)); // FIXME: remove default later and reorder 2020-10-27
+		object1 = static_cast<ObjectID>(arguments.GetInteger("objectID1"));
+		object2 = static_cast<ObjectType>(arguments.GetInteger("objectType2"));
+		object2 = static_cast<ObjectID>(arguments.GetInteger("objectID2"));
+		priority = arguments.GetInteger("priority");
+		data = arguments.GetInteger("accessoryState"); // FIXME: remove later 2020-10-27
+		data = arguments.GetInteger("data", data);
 		return true;
 	}
 
@@ -21,6 +21,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <map>
 #include <string>
 
+#include "AutoModeScheduler.h"
 #include "DataModel/Loco.h"
 #include "DataModel/Relation.h"
 #include "DataModel/Route.h"
@@ -39,6 +40,10 @@ namespace DataModel
 	 	executeAtUnlock(false)
 	{
 		Deserialize(serialized);
+	}
+
+	void Route::AddToFromTrack()
+	{
 		TrackBase* track = manager->GetTrackBase(fromTrack);
 		if (track == nullptr)
 		{
@@ -81,10 +86,8 @@ namespace DataModel
 
 	bool Route::Deserialize(const std::string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
-		string objectType = Utils::Utils::GetStringMapEntry(arguments, "objectType");
-		if (objectType.compare("Route") != 0 && objectType.compare("Street")) // FIXME: remove street later 2020-10-27
+		SerializedArguments arguments(serialized);
+		if (arguments.Equals("objectType", "Route") == false && arguments.Equals("objectType", "Street") == false) // FIXME: remove street later 2020-10-27
 		{
 			return false;
 		}
@@ -92,10 +95,10 @@ namespace DataModel
 		LayoutItem::Deserialize(arguments);
 		LockableItem::Deserialize(arguments);
 
-		delay = static_cast<Delay>(Utils::Utils::GetIntegerMapEntry(arguments, "delay", DefaultDelay));
-		lastUsed = Utils::Utils::GetIntegerMapEntry(arguments, "lastused", 0);
-		counter = Utils::Utils::GetIntegerMapEntry(arguments, "counter", 0);
-		automode = static_cast<Automode>(Utils::Utils::GetBoolMapEntry(arguments, "automode", AutomodeNo));
+		delay = static_cast<Delay>(arguments.GetInteger("delay", DefaultDelay));
+		lastUsed = arguments.GetInteger("lastused", 0);
+		counter = arguments.GetInteger("counter", 0);
+		automode = static_cast<Automode>(arguments.GetBool("automode", AutomodeNo));
 		if (automode == AutomodeNo)
 		{
 			fromTrack = TrackNone;
@@ -113,11 +116,11 @@ namespace DataModel
 			waitAfterRelease = 0;
 			return true;
 		}
-		fromTrack = Utils::Utils::GetStringMapEntry(arguments, "fromTrack");
-		fromOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "fromDirection", OrientationRight));
-		fromOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "fromorientation", fromOrientation));
-		toTrack = Utils::Utils::GetStringMapEntry(arguments, "toTrack");
-		std::string orientationString = Utils::Utils::GetStringMapEntry(arguments, "toDirection");
+		fromTrack = arguments.GetString("fromTrack");
+		fromOrientation = static_cast<Orientation>(arguments.GetBool("fromDirection", OrientationRight));
+		fromOrientation = static_cast<Orientation>(arguments.GetBool("fromorientation", fromOrientation));
+		toTrack = arguments.GetString("toTrack");
+		std::string orientationString = arguments.GetString("toDirection");
 		if (orientationString.compare("left") == 0)
 		{
 			toOrientation = OrientationLeft;
@@ -138,17 +141,17 @@ namespace DataModel
 		{
 			toOrientation = OrientationRight;
 		}
-		toOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "toorientation", toOrientation));
-		speed = static_cast<Speed>(Utils::Utils::GetIntegerMapEntry(arguments, "speed", SpeedTravel));
-		feedbackIdReduced = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackIdReduced", FeedbackNone);
-		feedbackIdCreep = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackIdCreep", FeedbackNone);
-		feedbackIdStop = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackIdStop", FeedbackNone);
-		feedbackIdOver = Utils::Utils::GetIntegerMapEntry(arguments, "feedbackIdOver", FeedbackNone);
-		pushpull = static_cast<PushpullType>(Utils::Utils::GetIntegerMapEntry(arguments, "commuter", PushpullTypeBoth)); // FIXME: remove later 2020-10-27
-		pushpull = static_cast<PushpullType>(Utils::Utils::GetIntegerMapEntry(arguments, "pushpull", pushpull));
-		minTrainLength = static_cast<Length>(Utils::Utils::GetIntegerMapEntry(arguments, "mintrainlength", 0));
-		maxTrainLength = static_cast<Length>(Utils::Utils::GetIntegerMapEntry(arguments, "maxtrainlength", 0));
-		waitAfterRelease = Utils::Utils::GetIntegerMapEntry(arguments, "waitafterrelease", 0);
+		toOrientation = static_cast<Orientation>(arguments.GetBool("toorientation", toOrientation));
+		speed = static_cast<Speed>(arguments.GetInteger("speed", SpeedTravel));
+		feedbackIdReduced = arguments.GetInteger("feedbackIdReduced", FeedbackNone);
+		feedbackIdCreep = arguments.GetInteger("feedbackIdCreep", FeedbackNone);
+		feedbackIdStop = arguments.GetInteger("feedbackIdStop", FeedbackNone);
+		feedbackIdOver = arguments.GetInteger("feedbackIdOver", FeedbackNone);
+		pushpull = static_cast<PushpullType>(arguments.GetInteger("commuter", PushpullTypeBoth)); // FIXME: remove later 2020-10-27
+		pushpull = static_cast<PushpullType>(arguments.GetInteger("pushpull", pushpull));
+		minTrainLength = static_cast<Length>(arguments.GetInteger("mintrainlength", 0));
+		maxTrainLength = static_cast<Length>(arguments.GetInteger("maxtrainlength", 0));
+		waitAfterRelease = arguments.GetInteger("waitafterrelease", 0);
 		return true;
 	}
 
@@ -364,8 +367,13 @@ namespace DataModel
 
 	bool Route::Release(Logger::Logger* logger, const LocoID locoID)
 	{
-		std::lock_guard<std::mutex> Guard(updateMutex);
-		return ReleaseInternal(logger, locoID);
+		bool ret;
+		{
+			std::lock_guard<std::mutex> Guard(updateMutex);
+			ret = ReleaseInternal(logger, locoID);
+		}
+		manager->GetAutoModeScheduler()->TriggerWaiting();
+		return ret;
 	}
 
 	bool Route::ReleaseInternal(Logger::Logger* logger, const LocoID locoID)
@@ -84,6 +84,7 @@ namespace DataModel
 			{
 			}
 
+			// the route is not yet known by its start track, see AddToFromTrack()
 			Route(Manager* manager, const std::string& serialized);
 
 			inline ~Route()
@@ -98,6 +99,9 @@ namespace DataModel
 			}
 
 			std::string Serialize() const override;
+
+			// makes the route known by its start track after it has been loaded
+			void AddToFromTrack();
 			bool Deserialize(const std::string& serialized) override;
 
 			inline std::string GetLayoutType() const override
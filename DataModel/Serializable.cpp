@@ -18,35 +18,134 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <deque>
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 
 #include "DataModel/Serializable.h"
-#include "Utils/Utils.h"
 
-using std::deque;
 using std::string;
-using std::map;
 
 namespace DataModel
 {
-	void Serializable::ParseArguments(const string& serialized, map<string, string>& arguments)
+	const size_t SerializedArguments::MaxInlineEntries;
+
+	SerializedArguments::SerializedArguments(const string& serialized)
+	:	nrOfEntries(0)
 	{
-		deque<string> parts;
-		Utils::Utils::SplitString(serialized, ";", parts);
-		for (auto part : parts)
+		const char* position = serialized.c_str();
+		const char* const end = position + serialized.length();
+		while (position < end)
 		{
-			if (part.length() == 0)
+			const char* partEnd = static_cast<const char*>(memchr(position, ';', end - position));
+			if (partEnd == nullptr)
 			{
-				continue;
+				partEnd = end;
 			}
-			deque<string> keyValue;
-			Utils::Utils::SplitString(part, "=", keyValue);
-			if (keyValue.size() < 2)
+			const char* equal = static_cast<const char*>(memchr(position, '=', partEnd - position));
+			if (equal != nullptr)
 			{
-				continue;
+				// like the former split at "=" everything behind a second "=" is ignored
+				const char* valueStart = equal + 1;
+				const char* valueEnd = static_cast<const char*>(memchr(valueStart, '=', partEnd - valueStart));
+				if (valueEnd == nullptr)
+				{
+					valueEnd = partEnd;
+				}
+				Entry entry;
+				entry.key.data = position;
+				entry.key.length = equal - position;
+				entry.value.data = valueStart;
+				entry.value.length = valueEnd - valueStart;
+				Add(entry);
 			}
-			string value = keyValue[1];
-			arguments[keyValue[0]] = value;
+			position = partEnd + 1;
+		}
+	}
+
+	void SerializedArguments::Add(const Entry& entry)
+	{
+		if (nrOfEntries < MaxInlineEntries)
+		{
+			entries[nrOfEntries] = entry;
+			++nrOfEntries;
+			return;
+		}
+		moreEntries.push_back(entry);
+	}
+
+	const SerializedArguments::Slice* SerializedArguments::Find(const char* key) const
+	{
+		const size_t keyLength = strlen(key);
+		for (auto it = moreEntries.rbegin(); it != moreEntries.rend(); ++it)
+		{
+			if (it->key.Equals(key, keyLength))
+			{
+				return &it->value;
+			}
+		}
+		for (size_t i = nrOfEntries; i > 0; --i)
+		{
+			if (entries[i - 1].key.Equals(key, keyLength))
+			{
+				return &entries[i - 1].value;
+			}
+		}
+		return nullptr;
+	}
+
+	bool SerializedArguments::Equals(const char* key, const char* value) const
+	{
+		const Slice* slice = Find(key);
+		return slice != nullptr && slice->Equals(value, strlen(value));
+	}
+
+	string SerializedArguments::GetString(const char* key, const string& defaultValue) const
+	{
+		const Slice* slice = Find(key);
+		if (slice == nullptr)
+		{
+			return defaultValue;
+		}
+		return string(slice->data, slice->length);
+	}
+
+	int SerializedArguments::GetInteger(const char* key, const int defaultValue) const
+	{
+		const Slice* slice = Find(key);
+		if (slice == nullptr || slice->length == 0)
+		{
+			return defaultValue;
+		}
+
+		// a value is always terminated by ';', '=' or the end of the serialized string,
+		// so strtol can not read beyond it
+		char* end;
+		errno = 0;
+		long longValue = std::strtol(slice->data, &end, 10);
+		if (errno == ERANGE || slice->data == end)
+		{
+			return defaultValue;
+		}
+		if (longValue > INT_MAX || longValue < INT_MIN)
+		{
+			return defaultValue;
+		}
+		return static_cast<int>(longValue);
+	}
+
+	bool SerializedArguments::GetBool(const char* key, const bool defaultValue) const
+	{
+		const Slice* slice = Find(key);
+		if (slice == nullptr)
+		{
+			return defaultValue;
 		}
+		return slice->Equals("true", 4)
+			|| slice->Equals("on", 2)
+			|| slice->Equals("1", 1)
+			|| slice->Equals(key, strlen(key));
 	}
-}
+} // namespace DataModel
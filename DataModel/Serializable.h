@@ -18,21 +18,70 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+
 #pragma once
 
-#include <map>
 #include <string>
+#include <vector>
 
 namespace DataModel {
 
+	// Parsed form of a serialized object "key1=value1;key2=value2;...".
+	// Keys and values are slices of the serialized string, so it has to outlive
+	// the arguments. Parsing and lookups do not allocate unless an object has
+	// more than MaxInlineEntries arguments. If a key appears twice the last one wins.
+	class SerializedArguments
+	{
+		public:
+			SerializedArguments() = delete;
+			SerializedArguments(const SerializedArguments&) = delete;
+			SerializedArguments& operator=(const SerializedArguments&) = delete;
+
+			explicit SerializedArguments(const std::string& serialized);
+
+			inline bool Has(const char* key) const
+			{
+				return Find(key) != nullptr;
+			}
+
+			bool Equals(const char* key, const char* value) const;
+			std::string GetString(const char* key, const std::string& defaultValue = "") const;
+			int GetInteger(const char* key, const int defaultValue = 0) const;
+			bool GetBool(const char* key, const bool defaultValue = false) const;
+
+		private:
+			static const size_t MaxInlineEntries = 48;
+
+			struct Slice
+			{
+				const char* data;
+				size_t length;
+
+				inline bool Equals(const char* other, const size_t otherLength) const
+				{
+					return length == otherLength && std::char_traits<char>::compare(data, other, length) == 0;
+				}
+			};
+
+			struct Entry
+			{
+				Slice key;
+				Slice value;
+			};
+
+			void Add(const Entry& entry);
+			const Slice* Find(const char* key) const;
+
+			Entry entries[MaxInlineEntries];
+			size_t nrOfEntries;
+			std::vector<Entry> moreEntries;
+	};
+
 	class Serializable {
 		public:
 			virtual ~Serializable() {};
 			virtual std::string Serialize() const = 0;
 			virtual bool Deserialize(const std::string& serialized) = 0;
-
-		protected:
-			static void ParseArguments(const std::string& serialized, std::map<std::string,std::string>& arguments);
 	};
 
 } // namespace DataModel
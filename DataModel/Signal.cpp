@@ -46,10 +46,8 @@ namespace DataModel
 
 	bool Signal::Deserialize(const std::string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
-		string objectType = Utils::Utils::GetStringMapEntry(arguments, "objectType");
-		if (objectType.compare("Signal") != 0)
+		SerializedArguments arguments(serialized);
+		if (arguments.Equals("objectType", "Signal") == false)
 		{
 			return false;
 		}
@@ -60,7 +58,7 @@ namespace DataModel
 		LockableItem::Deserialize(arguments);
 		SetWidth(Width1);
 		SetVisible(VisibleYes);
-		signalOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "signalorientation", OrientationRight));
+		signalOrientation = static_cast<Orientation>(arguments.GetBool("signalorientation", OrientationRight));
 		return true;
 	}
 
@@ -41,10 +41,8 @@ namespace DataModel
 
 	bool Switch::Deserialize(const std::string& serialized)
 	{
-		map<string,string> arguments;
-		ParseArguments(serialized, arguments);
-		string objectType = Utils::Utils::GetStringMapEntry(arguments, "objectType");
-		if (objectType.compare("Switch") != 0)
+		SerializedArguments arguments(serialized);
+		if (arguments.Equals("objectType", "Switch") == false)
 		{
 			return false;
 		}
@@ -50,10 +50,8 @@ namespace DataModel
 
 	bool Track::Deserialize(const std::string& serialized)
 	{
-		map<string, string> arguments;
-		ParseArguments(serialized, arguments);
-		string objectType = Utils::Utils::GetStringMapEntry(arguments, "objectType");
-		if (objectType.compare("Track") != 0)
+		SerializedArguments arguments(serialized);
+		if (arguments.Equals("objectType", "Track") == false)
 		{
 			return false;
 		}
@@ -62,8 +60,8 @@ namespace DataModel
 		TrackBase::Deserialize(arguments);
 		SetWidth(Width1);
 		SetVisible(VisibleYes);
-		trackType = static_cast<TrackType>(Utils::Utils::GetIntegerMapEntry(arguments, "type", TrackTypeStraight)); // FIXME: remove later 2020-10-27
-		trackType = static_cast<TrackType>(Utils::Utils::GetIntegerMapEntry(arguments, "tracktype", trackType));
+		trackType = static_cast<TrackType>(arguments.GetInteger("type", TrackTypeStraight)); // FIXME: remove later 2020-10-27
+		trackType = static_cast<TrackType>(arguments.GetInteger("tracktype", trackType));
 		switch (trackType)
 		{
 			case TrackTypeTurn:
@@ -23,6 +23,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <map>
 #include <string>
 
+#include "AutoModeScheduler.h"
 #include "DataModel/Feedback.h"
 #include "DataModel/TrackBase.h"
 #include "Manager.h"
@@ -71,9 +72,9 @@ namespace DataModel
 		return str;
 	}
 
-	bool TrackBase::Deserialize(const map<string, string> arguments)
+	bool TrackBase::Deserialize(const SerializedArguments& arguments)
 	{
-		string feedbackStrings = Utils::Utils::GetStringMapEntry(arguments, "feedbacks");
+		string feedbackStrings = arguments.GetString("feedbacks");
 		deque<string> feedbackStringVector;
 		Utils::Utils::SplitString(feedbackStrings, ",", feedbackStringVector);
 		for (auto feedbackString : feedbackStringVector)
@@ -85,18 +86,18 @@ namespace DataModel
 			}
 			feedbacks.push_back(feedbackID);
 		}
-		selectRouteApproach = static_cast<SelectRouteApproach>(Utils::Utils::GetIntegerMapEntry(arguments, "selectrouteapproach", SelectRouteSystemDefault));
-		trackState = static_cast<DataModel::Feedback::FeedbackState>(Utils::Utils::GetBoolMapEntry(arguments, "state", DataModel::Feedback::FeedbackStateFree)); // FIXME: remove later 2020-10-27
-		trackState = static_cast<DataModel::Feedback::FeedbackState>(Utils::Utils::GetBoolMapEntry(arguments, "trackstate", trackState));
-		trackStateDelayed = static_cast<DataModel::Feedback::FeedbackState>(Utils::Utils::GetBoolMapEntry(arguments, "statedelayed", trackState)); // FIXME: remove later 2020-10-27
-		trackStateDelayed = static_cast<DataModel::Feedback::FeedbackState>(Utils::Utils::GetBoolMapEntry(arguments, "trackstatedelayed", trackStateDelayed));
-		locoOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "locoDirection", OrientationRight)); // FIXME: remove later 2020-10-27
-		locoOrientation = static_cast<Orientation>(Utils::Utils::GetBoolMapEntry(arguments, "locoorientation", locoOrientation));
-		blocked = Utils::Utils::GetBoolMapEntry(arguments, "blocked", false);
-		locoIdDelayed = static_cast<LocoID>(Utils::Utils::GetIntegerMapEntry(arguments, "locodelayed", GetLockedLoco()));
-		allowLocoTurn = Utils::Utils::GetBoolMapEntry(arguments, "allowlocoturn", true);
-		releaseWhenFree = Utils::Utils::GetBoolMapEntry(arguments, "releasewhenfree", false);
-		showName = Utils::Utils::GetBoolMapEntry(arguments, "showname", true);
+		selectRouteApproach = static_cast<SelectRouteApproach>(arguments.GetInteger("selectrouteapproach", SelectRouteSystemDefault));
+		trackState = static_cast<DataModel::Feedback::FeedbackState>(arguments.GetBool("state", DataModel::Feedback::FeedbackStateFree)); // FIXME: remove later 2020-10-27
+		trackState = static_cast<DataModel::Feedback::FeedbackState>(arguments.GetBool("trackstate", trackState));
+		trackStateDelayed = static_cast<DataModel::Feedback::FeedbackState>(arguments.GetBool("statedelayed", trackState)); // FIXME: remove later 2020-10-27
+		trackStateDelayed = static_cast<DataModel::Feedback::FeedbackState>(arguments.GetBool("trackstatedelayed", trackStateDelayed));
+		locoOrientation = static_cast<Orientation>(arguments.GetBool("locoDirection", OrientationRight)); // FIXME: remove later 2020-10-27
+		locoOrientation = static_cast<Orientation>(arguments.GetBool("locoorientation", locoOrientation));
+		blocked = arguments.GetBool("blocked", false);
+		locoIdDelayed = static_cast<LocoID>(arguments.GetInteger("locodelayed", GetLockedLoco()));
+		allowLocoTurn = arguments.GetBool("allowlocoturn", true);
+		releaseWhenFree = arguments.GetBool("releasewhenfree", false);
+		showName = arguments.GetBool("showname", true);
 		return true;
 	}
 
@@ -173,6 +174,7 @@ namespace DataModel
 			this->trackStateDelayed = DataModel::Feedback::FeedbackStateFree;
 		}
 		PublishState();
+		manager->GetAutoModeScheduler()->TriggerWaiting();
 		return true;
 	}
 
@@ -184,6 +186,7 @@ namespace DataModel
 			ret = BaseReleaseForceUnlocked(logger, locoID);
 		}
 		PublishState();
+		manager->GetAutoModeScheduler()->TriggerWaiting();
 		return ret;
 	}
 
@@ -261,6 +264,7 @@ namespace DataModel
 			{
 				bool ret = BaseReleaseForceUnlocked(loco->GetLogger(), locoID);
 				PublishState();
+				manager->GetAutoModeScheduler()->TriggerWaiting();
 				return ret;
 			}
 		}
@@ -210,7 +210,7 @@ namespace DataModel
 
 		protected:
 			std::string Serialize() const;
-			bool Deserialize(const std::map<std::string, std::string> arguments);
+			bool Deserialize(const SerializedArguments& arguments);
 
 			virtual bool ReserveInternal(Logger::Logger* logger, const LocoID locoID) = 0;
 			virtual bool LockInternal(Logger::Logger* logger, const LocoID locoID) = 0;
@@ -0,0 +1,119 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "DataModel/Feedback.h"
+#include "FeedbackDebouncer.h"
+#include "Languages.h"
+#include "Utils/Utils.h"
+
+FeedbackDebouncer::FeedbackDebouncer()
+:	debouncing(nullptr),
+	run(true)
+{
+	thread = std::thread(&FeedbackDebouncer::Worker, this);
+}
+
+FeedbackDebouncer::~FeedbackDebouncer()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		run = false;
+	}
+	workAvailable.notify_all();
+	thread.join();
+}
+
+void FeedbackDebouncer::Schedule(DataModel::Feedback* feedback, const unsigned int debounceTimeMs, const unsigned int generation)
+{
+	if (feedback == nullptr)
+	{
+		return;
+	}
+	const Clock::time_point time = Clock::now() + std::chrono::milliseconds(debounceTimeMs);
+	bool first;
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		RemoveTimerUnlocked(feedback);
+		timers.insert(std::make_pair(time, feedback));
+		timerOfFeedback[feedback] = Timer { time, generation };
+		first = (timers.begin()->second == feedback);
+	}
+	if (first)
+	{
+		// the worker waits for a later expiry
+		workAvailable.notify_one();
+	}
+}
+
+void FeedbackDebouncer::Cancel(DataModel::Feedback* feedback)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	RemoveTimerUnlocked(feedback);
+	while (debouncing == feedback)
+	{
+		debounceFinished.wait(lock);
+	}
+}
+
+void FeedbackDebouncer::RemoveTimerUnlocked(DataModel::Feedback* feedback)
+{
+	auto it = timerOfFeedback.find(feedback);
+	if (it == timerOfFeedback.end())
+	{
+		return;
+	}
+	timers.erase(std::make_pair(it->second.time, feedback));
+	timerOfFeedback.erase(it);
+}
+
+void FeedbackDebouncer::Worker()
+{
+	Utils::Utils::SetThreadName(Languages::GetText(Languages::TextDebouncer));
+	std::unique_lock<std::mutex> lock(mutex);
+	while (run)
+	{
+		if (timers.empty())
+		{
+			workAvailable.wait(lock);
+			continue;
+		}
+
+		auto first = timers.begin();
+		if (Clock::now() < first->first)
+		{
+			workAvailable.wait_until(lock, first->first);
+			continue;
+		}
+
+		DataModel::Feedback* feedback = first->second;
+		timers.erase(first);
+		auto timer = timerOfFeedback.find(feedback);
+		const unsigned int generation = timer->second.generation;
+		timerOfFeedback.erase(timer);
+		debouncing = feedback;
+
+		lock.unlock();
+		feedback->Debounce(generation);
+		lock.lock();
+
+		debouncing = nullptr;
+		debounceFinished.notify_all();
+	}
+}
@@ -0,0 +1,77 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace DataModel
+{
+	class Feedback;
+}
+
+// Turns feedbacks free after their debounce time.
+// Only feedbacks that are going free are held here, each one with its own
+// expiry time. A feedback that becomes occupied again in the meantime
+// ignores its expiry.
+class FeedbackDebouncer
+{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		FeedbackDebouncer(const FeedbackDebouncer&) = delete;
+		FeedbackDebouncer& operator=(const FeedbackDebouncer&) = delete;
+
+		FeedbackDebouncer();
+		~FeedbackDebouncer();
+
+		// debounce the feedback after debounceTimeMs, an earlier expiry of the feedback is replaced.
+		// The generation is handed back to the feedback, so it can recognize an outdated expiry.
+		void Schedule(DataModel::Feedback* feedback, const unsigned int debounceTimeMs, const unsigned int generation);
+
+		// remove the expiry of the feedback and wait until a running debounce has finished
+		void Cancel(DataModel::Feedback* feedback);
+
+	private:
+		void Worker();
+		void RemoveTimerUnlocked(DataModel::Feedback* feedback);
+
+		std::mutex mutex;
+		std::condition_variable workAvailable;
+		std::condition_variable debounceFinished;
+
+		struct Timer
+		{
+			Clock::time_point time;
+			unsigned int generation;
+		};
+
+		std::set<std::pair<Clock::time_point,DataModel::Feedback*>> timers;
+		std::map<DataModel::Feedback*,Timer> timerOfFeedback;
+		DataModel::Feedback* debouncing;
+
+		volatile bool run;
+		std::thread thread;
+};
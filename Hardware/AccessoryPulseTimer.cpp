@@ -0,0 +1,260 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Hardware/AccessoryPulseTimer.h"
+#include "Hardware/HardwareInterface.h"
+#include "Utils/Utils.h"
+
+using std::deque;
+using std::list;
+
+namespace Hardware
+{
+	const unsigned int AccessoryPulseTimer::TickMs;
+	const unsigned int AccessoryPulseTimer::NrOfSlots;
+
+	AccessoryPulseTimer::AccessoryPulseTimer()
+	:	currentSlot(0),
+		nrOfEntries(0),
+		firing(nullptr),
+		run(true)
+	{
+		thread = std::thread(&AccessoryPulseTimer::Worker, this);
+	}
+
+	AccessoryPulseTimer::~AccessoryPulseTimer()
+	{
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			run = false;
+		}
+		workAvailable.notify_all();
+		thread.join();
+	}
+
+	void AccessoryPulseTimer::Pulse(HardwareInterface* hardware,
+		const Protocol protocol,
+		const Address address,
+		const DataModel::AccessoryState state,
+		const DataModel::AccessoryPulseDuration duration,
+		const bool mayOverlap)
+	{
+		PulseEntry entry;
+		entry.hardware = hardware;
+		entry.protocol = protocol;
+		entry.address = address;
+		entry.state = state;
+		entry.duration = duration;
+		entry.rounds = 0;
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			HardwareState& hardwareState = hardwareStates[hardware];
+			hardwareState.mayOverlap = mayOverlap;
+			if (hardwareState.waiting.empty() == false || CanStartUnlocked(hardwareState, address) == false)
+			{
+				hardwareState.waiting.push_back(entry);
+				return;
+			}
+			++hardwareState.activeAddresses[address];
+		}
+
+		hardware->AccessoryOnOrOff(protocol, address, state, true);
+
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			ScheduleOffUnlocked(entry);
+		}
+		workAvailable.notify_one();
+	}
+
+	void AccessoryPulseTimer::Cancel(HardwareInterface* hardware)
+	{
+		deque<PulseEntry> active;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (firing == hardware)
+			{
+				firingFinished.wait(lock);
+			}
+			for (auto& slot : slots)
+			{
+				for (auto it = slot.begin(); it != slot.end(); )
+				{
+					if (it->hardware != hardware)
+					{
+						++it;
+						continue;
+					}
+					active.push_back(*it);
+					it = slot.erase(it);
+					--nrOfEntries;
+				}
+			}
+			hardwareStates.erase(hardware);
+		}
+
+		// never leave a solenoid powered
+		for (auto& entry : active)
+		{
+			hardware->AccessoryOnOrOff(entry.protocol, entry.address, entry.state, false);
+		}
+	}
+
+	bool AccessoryPulseTimer::CanStartUnlocked(const HardwareState& hardwareState, const Address address) const
+	{
+		if (hardwareState.activeAddresses.count(address) == 1)
+		{
+			return false;
+		}
+		return hardwareState.mayOverlap || hardwareState.activeAddresses.empty();
+	}
+
+	void AccessoryPulseTimer::ScheduleOffUnlocked(PulseEntry& entry)
+	{
+		if (nrOfEntries == 0)
+		{
+			nextTick = std::chrono::steady_clock::now() + std::chrono::milliseconds(TickMs);
+		}
+		unsigned int ticks = (entry.duration + TickMs - 1) / TickMs;
+		if (ticks == 0)
+		{
+			ticks = 1;
+		}
+		entry.rounds = (ticks - 1) / NrOfSlots;
+		slots[(currentSlot + ticks - 1) % NrOfSlots].push_back(entry);
+		++nrOfEntries;
+	}
+
+	void AccessoryPulseTimer::StartWaitingUnlocked(HardwareInterface* hardware, deque<PulseEntry>& started)
+	{
+		auto it = hardwareStates.find(hardware);
+		if (it == hardwareStates.end())
+		{
+			return;
+		}
+		HardwareState& hardwareState = it->second;
+		while (hardwareState.waiting.empty() == false)
+		{
+			PulseEntry& entry = hardwareState.waiting.front();
+			if (CanStartUnlocked(hardwareState, entry.address) == false)
+			{
+				return;
+			}
+			++hardwareState.activeAddresses[entry.address];
+			started.push_back(entry);
+			hardwareState.waiting.pop_front();
+		}
+	}
+
+	void AccessoryPulseTimer::FinishUnlocked(const PulseEntry& entry)
+	{
+		auto it = hardwareStates.find(entry.hardware);
+		if (it == hardwareStates.end())
+		{
+			return;
+		}
+		std::map<Address,unsigned int>& activeAddresses = it->second.activeAddresses;
+		auto active = activeAddresses.find(entry.address);
+		if (active == activeAddresses.end())
+		{
+			return;
+		}
+		if (--active->second == 0)
+		{
+			activeAddresses.erase(active);
+		}
+	}
+
+	void AccessoryPulseTimer::SwitchOn(deque<PulseEntry>& entries)
+	{
+		for (auto& entry : entries)
+		{
+			entry.hardware->AccessoryOnOrOff(entry.protocol, entry.address, entry.state, true);
+		}
+	}
+
+	void AccessoryPulseTimer::Worker()
+	{
+		Utils::Utils::SetThreadName("AccessoryPulse");
+		std::unique_lock<std::mutex> lock(mutex);
+		while (run)
+		{
+			if (nrOfEntries == 0)
+			{
+				workAvailable.wait(lock);
+				continue;
+			}
+
+			if (std::chrono::steady_clock::now() < nextTick)
+			{
+				workAvailable.wait_until(lock, nextTick);
+				continue;
+			}
+
+			list<PulseEntry> due;
+			list<PulseEntry>& slot = slots[currentSlot];
+			for (auto it = slot.begin(); it != slot.end(); )
+			{
+				if (it->rounds > 0)
+				{
+					--(it->rounds);
+					++it;
+					continue;
+				}
+				auto next = std::next(it);
+				due.splice(due.end(), slot, it);
+				--nrOfEntries;
+				it = next;
+			}
+			currentSlot = (currentSlot + 1) % NrOfSlots;
+			nextTick += std::chrono::milliseconds(TickMs);
+
+			for (auto& entry : due)
+			{
+				HardwareInterface* hardware = entry.hardware;
+				if (hardwareStates.count(hardware) == 0)
+				{
+					// hardware has been cancelled in the meantime
+					continue;
+				}
+				firing = hardware;
+				lock.unlock();
+				hardware->AccessoryOnOrOff(entry.protocol, entry.address, entry.state, false);
+				lock.lock();
+
+				FinishUnlocked(entry);
+				deque<PulseEntry> started;
+				StartWaitingUnlocked(hardware, started);
+				if (started.empty() == false)
+				{
+					lock.unlock();
+					SwitchOn(started);
+					lock.lock();
+					for (auto& startedEntry : started)
+					{
+						ScheduleOffUnlocked(startedEntry);
+					}
+				}
+				firing = nullptr;
+				firingFinished.notify_all();
+			}
+		}
+	}
+} // namespace Hardware
@@ -0,0 +1,105 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "DataModel/AccessoryBase.h"
+#include "DataTypes.h"
+
+namespace Hardware
+{
+	class HardwareInterface;
+
+	// Timer wheel that turns off accessory pulses after their duration.
+	// The caller is never blocked for the duration of the pulse.
+	// Pulses to the same address are always serialized. Pulses to different
+	// addresses overlap only if the hardware allows it, otherwise they are queued.
+	class AccessoryPulseTimer
+	{
+		public:
+			AccessoryPulseTimer(const AccessoryPulseTimer&) = delete;
+			AccessoryPulseTimer& operator=(const AccessoryPulseTimer&) = delete;
+
+			AccessoryPulseTimer();
+			~AccessoryPulseTimer();
+
+			void Pulse(HardwareInterface* hardware,
+				const Protocol protocol,
+				const Address address,
+				const DataModel::AccessoryState state,
+				const DataModel::AccessoryPulseDuration duration,
+				const bool mayOverlap);
+
+			// turns off all active pulses of hardware immediately and drops the queued ones
+			void Cancel(HardwareInterface* hardware);
+
+		private:
+			static const unsigned int TickMs = 10;
+			static const unsigned int NrOfSlots = 256;
+
+			struct PulseEntry
+			{
+				HardwareInterface* hardware;
+				Protocol protocol;
+				Address address;
+				DataModel::AccessoryState state;
+				DataModel::AccessoryPulseDuration duration;
+				unsigned int rounds;
+			};
+
+			struct HardwareState
+			{
+				HardwareState()
+				:	mayOverlap(false)
+				{}
+
+				bool mayOverlap;
+				std::map<Address,unsigned int> activeAddresses;
+				std::deque<PulseEntry> waiting;
+			};
+
+			bool CanStartUnlocked(const HardwareState& hardwareState, const Address address) const;
+			void ScheduleOffUnlocked(PulseEntry& entry);
+			void StartWaitingUnlocked(HardwareInterface* hardware, std::deque<PulseEntry>& started);
+			void FinishUnlocked(const PulseEntry& entry);
+			void SwitchOn(std::deque<PulseEntry>& entries);
+			void Worker();
+
+			std::mutex mutex;
+			std::condition_variable workAvailable;
+			std::condition_variable firingFinished;
+			std::list<PulseEntry> slots[NrOfSlots];
+			unsigned int currentSlot;
+			unsigned int nrOfEntries;
+			std::chrono::steady_clock::time_point nextTick;
+			std::map<HardwareInterface*,HardwareState> hardwareStates;
+			HardwareInterface* firing;
+			volatile bool run;
+			std::thread thread;
+	};
+} // namespace Hardware
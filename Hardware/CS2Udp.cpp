@@ -84,27 +84,31 @@ namespace Hardware
 			logger->Error(Languages::TextUnableToBindUdpSocket);
 			return;
 		}
-		unsigned char buffer[CANCommandBufferLength];
+		// one byte more than a frame, so longer datagrams are detected
+		Network::UdpDatagrams frames(ReceiveBatchSize, CANCommandBufferLength + 1);
 		while(run)
 		{
-			ssize_t datalen = receiverConnection.Receive(buffer, sizeof(buffer));
+			int nrOfFrames = receiverConnection.ReceiveBatch(frames);
 			if (!run)
 			{
 				break;
 			}
 
-			if (datalen < 0)
+			if (nrOfFrames < 0)
 			{
 				logger->Error(Languages::TextUnableToReceiveData);
 				break;
 			}
 
-			if (datalen != 13)
+			for (int frame = 0; frame < nrOfFrames; ++frame)
 			{
-				logger->Error(Languages::TextInvalidDataReceived);
-				continue;
+				if (frames.Length(frame) != CANCommandBufferLength)
+				{
+					logger->Error(Languages::TextInvalidDataReceived);
+					continue;
+				}
+				Parse(frames.Data(frame));
 			}
-			Parse(buffer);
 		}
 		receiverConnection.Terminate();
 		logger->Info(Languages::TextTerminatingReceiverThread);
@@ -49,6 +49,7 @@ namespace Hardware
 
 			static const unsigned short CS2SenderPort = 15731;
 			static const unsigned short CS2ReceiverPort = 15730;
+			static const unsigned int ReceiveBatchSize = 64; // frames received with one system call
 	};
 
 	extern "C" CS2Udp* create_CS2Udp(HardwareParams* const params);
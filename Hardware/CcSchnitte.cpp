@@ -44,7 +44,7 @@ namespace Hardware
 	:	ProtocolMaerklinCAN(params,
 			Logger::Logger::GetLogger("CC-Schnitte " + params->GetName() + " " + params->GetArg1()),
 			"CC-Schnitte / " + params->GetName() + " at serial port " + params->GetArg1()),
-	 	serialLine(logger, params->GetArg1(), B500000, 8, 'N', 1, true)
+	 	serialLine(logger, ControlNone, params->GetArg1(), B500000, 8, 'N', 1, true) // captured as CAN frames
 	{
 		logger->Info(Languages::TextStarting, name);
 
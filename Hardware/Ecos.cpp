@@ -54,6 +54,7 @@ namespace Hardware
 		logger(Logger::Logger::GetLogger("ECoS " + params->GetName() + " " + params->GetArg1())),
 	 	run(false),
 	 	tcp(Network::TcpClient::GetTcpClientConnection(logger, params->GetArg1(), EcosPort)),
+		lineReader(tcp),
 	 	readBufferLength(0),
 		readBufferPosition(0)
 	{
@@ -164,35 +165,20 @@ namespace Hardware
 	void Ecos::ReadLine()
 	{
 		readBufferPosition = 0;
-		readBufferLength = -1;
-		while(true)
+		ssize_t length;
+		do
 		{
-			int dataLength = tcp.Receive(readBuffer + readBufferPosition, 1);
-			if (dataLength != 1)
-			{
-				readBufferLength = 0;
-				break;
-			}
-			if (readBuffer[readBufferPosition] == '\r')
-			{
-				continue;
-			}
-			if (readBuffer[readBufferPosition] == '\n')
-			{
-				readBufferLength = readBufferPosition;
-				break;
-			}
-			++readBufferPosition;
-			if (readBufferPosition >= MaxMessageSize)
-			{
-				break;
-			}
-		}
-		readBufferPosition = 0;
-		if (readBufferLength == 0)
+			// keep one byte for the line end the parser expects
+			length = lineReader.ReadLine(readBuffer, MaxMessageSize - 1);
+		} while (length == 0);
+
+		if (length < 0)
 		{
+			readBufferLength = 0;
 			return;
 		}
+		readBuffer[length] = '\n';
+		readBufferLength = length;
 		logger->Hex(reinterpret_cast<unsigned char*>(readBuffer), readBufferLength);
 	}
 
@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "HardwareParams.h"
 #include "Logger/Logger.h"
 #include "Network/TcpClient.h"
+#include "Network/TcpLineReader.h"
 
 namespace Hardware
 {
@@ -81,6 +82,11 @@ namespace Hardware
 
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
 
+			inline bool AccessoryPulsesMayOverlap() const override
+			{
+				return true;
+			}
+
 			static const char* const CommandActivateBoosterUpdates;
 			static const char* const CommandQueryLocos;
 			static const char* const CommandQueryAccessories;
@@ -209,6 +215,7 @@ namespace Hardware
 			std::thread receiverThread;
 
 			Network::TcpConnection tcp;
+			Network::TcpLineReader lineReader;
 
 			char readBuffer[MaxMessageSize];
 			ssize_t readBufferLength;
@@ -58,6 +58,11 @@ namespace Hardware
 		"CS2Tcp"
 	};
 
+	const std::string& HardwareHandler::GetHardwareSymbol(const HardwareType hardwareType)
+	{
+		return hardwareSymbols[hardwareType < HardwareTypeNumbers ? hardwareType : HardwareTypeNone];
+	}
+
 	void HardwareHandler::Init(const HardwareParams* params)
 	{
 		this->params = params;
@@ -187,6 +192,11 @@ namespace Hardware
 		createHardware = nullptr;
 		if (instanceTemp != nullptr)
 		{
+			Hardware::AccessoryPulseTimer* accessoryPulseTimer = params->GetManager()->GetAccessoryPulseTimer();
+			if (accessoryPulseTimer != nullptr)
+			{
+				accessoryPulseTimer->Cancel(instanceTemp);
+			}
 			destroyHardware(instanceTemp);
 		}
 		destroyHardware = nullptr;
@@ -233,6 +243,15 @@ namespace Hardware
 		return instance->GetCapabilities();
 	}
 
+	void HardwareHandler::GetStatistics(std::map<Languages::TextSelector,uint64_t>& statistics) const
+	{
+		if (instance == nullptr)
+		{
+			return;
+		}
+		instance->GetStatistics(statistics);
+	}
+
 	void HardwareHandler::LocoProtocols(std::vector<Protocol>& protocols) const
 	{
 		if (instance == nullptr)
@@ -312,16 +331,17 @@ namespace Hardware
 		instance->LocoFunction(loco->GetProtocol(), loco->GetAddress(), function, on);
 	}
 
-	void HardwareHandler::LocoSpeedOrientationFunctions(const DataModel::Loco* loco,
+	void HardwareHandler::LocoSpeedOrientationFunctions(const Protocol protocol,
+		const Address address,
 		const Speed speed,
 		const Orientation orientation,
 		std::vector<DataModel::LocoFunctionEntry>& functions)
 	{
-		if (instance == nullptr || loco->GetControlID() != GetControlID())
+		if (instance == nullptr)
 		{
 			return;
 		}
-		instance->LocoSpeedOrientationFunctions(loco->GetProtocol(), loco->GetAddress(), speed, orientation, functions);
+		instance->LocoSpeedOrientationFunctions(protocol, address, speed, orientation, functions);
 	}
 
 	void HardwareHandler::AccessoryState(const ControlType controlType, const DataModel::Accessory* accessory)
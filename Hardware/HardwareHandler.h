@@ -76,6 +76,7 @@ namespace Hardware
 
 			void Booster(const ControlType controlType, BoosterState status) override;
 			Hardware::Capabilities GetCapabilities() const override;
+			void GetStatistics(std::map<Languages::TextSelector,uint64_t>& statistics) const override;
 			void LocoOrientation(const ControlType controlType, const DataModel::Loco* loco, const Orientation orientation) override;
 
 			void LocoFunction(const ControlType controlType,
@@ -87,7 +88,8 @@ namespace Hardware
 			bool LocoProtocolSupported(Protocol protocol) const override;
 			void LocoSpeed(const ControlType controlType, const DataModel::Loco* loco, const Speed speed) override;
 
-			void LocoSpeedOrientationFunctions(const DataModel::Loco* loco,
+			void LocoSpeedOrientationFunctions(const Protocol protocol,
+				const Address address,
 				const Speed speed,
 				const Orientation orientation,
 				std::vector<DataModel::LocoFunctionEntry>& functions) override;
@@ -97,6 +99,8 @@ namespace Hardware
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
 
+			static const std::string& GetHardwareSymbol(const HardwareType hardwareType);
+
 			static void ArgumentTypesOfHardwareTypeAndHint(const HardwareType hardwareType, std::map<unsigned char,ArgumentType>& arguments, std::string& hint);
 
 		private:
@@ -26,6 +26,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include "DataModel/AccessoryBase.h"
 #include "DataTypes.h"
+#include "Hardware/AccessoryPulseTimer.h"
 #include "Hardware/Capabilities.h"
 #include "Manager.h"
 #include "Utils/Utils.h"
@@ -35,6 +36,8 @@ namespace Hardware
 
 	class HardwareInterface
 	{
+		friend class AccessoryPulseTimer;
+
 		public:
 			// non virtual default constructor is needed to prevent polymorphism
 			HardwareInterface(Manager* manager, const ControlID controlID, const std::string& name)
@@ -102,8 +105,8 @@ namespace Hardware
 			// accessory command
 			virtual void Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
 			{
-				AccessoryOnOrOff(protocol, address, state, true);
-				std::async(std::launch::async, AccessoryOnOrOffStatic, this, protocol, address, state, duration);
+				// turning off is done by the pulse timer, so we do not block the caller for the duration of the pulse
+				manager->GetAccessoryPulseTimer()->Pulse(this, protocol, address, state, duration, AccessoryPulsesMayOverlap());
 			};
 
 			// read CV value
@@ -112,6 +115,9 @@ namespace Hardware
 			// write CV value
 			virtual void ProgramWrite(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv, __attribute__((unused)) const CvValue value) {}
 
+			// get counters of the hardware, e.g. sent packets
+			virtual void GetStatistics(__attribute__((unused)) std::map<Languages::TextSelector,uint64_t>& statistics) const {}
+
 		protected:
 			Manager* manager;
 			const ControlID controlID;
@@ -119,12 +125,8 @@ namespace Hardware
 
 			virtual void AccessoryOnOrOff(__attribute__((unused)) const Protocol protocol, __attribute__((unused)) const Address address, __attribute__((unused)) const DataModel::AccessoryState state, __attribute__((unused)) const bool on) {}
 
-		private:
-			static void AccessoryOnOrOffStatic(HardwareInterface* hardware, const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
-			{
-				Utils::Utils::SleepForMilliseconds(duration);
-				hardware->AccessoryOnOrOff(protocol, address, state, false);
-			}
+			// can pulses to different accessory addresses be active at the same time
+			virtual bool AccessoryPulsesMayOverlap() const { return false; }
 	};
 
 } // namespace
@@ -46,7 +46,7 @@ namespace Hardware
 	Hsi88::Hsi88(const HardwareParams* params)
 	:	HardwareInterface(params->GetManager(), params->GetControlID(), "HSI-88 / " + params->GetName() + " at serial port " + params->GetArg1()),
 	 	logger(Logger::Logger::GetLogger("HSI-88 " + params->GetName() + " " + params->GetArg1())),
-	 	serialLine(logger, params->GetArg1(), B9600, 8, 'N', 1),
+	 	serialLine(logger, params->GetControlID(), params->GetArg1(), B9600, 8, 'N', 1),
 		run(false)
 	{
 		logger->Info(Languages::TextStarting, name);
@@ -161,41 +161,52 @@ namespace Hardware
 		{
 			return;
 		}
+		unsigned char oldMemory[MaxS88Modules];
+		memcpy(oldMemory, s88Memory, sizeof(oldMemory));
+		unsigned char firstModule = MaxS88Modules;
+		unsigned char lastModule = 0;
 		for (unsigned char module = 0; module < modules; ++module)
 		{
 			const unsigned char modulePosition = module * 3 + 2;
 			const unsigned char* moduleData = reinterpret_cast<const unsigned char*>(data.c_str()) + modulePosition;
-			if (*moduleData > (MaxS88Modules >> 1))
+			if (*moduleData == 0 || *moduleData > (MaxS88Modules >> 1))
 			{
 				continue;
 			}
 			const unsigned char memoryPosition = (data[modulePosition] - 1) * 2;
-			CheckFeedbackByte(moduleData[2], memoryPosition);
-			CheckFeedbackByte(moduleData[1], memoryPosition + 1);
+			StoreFeedbackByte(moduleData[2], memoryPosition, oldMemory);
+			StoreFeedbackByte(moduleData[1], memoryPosition + 1, oldMemory);
+			if (memoryPosition < firstModule)
+			{
+				firstModule = memoryPosition;
+			}
+			if (memoryPosition + 1 > lastModule)
+			{
+				lastModule = memoryPosition + 1;
+			}
 		}
-	}
 
-	void Hsi88::CheckFeedbackByte(const unsigned char dataByte, const unsigned char module)
-	{
-		unsigned char diff = (s88Memory[module] ^ dataByte) | s88Init[module];
-		if (!diff)
+		if (firstModule > lastModule)
 		{
 			return;
 		}
-		unsigned char pin = 0;
-		while (diff)
+		manager->FeedbackStates(controlID,
+			firstModule * 8 + 1,
+			oldMemory + firstModule,
+			s88Memory + firstModule,
+			lastModule - firstModule + 1,
+			DataModel::Feedback::FeedbackBitOrderLsbFirst);
+	}
+
+	void Hsi88::StoreFeedbackByte(const unsigned char dataByte, const unsigned char module, unsigned char* oldMemory)
+	{
+		if (s88Init[module])
 		{
-			if (diff & 0x01)
-			{
-				DataModel::Feedback::FeedbackState state = static_cast<DataModel::Feedback::FeedbackState>((dataByte >> pin) & 0x01);
-				logger->Info(Languages::TextFeedbackChange, pin + 1, module, Languages::GetOnOff(state));
-				manager->FeedbackState(controlID, module * 8 + pin + 1, state);
-			}
-			diff >>= 1;
-			++pin;
+			// first data of this module, all pins are reported
+			oldMemory[module] = ~dataByte;
+			s88Init[module] = 0;
 		}
 		s88Memory[module] = dataByte;
-		s88Init[module] = 0;
 	}
 
 	void Hsi88::CheckEventsWorker()
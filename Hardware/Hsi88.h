@@ -69,7 +69,7 @@ namespace Hardware
 			std::string GetVersion();
 			unsigned char ConfigureS88();
 			void ReadData();
-			void CheckFeedbackByte(const unsigned char dataByte, const unsigned char module);
+			void StoreFeedbackByte(const unsigned char dataByte, const unsigned char module, unsigned char* oldMemory);
 
 			void CheckEventsWorker();
 	};
@@ -46,7 +46,7 @@ namespace Hardware
 	M6051::M6051(const HardwareParams* params)
 	:	HardwareInterface(params->GetManager(), params->GetControlID(), "Maerklin Interface (6050/6051) / " + params->GetName() + " at serial port " + params->GetArg1()),
 	 	logger(Logger::Logger::GetLogger("M6051 " + params->GetName() + " " + params->GetArg1())),
-	 	serialLine(logger, params->GetArg1(), B2400, 8, 'N', 2),
+	 	serialLine(logger, params->GetControlID(), params->GetArg1(), B2400, 8, 'N', 2),
 		run(true)
 	{
 		logger->Info(Languages::TextStarting, name);
@@ -174,7 +174,10 @@ namespace Hardware
 		{
 			serialLine.ClearBuffers();
 			serialLine.Send(command);
-			for (unsigned char module = 0; module < s88SingleModules; ++module)
+			unsigned char oldMemory[MaxS88Modules];
+			memcpy(oldMemory, s88Memory, sizeof(oldMemory));
+			unsigned char module;
+			for (module = 0; module < s88SingleModules; ++module)
 			{
 				string data;
 				bool ret = serialLine.Receive(data, 1);
@@ -183,38 +186,9 @@ namespace Hardware
 					logger->Error(Languages::TextUnableToReceiveData);
 					break;
 				}
-				unsigned char byte = data[0];
-
-				if (byte != s88Memory[module])
-				{
-					unsigned char xorByte = byte ^ s88Memory[module];
-					for(unsigned char pin = 1; pin <= 8; ++pin)
-					{
-						unsigned char shift = 8 - pin;
-						if (((xorByte >> shift) & 0x01) == 0)
-						{
-							continue;
-						}
-
-						const char* onOff;
-						DataModel::Feedback::FeedbackState state;
-						if ((byte >> shift) & 0x01)
-						{
-							onOff = Languages::GetText(Languages::TextOn);
-							state = DataModel::Feedback::FeedbackStateOccupied;
-						}
-						else
-						{
-							onOff = Languages::GetText(Languages::TextOff);
-							state = DataModel::Feedback::FeedbackStateFree;
-						}
-						logger->Info(Languages::TextFeedbackChange, pin, module, onOff);
-						Address address = (module * 8) + pin;
-						manager->FeedbackState(controlID, address, state);
-					}
-					s88Memory[module] = byte;
-				}
+				s88Memory[module] = data[0];
 			}
+			manager->FeedbackStates(controlID, 1, oldMemory, s88Memory, module, DataModel::Feedback::FeedbackBitOrderMsbFirst);
 			std::this_thread::yield();
 		}
 	}
@@ -18,6 +18,8 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <cstring>
+
 #include "Hardware/OpenDcc.h"
 #include "Utils/Utils.h"
 
@@ -39,7 +41,7 @@ namespace Hardware
 	OpenDcc::OpenDcc(const HardwareParams* params)
 	:	HardwareInterface(params->GetManager(), params->GetControlID(), "OpenDCC / " + params->GetName() + " at serial port " + params->GetArg1()),
 	 	logger(Logger::Logger::GetLogger("OpenDCC " + params->GetName() + " " + params->GetArg1())),
-	 	serialLine(logger, params->GetArg1(), B19200, 8, 'N', 2),
+	 	serialLine(logger, params->GetControlID(), params->GetArg1(), B19200, 8, 'N', 2),
 		run(false)
 	{
 		logger->Info(Languages::TextStarting, name);
@@ -436,34 +438,23 @@ namespace Hardware
 		return (input == OK);
 	}
 
-	void OpenDcc::CheckSensorData(const unsigned char module, const unsigned char data) const
-	{
-		unsigned char diff = s88Memory[module] ^ data;
-		s88Memory[module] = data;
-		FeedbackPin pinOverAll = module;
-		pinOverAll <<= 3;
-		for (unsigned char pinOnModule = 1; pinOnModule <= 8; ++pinOnModule)
-		{
-			if ((diff >> (8 - pinOnModule)) & 0x01)
-			{
-				DataModel::Feedback::FeedbackState state = static_cast<DataModel::Feedback::FeedbackState>((data >> (8 - pinOnModule)) & 0x01);
-				logger->Info(Languages::TextFeedbackChange, pinOnModule, module, Languages::GetText(state ? Languages::TextOn : Languages::TextOff));
-				manager->FeedbackState(controlID, pinOverAll + pinOnModule, state);
-			}
-		}
-	}
-
 	void OpenDcc::SendXEvtSen() const
 	{
 		unsigned char data[1] = { XEvtSen };
 		serialLine.Send(data, sizeof(data));
+
+		// collect all reported modules and hand them over to the manager at once
+		unsigned char oldMemory[MaxS88Modules];
+		memcpy(oldMemory, s88Memory, sizeof(oldMemory));
+		unsigned char firstModule = MaxS88Modules;
+		unsigned char lastModule = 0;
 		while (true)
 		{
 			unsigned char module;
 			size_t ret = serialLine.ReceiveExact(&module, 1);
 			if (ret == 0 || module == 0)
 			{
-				return;
+				break;
 			}
 
 			--module;
@@ -473,21 +464,36 @@ namespace Hardware
 			ret = serialLine.ReceiveExact(data, sizeof(data));
 			if (ret == 0)
 			{
-				return;
+				break;
 			}
 
-			if (s88Memory[module] != data[0])
+			if (module >= MaxS88Modules - 1)
 			{
-				CheckSensorData(module, data[0]);
+				continue;
 			}
 
-			++module;
-
-			if (s88Memory[module] != data[1])
+			s88Memory[module] = data[0];
+			s88Memory[module + 1] = data[1];
+			if (module < firstModule)
+			{
+				firstModule = module;
+			}
+			if (module + 1 > lastModule)
 			{
-				CheckSensorData(module, data[1]);
+				lastModule = module + 1;
 			}
 		}
+
+		if (firstModule > lastModule)
+		{
+			return;
+		}
+		manager->FeedbackStates(controlID,
+			(firstModule << 3) + 1,
+			oldMemory + firstModule,
+			s88Memory + firstModule,
+			lastModule - firstModule + 1,
+			DataModel::Feedback::FeedbackBitOrderMsbFirst);
 	}
 
 	void OpenDcc::SendXEvent() const
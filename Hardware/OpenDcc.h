@@ -77,6 +77,11 @@ namespace Hardware
 
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
 
+			inline bool AccessoryPulsesMayOverlap() const override
+			{
+				return true;
+			}
+
 		private:
 			enum Commands : unsigned char
 			{
@@ -140,7 +145,6 @@ namespace Hardware
 			bool SendRestart() const;
 			unsigned char SendXP88Get(unsigned char param) const;
 			bool SendXP88Set(unsigned char param, unsigned char value) const;
-			void CheckSensorData(const unsigned char module, const unsigned char data) const;
 			void SendXEvtSen() const;
 			void SendXEvent() const;
 
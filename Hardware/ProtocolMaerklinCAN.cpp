@@ -18,12 +18,10 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <deque>
+#include <cstdlib>
 
 #include "Hardware/ProtocolMaerklinCAN.h"
-#include "Hardware/ZLib.h"
 
-using std::deque;
 using std::string;
 using std::vector;
 
@@ -37,11 +35,6 @@ namespace Hardware
 
 	ProtocolMaerklinCAN::~ProtocolMaerklinCAN()
 	{
-		if (canFileData != nullptr)
-		{
-			free(canFileData);
-			canFileData = nullptr;
-		}
 		if (run == false)
 		{
 			return;
@@ -334,6 +327,7 @@ namespace Hardware
 		CanCommand command = ParseCommand(buffer);
 		CanLength length = ParseLength(buffer);
 		logger->Hex(buffer, 5 + length);
+		Logger::PacketCapture::Received(Logger::PacketCapture::SourceCan, controlID, buffer, CANCommandBufferLength);
 		const CanHash receivedHash = ParseHash(buffer);
 		if (receivedHash == hash)
 		{
@@ -529,45 +523,83 @@ namespace Hardware
 
 	void ProtocolMaerklinCAN::ParseCommandConfigDataFirst(const unsigned char* const buffer)
 	{
-		if (canFileData != nullptr)
-		{
-			free(canFileData);
-		}
 		canFileDataSize = Utils::Utils::DataBigEndianToInt(buffer + 5);
+		canFileDataReceived = 0;
+		canFileUncompressedSize = 0;
 		canFileCrc = Utils::Utils::DataBigEndianToShort(buffer + 9);
-		canFileData = reinterpret_cast<unsigned char*>(malloc(canFileDataSize + 8));
-		canFileDataPointer = canFileData;
+		canFileCrcCalculated = 0xFFFF;
+		canFileInflater.Reset();
+		cs2FileState = Cs2FileStateNone;
+		cs2FileLine.clear();
+		cs2FileLocoChanges.clear();
 	}
 
 	void ProtocolMaerklinCAN::ParseCommandConfigDataNext(const unsigned char* const buffer)
 	{
-		if (canFileData == nullptr)
+		if (canFileDataSize == 0)
 		{
 			return;
 		}
 
-		Utils::Utils::Copy8Bytes(buffer + 5, canFileDataPointer);
-		canFileDataPointer += 8;
-		if (canFileDataSize > static_cast<size_t>(canFileDataPointer - canFileData))
+		const unsigned char* const data = buffer + 5;
+		canFileCrcCalculated = CalcFileCrc(canFileCrcCalculated, data, 8);
+		size_t offset = 0;
+		if (canFileDataReceived == 0)
+		{
+			// the first 4 bytes contain the uncompressed size, followed by the zlib stream
+			canFileUncompressedSize = Utils::Utils::DataBigEndianToInt(data);
+			offset = 4;
+		}
+		canFileDataReceived += 8;
+
+		canFileInflater.Input(data + offset, 8 - offset);
+		unsigned char output[1024];
+		size_t outputLength;
+		while ((outputLength = canFileInflater.Output(output, sizeof(output))) > 0)
+		{
+			ParseCs2FileData(reinterpret_cast<const char*>(output), outputLength);
+		}
+
+		if (canFileDataSize > canFileDataReceived)
 		{
 			return;
 		}
 
-		size_t canFileUncompressedSize = Utils::Utils::DataBigEndianToInt(canFileData);
-		logger->Info(Languages::TextConfigFileReceivedWithSize, canFileUncompressedSize);
-		string file = ZLib::UnCompress(reinterpret_cast<char*>(canFileData + 4), canFileDataSize, canFileUncompressedSize);
-		deque<string> lines;
-		Utils::Utils::SplitString(file, "\n", lines);
-		for(std::string& line : lines)
+		canFileDataSize = 0;
+
+		// the crc covers all frames including the padding of the last one
+		if (canFileCrc != canFileCrcCalculated)
+		{
+			logger->Error(Languages::TextConfigFileCrcError, Utils::Utils::IntegerToHex(canFileCrc), Utils::Utils::IntegerToHex(canFileCrcCalculated));
+		}
+		else if (canFileInflater.IsFinished() == false)
+		{
+			logger->Error(Languages::TextConfigFileUncompressError);
+		}
+		else
 		{
-			logger->Debug(line);
+			logger->Info(Languages::TextConfigFileReceivedWithSize, canFileUncompressedSize);
+			FinishCs2File();
+			ApplyCs2FileLocoChanges();
+			return;
 		}
-		ParseCs2File(lines);
+		// nothing of a damaged file reaches the loco cache
+		cs2FileState = Cs2FileStateNone;
+		cs2FileLine.clear();
+		cs2FileLocoChanges.clear();
+	}
 
-		free(canFileData);
-	 	canFileDataSize = 0;
-	 	canFileData = nullptr;
-	 	canFileDataPointer = nullptr;
+	ProtocolMaerklinCAN::CanFileCrc ProtocolMaerklinCAN::CalcFileCrc(CanFileCrc crc, const unsigned char* data, const size_t length)
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			crc ^= data[i] << 8;
+			for (unsigned char bit = 0; bit < 8; ++bit)
+			{
+				crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+			}
+		}
+		return crc;
 	}
 
 	void ProtocolMaerklinCAN::ParseResponseS88Event(const unsigned char* const buffer)
@@ -652,226 +684,290 @@ namespace Hardware
 		logger->Debug(Languages::TextDeviceOnCanBus, deviceString, hash, majorVersion, minorVersion);
 	}
 
-	bool ProtocolMaerklinCAN::ParseCs2FileKeyValue(const string& line, string& key, string& value)
+	bool ProtocolMaerklinCAN::ParseCs2FileKeyValue(const char* line,
+		const size_t length,
+		const size_t indent,
+		const char*& key,
+		size_t& keyLength,
+		const char*& value,
+		size_t& valueLength)
 	{
-		if (line.length() < 4 || line[0] != ' ' || line[1] != '.')
+		// key lines look like " .key=value", subkey lines like " ..key=value"
+		if (length < indent + 3 || line[0] != ' ')
 		{
 			return false;
 		}
-		const string stripedLine = line.substr(2);
-		Utils::Utils::SplitString(stripedLine, "=", key, value);
-		return (key.compare(stripedLine) != 0);
-	}
-
-	bool ProtocolMaerklinCAN::ParseCs2FileSubkeyValue(const string& line, string& key, string& value)
-	{
-		if (line.length() < 5 || line[0] != ' ' || line[1] != '.' || line[2] != '.')
+		for (size_t i = 1; i <= indent; ++i)
+		{
+			if (line[i] != '.')
+			{
+				return false;
+			}
+		}
+		key = line + indent + 1;
+		const size_t rest = length - indent - 1;
+		const char* separator = static_cast<const char*>(memchr(key, '=', rest));
+		if (separator == nullptr)
 		{
+			keyLength = rest;
+			value = line + length;
+			valueLength = 0;
 			return false;
 		}
-		const string stripedLine = line.substr(3);
-		Utils::Utils::SplitString(stripedLine, "=", key, value);
-		return (key.compare(stripedLine) != 0);
+		keyLength = separator - key;
+		value = separator + 1;
+		valueLength = rest - keyLength - 1;
+		return true;
 	}
 
-	void ProtocolMaerklinCAN::ParseCs2FileLocomotiveFunction(deque<string>& lines, LocoCacheEntry& cacheEntry)
+	void ProtocolMaerklinCAN::ParseCs2FileData(const char* data, size_t length)
 	{
-		lines.pop_front();
-		DataModel::LocoFunctionNr nr = 0;
-		DataModel::LocoFunctionType type = DataModel::LocoFunctionTypeNone;
-		DataModel::LocoFunctionIcon icon = DataModel::LocoFunctionIconNone;
-		DataModel::LocoFunctionTimer timer = 0;
-		while (lines.size())
+		while (length > 0)
 		{
-			string& line = lines.front();
-			string key;
-			string value;
-			bool ok = ParseCs2FileSubkeyValue(line, key, value);
-			if (ok == false)
+			const char* end = static_cast<const char*>(memchr(data, '\n', length));
+			if (end == nullptr)
 			{
-				break;
+				cs2FileLine.append(data, length);
+				return;
 			}
-			if (key.compare("nr") == 0)
+			const size_t lineLength = end - data;
+			if (cs2FileLine.empty())
 			{
-				nr = Utils::Utils::StringToInteger(value);
+				ParseCs2FileLine(data, lineLength);
 			}
-			else if (key.compare("typ") == 0)
+			else
 			{
-				uint8_t valueInt = Utils::Utils::StringToInteger(value);
-				icon = static_cast<DataModel::LocoFunctionIcon>(valueInt & 0x7F);
-				type = static_cast<DataModel::LocoFunctionType>((valueInt >> 7) + 1); // CS2: 1 = permanent, 2 = once
+				cs2FileLine.append(data, lineLength);
+				ParseCs2FileLine(cs2FileLine.c_str(), cs2FileLine.length());
+				cs2FileLine.clear();
 			}
-			else if (key.compare("dauer") == 0)
+			data = end + 1;
+			length -= lineLength + 1;
+		}
+	}
+
+	void ProtocolMaerklinCAN::ParseCs2FileLine(const char* line, const size_t length)
+	{
+		switch (cs2FileState)
+		{
+			case Cs2FileStateNone:
+				cs2FileState = Cs2FileCompare(line, length, "[lokomotive]") ? Cs2FileStateLocomotives : Cs2FileStateEnd;
+				return;
+
+			case Cs2FileStateLocomotives:
+				ParseCs2FileLocomotives(line, length);
+				return;
+
+			case Cs2FileStateVersion:
+			case Cs2FileStateSession:
 			{
-				type = DataModel::LocoFunctionTypeTimer;
-				timer = Utils::Utils::StringToInteger(value);
+				const char* key;
+				size_t keyLength;
+				const char* value;
+				size_t valueLength;
+				if (ParseCs2FileKeyValue(line, length, 1, key, keyLength, value, valueLength) == false)
+				{
+					cs2FileState = Cs2FileStateLocomotives;
+					ParseCs2FileLocomotives(line, length);
+					return;
+				}
+				// we do not parse any data in session
+				if (cs2FileState == Cs2FileStateVersion
+					&& Cs2FileCompare(key, keyLength, "minor")
+					&& Cs2FileCompare(value, valueLength, "4") == false)
+				{
+					logger->Warning(Languages::TextCs2MinorVersionIsNot4);
+				}
+				return;
 			}
-			lines.pop_front();
+
+			case Cs2FileStateLocomotive:
+				ParseCs2FileLocomotive(line, length);
+				return;
+
+			case Cs2FileStateFunction:
+				ParseCs2FileLocomotiveFunction(line, length);
+				return;
+
+			case Cs2FileStateEnd:
+			default:
+				return;
 		}
-		if (type == DataModel::LocoFunctionTypeNone)
+	}
+
+	void ProtocolMaerklinCAN::ParseCs2FileLocomotives(const char* line, const size_t length)
+	{
+		if (Cs2FileCompare(line, length, "version"))
 		{
-			icon = DataModel::LocoFunctionIconNone;
-			timer = 0;
-			cacheEntry.ClearFunction(nr);
-			return;
+			cs2FileState = Cs2FileStateVersion;
+		}
+		else if (Cs2FileCompare(line, length, "session"))
+		{
+			cs2FileState = Cs2FileStateSession;
 		}
-		cacheEntry.SetFunction(nr, type, icon, timer);
-		if (type == DataModel::LocoFunctionTypeTimer)
+		else if (Cs2FileCompare(line, length, "lokomotive"))
 		{
-			logger->Info(Languages::TextCs2MasterLocoFunctionIconTypeTimer, nr, icon, timer);
+			cs2FileState = Cs2FileStateLocomotive;
+			cs2FileLoco = LocoCacheEntry();
+			cs2FileLocoOldName.clear();
+			cs2FileLocoRemove = false;
 		}
 		else
 		{
-			logger->Info(Languages::TextCs2MasterLocoFunctionIconType, nr, icon, type);
+			// end of the locomotive section
+			cs2FileState = Cs2FileStateNone;
+			ParseCs2FileLine(line, length);
 		}
 	}
 
-	void ProtocolMaerklinCAN::ParseCs2FileLocomotive(deque<string>& lines)
+	void ProtocolMaerklinCAN::ParseCs2FileLocomotive(const char* line, const size_t length)
 	{
-		lines.pop_front();
-		LocoCacheEntry cacheEntry;
-		std::string oldName;
-		bool remove = false;
-		while (lines.size())
+		if (length == 0 || line[0] != ' ')
 		{
-			string& line = lines.front();
-			string key;
-			string value;
-			if (line.length() == 0 || line[0] != ' ')
-			{
-				return;
-			}
-			ParseCs2FileKeyValue(line, key, value);
-			if (key.compare("name") == 0)
-			{
-				cacheEntry.SetName(value);
-				logger->Info(Languages::TextCs2MasterLocoName, value);
-			}
-			else if (key.compare("vorname") == 0)
-			{
-				oldName = value;
-				logger->Info(Languages::TextCs2MasterLocoOldName, value);
-			}
-			else if (key.compare("toRemove") == 0)
-			{
-				remove = true;
-			}
-			else if (key.compare("uid") == 0)
-			{
-				Address input = Utils::Utils::HexToInteger(value);
-				Address address = AddressNone;
-				Protocol protocol = ProtocolNone;
-				ParseAddressProtocol(input, address, protocol);
-				cacheEntry.SetAddress(address);
-				cacheEntry.SetProtocol(protocol);
-				logger->Info(Languages::TextCs2MasterLocoAddressProtocol, address, protocol);
-			}
-			else if (key.compare("funktionen") == 0)
-			{
-				ParseCs2FileLocomotiveFunction(lines, cacheEntry);
-				continue;
-			}
-			lines.pop_front();
+			FinishCs2FileLocomotive();
+			cs2FileState = Cs2FileStateLocomotives;
+			ParseCs2FileLocomotives(line, length);
+			return;
 		}
-		if (remove)
+		const char* key;
+		size_t keyLength;
+		const char* value;
+		size_t valueLength;
+		ParseCs2FileKeyValue(line, length, 1, key, keyLength, value, valueLength);
+		if (Cs2FileCompare(key, keyLength, "name"))
 		{
-			logger->Info(Languages::TextCs2MasterLocoRemove, name);
-			locoCache.Delete(name);
+			const string name(value, valueLength);
+			cs2FileLoco.SetName(name);
+			logger->Info(Languages::TextCs2MasterLocoName, name);
 		}
-		else if (oldName.size() > 0)
+		else if (Cs2FileCompare(key, keyLength, "vorname"))
 		{
-			locoCache.Replace(cacheEntry, oldName);
+			cs2FileLocoOldName.assign(value, valueLength);
+			logger->Info(Languages::TextCs2MasterLocoOldName, cs2FileLocoOldName);
 		}
-		else
+		else if (Cs2FileCompare(key, keyLength, "toRemove"))
+		{
+			cs2FileLocoRemove = true;
+		}
+		else if (Cs2FileCompare(key, keyLength, "uid"))
+		{
+			// value ends at the line feed or at the end of the line buffer
+			Address input = std::strtoul(value, nullptr, 16);
+			Address address = AddressNone;
+			Protocol protocol = ProtocolNone;
+			ParseAddressProtocol(input, address, protocol);
+			cs2FileLoco.SetAddress(address);
+			cs2FileLoco.SetProtocol(protocol);
+			logger->Info(Languages::TextCs2MasterLocoAddressProtocol, address, protocol);
+		}
+		else if (Cs2FileCompare(key, keyLength, "funktionen"))
 		{
-			locoCache.Insert(cacheEntry);
+			cs2FileState = Cs2FileStateFunction;
+			cs2FileFunctionNr = 0;
+			cs2FileFunctionType = DataModel::LocoFunctionTypeNone;
+			cs2FileFunctionIcon = DataModel::LocoFunctionIconNone;
+			cs2FileFunctionTimer = 0;
 		}
 	}
 
-	void ProtocolMaerklinCAN::ParseCs2FileLocomotivesSession(deque<string>& lines)
+	void ProtocolMaerklinCAN::ParseCs2FileLocomotiveFunction(const char* line, const size_t length)
 	{
-		lines.pop_front();
-		while (lines.size())
+		const char* key;
+		size_t keyLength;
+		const char* value;
+		size_t valueLength;
+		if (ParseCs2FileKeyValue(line, length, 2, key, keyLength, value, valueLength) == false)
 		{
-			string& line = lines.front();
-			string key;
-			string value;
-			bool ok = ParseCs2FileKeyValue(line, key, value);
-			if (ok == false)
-			{
-				return;
-			}
-			// we do not parse any data in session
-			lines.pop_front();
+			FinishCs2FileLocomotiveFunction();
+			cs2FileState = Cs2FileStateLocomotive;
+			ParseCs2FileLocomotive(line, length);
+			return;
+		}
+		// values end at the line feed or at the end of the line buffer
+		if (Cs2FileCompare(key, keyLength, "nr"))
+		{
+			cs2FileFunctionNr = std::strtol(value, nullptr, 10);
+		}
+		else if (Cs2FileCompare(key, keyLength, "typ"))
+		{
+			uint8_t valueInt = std::strtol(value, nullptr, 10);
+			cs2FileFunctionIcon = static_cast<DataModel::LocoFunctionIcon>(valueInt & 0x7F);
+			cs2FileFunctionType = static_cast<DataModel::LocoFunctionType>((valueInt >> 7) + 1); // CS2: 1 = permanent, 2 = once
+		}
+		else if (Cs2FileCompare(key, keyLength, "dauer"))
+		{
+			cs2FileFunctionType = DataModel::LocoFunctionTypeTimer;
+			cs2FileFunctionTimer = std::strtol(value, nullptr, 10);
 		}
 	}
 
-	void ProtocolMaerklinCAN::ParseCs2FileLocomotivesVersion(deque<string>& lines)
+	void ProtocolMaerklinCAN::FinishCs2FileLocomotiveFunction()
 	{
-		lines.pop_front();
-		while (lines.size())
+		if (cs2FileFunctionType == DataModel::LocoFunctionTypeNone)
 		{
-			string& line = lines.front();
-			string key;
-			string value;
-			bool ok = ParseCs2FileKeyValue(line, key, value);
-			if (ok == false)
-			{
-				return;
-			}
-			if (key.compare("minor") == 0 && value.compare("4") != 0)
-			{
-				logger->Warning(Languages::TextCs2MinorVersionIsNot4);
-			}
-			lines.pop_front();
+			cs2FileLoco.ClearFunction(cs2FileFunctionNr);
+			return;
+		}
+		cs2FileLoco.SetFunction(cs2FileFunctionNr, cs2FileFunctionType, cs2FileFunctionIcon, cs2FileFunctionTimer);
+		if (cs2FileFunctionType == DataModel::LocoFunctionTypeTimer)
+		{
+			logger->Info(Languages::TextCs2MasterLocoFunctionIconTypeTimer, cs2FileFunctionNr, cs2FileFunctionIcon, cs2FileFunctionTimer);
+		}
+		else
+		{
+			logger->Info(Languages::TextCs2MasterLocoFunctionIconType, cs2FileFunctionNr, cs2FileFunctionIcon, cs2FileFunctionType);
 		}
 	}
 
-	void ProtocolMaerklinCAN::ParseCs2FileLocomotives(deque<string>& lines)
+	void ProtocolMaerklinCAN::FinishCs2FileLocomotive()
+	{
+		cs2FileLocoChanges.push_back(Cs2FileLocoChange { cs2FileLoco, cs2FileLocoOldName, cs2FileLocoRemove });
+	}
+
+	void ProtocolMaerklinCAN::FinishCs2File()
 	{
-		lines.pop_front();
-		while (lines.size())
+		if (cs2FileLine.empty() == false)
 		{
-			string& line = lines.front();
-			if (line.length() == 0)
-			{
-				return;
-			}
-			if (line.compare("version") == 0)
-			{
-				ParseCs2FileLocomotivesVersion(lines);
-				continue;
-			}
-			else if (line.compare("session") == 0)
-			{
-				ParseCs2FileLocomotivesSession(lines);
-				continue;
-			}
-			else if (line.compare("lokomotive") == 0)
-			{
-				ParseCs2FileLocomotive(lines);
-				continue;
-			}
-			return;
+			ParseCs2FileLine(cs2FileLine.c_str(), cs2FileLine.length());
+			cs2FileLine.clear();
 		}
+		switch (cs2FileState)
+		{
+			case Cs2FileStateFunction:
+				FinishCs2FileLocomotiveFunction();
+				FinishCs2FileLocomotive();
+				break;
+
+			case Cs2FileStateLocomotive:
+				FinishCs2FileLocomotive();
+				break;
+
+			default:
+				break;
+		}
+		cs2FileState = Cs2FileStateNone;
 	}
 
-	void ProtocolMaerklinCAN::ParseCs2File(deque<string>& lines)
+	void ProtocolMaerklinCAN::ApplyCs2FileLocoChanges()
 	{
-		while (lines.size())
+		for (const Cs2FileLocoChange& change : cs2FileLocoChanges)
 		{
-			string& line = lines.front();
-			if (line.length() == 0 || line[0] != '[')
+			if (change.remove)
 			{
-				return;
+				const string& locoName = change.loco.GetName();
+				logger->Info(Languages::TextCs2MasterLocoRemove, locoName);
+				locoCache.Delete(locoName);
 			}
-			if (line.compare("[lokomotive]") == 0)
+			else if (change.oldName.size() > 0)
 			{
-				ParseCs2FileLocomotives(lines);
-				continue;
+				locoCache.Replace(change.loco, change.oldName);
+			}
+			else
+			{
+				locoCache.Insert(change.loco);
 			}
-			return;
 		}
+		cs2FileLocoChanges.clear();
 	}
 
 	const DataModel::LocoFunctionIcon ProtocolMaerklinCAN::LocoFunctionMapCs2ToRailControl[MaxNrOfCs2FunctionIcons] = {
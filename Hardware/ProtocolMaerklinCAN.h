@@ -20,13 +20,19 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include "DataModel/AccessoryBase.h"
 #include "DataModel/LocoFunctions.h"
 #include "Hardware/Capabilities.h"
 #include "Hardware/LocoCache.h"
+#include "Hardware/ZLib.h"
 #include "HardwareInterface.h"
 #include "HardwareParams.h"
 #include "Logger/Logger.h"
+#include "Logger/PacketCapture.h"
 #include "Utils/Utils.h"
 
 // CAN protocol specification at http://streaming.maerklin.de/public-media/cs2/cs2CAN-Protokoll-2_0.pdf
@@ -85,6 +91,12 @@ namespace Hardware
 				const DataModel::LocoFunctionState on) override;
 
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
+
+			inline bool AccessoryPulsesMayOverlap() const override
+			{
+				return true;
+			}
+
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
 
@@ -98,8 +110,16 @@ namespace Hardware
 				uid(Utils::Utils::HexToInteger(params->GetArg5(), 0)),
 				hasCs2Master(false),
 				canFileDataSize(0),
-				canFileData(nullptr),
-				canFileDataPointer(nullptr)
+				canFileDataReceived(0),
+				canFileUncompressedSize(0),
+				canFileCrc(0),
+				canFileCrcCalculated(0),
+				cs2FileState(Cs2FileStateNone),
+				cs2FileLocoRemove(false),
+				cs2FileFunctionNr(0),
+				cs2FileFunctionType(DataModel::LocoFunctionTypeNone),
+				cs2FileFunctionIcon(DataModel::LocoFunctionIconNone),
+				cs2FileFunctionTimer(0)
 			{
 				if (uid == 0)
 				{
@@ -283,6 +303,26 @@ namespace Hardware
 			typedef uint16_t CanHash;
 			typedef uint16_t CanFileCrc;
 
+			enum Cs2FileState : unsigned char
+			{
+				Cs2FileStateNone = 0,
+				Cs2FileStateLocomotives,
+				Cs2FileStateVersion,
+				Cs2FileStateSession,
+				Cs2FileStateLocomotive,
+				Cs2FileStateFunction,
+				Cs2FileStateEnd
+			};
+
+			// a finished locomotive of the config file, applied to the loco cache
+			// only after the whole file has been received and checked
+			struct Cs2FileLocoChange
+			{
+				LocoCacheEntry loco;
+				std::string oldName;
+				bool remove;
+			};
+
 			void CreateCommandHeader(unsigned char* const buffer, const CanCommand command, const CanResponse response, const CanLength length);
 			inline void ParseAddressProtocol(const unsigned char* const buffer, Address& address, Protocol& protocol)
 			{
@@ -344,14 +384,33 @@ namespace Hardware
 			void ParseResponseReadConfig(const unsigned char* const buffer);
 			void ParseResponsePing(const unsigned char* const buffer);
 
-			bool ParseCs2FileKeyValue(const std::string& line, std::string& key, std::string& value);
-			bool ParseCs2FileSubkeyValue(const std::string& line, std::string& key, std::string& value);
-			void ParseCs2FileLocomotiveFunction(std::deque<std::string>& lines, LocoCacheEntry& cacheEntry);
-			void ParseCs2FileLocomotive(std::deque<std::string>& lines);
-			void ParseCs2FileLocomotivesSession(std::deque<std::string>& lines);
-			void ParseCs2FileLocomotivesVersion(std::deque<std::string>& lines);
-			void ParseCs2FileLocomotives(std::deque<std::string>& lines);
-			void ParseCs2File(std::deque<std::string>& lines);
+			// CRC-16 CCITT as used by the config data stream
+			static CanFileCrc CalcFileCrc(CanFileCrc crc, const unsigned char* data, const size_t length);
+
+			// the parser works on the inflated data as it arrives, lines are not copied unless they span two chunks
+			void ParseCs2FileData(const char* data, size_t length);
+			void ParseCs2FileLine(const char* line, const size_t length);
+			void ParseCs2FileLocomotives(const char* line, const size_t length);
+			void ParseCs2FileLocomotive(const char* line, const size_t length);
+			void ParseCs2FileLocomotiveFunction(const char* line, const size_t length);
+			void FinishCs2FileLocomotive();
+			void FinishCs2FileLocomotiveFunction();
+			void FinishCs2File();
+			void ApplyCs2FileLocoChanges();
+
+			// value points into the line and ends at the end of the line
+			static bool ParseCs2FileKeyValue(const char* line,
+				const size_t length,
+				const size_t indent,
+				const char*& key,
+				size_t& keyLength,
+				const char*& value,
+				size_t& valueLength);
+
+			static inline bool Cs2FileCompare(const char* data, const size_t length, const char* text)
+			{
+				return strlen(text) == length && memcmp(data, text, length) == 0;
+			}
 
 			static inline DataModel::LocoFunctionIcon MapLocoFunctionCs2ToRailControl(const DataModel::LocoFunctionIcon input)
 			{
@@ -370,6 +429,7 @@ namespace Hardware
 			inline void SendInternal(const unsigned char* buffer)
 			{
 				logger->Hex(buffer, 5 + ParseLength(buffer));
+				Logger::PacketCapture::Sent(Logger::PacketCapture::SourceCan, controlID, buffer, CANCommandBufferLength);
 				Send(buffer);
 			}
 			virtual void Send(const unsigned char* buffer) = 0;
@@ -393,9 +453,22 @@ namespace Hardware
 			std::thread cs2MasterThread;
 
 			size_t canFileDataSize;
+			size_t canFileDataReceived;
+			size_t canFileUncompressedSize;
 			CanFileCrc canFileCrc;
-			unsigned char* canFileData;
-			unsigned char* canFileDataPointer;
+			CanFileCrc canFileCrcCalculated;
+			ZLib::Inflater canFileInflater;
+
+			Cs2FileState cs2FileState;
+			std::string cs2FileLine;
+			LocoCacheEntry cs2FileLoco;
+			std::string cs2FileLocoOldName;
+			bool cs2FileLocoRemove;
+			std::vector<Cs2FileLocoChange> cs2FileLocoChanges;
+			DataModel::LocoFunctionNr cs2FileFunctionNr;
+			DataModel::LocoFunctionType cs2FileFunctionType;
+			DataModel::LocoFunctionIcon cs2FileFunctionIcon;
+			DataModel::LocoFunctionTimer cs2FileFunctionTimer;
 
 			LocoCache locoCache;
 
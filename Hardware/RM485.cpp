@@ -88,24 +88,17 @@ namespace Hardware
 		logger->Info(Languages::TextRM485ModuleFound, address);
 		uint16_t baseAddress = address * Communication::MaxInputBytesPerModule;
 		ssize_t length = communication.ReadAll(address, data + baseAddress);
-		for (uint16_t a = baseAddress; a < baseAddress + length; ++a)
+		if (length <= 0)
 		{
-			if (data[a] == 0)
-			{
-				return;
-			}
-			uint8_t dataByte = data[a];
-			for (uint16_t pin = baseAddress * 8 + 1; pin <= (baseAddress + 1) * 8; ++pin)
-			{
-				DataModel::Feedback::FeedbackState state = ((dataByte & 0x01) == 0 ? DataModel::Feedback::FeedbackStateFree : DataModel::Feedback::FeedbackStateOccupied);
-				if (state == DataModel::Feedback::FeedbackStateOccupied)
-				{
-					logger->Info(Languages::TextFeedbackChange, ((pin - 1) & 0x07) + 1, address, state);
-					manager->FeedbackState(controlID, pin, state);
-				}
-				dataByte >>= 1;
-			}
+			return;
+		}
+		if (length > Communication::MaxInputBytesPerModule)
+		{
+			length = Communication::MaxInputBytesPerModule;
 		}
+		// all pins set at the scan are reported as occupied
+		const uint8_t noData[Communication::MaxInputBytesPerModule] = { 0 };
+		manager->FeedbackStates(controlID, baseAddress * 8 + 1, noData, data + baseAddress, length, DataModel::Feedback::FeedbackBitOrderLsbFirst);
 	}
 
 	void RM485::ScanBus()
@@ -129,23 +122,22 @@ namespace Hardware
 			uint8_t addresses[MaxDeltaBytesPerModule];
 			uint8_t newData[MaxDeltaBytesPerModule];
 			ssize_t length = communication.ReadDelta(address, addresses, newData);
+			if (length <= 0)
+			{
+				continue;
+			}
+			const uint16_t baseAddress = address * Communication::MaxInputBytesPerModule;
+			uint8_t oldData[Communication::MaxInputBytesPerModule];
+			memcpy(oldData, data + baseAddress, sizeof(oldData));
 			for (uint8_t pos = 0; pos < length; ++pos)
 			{
-				uint16_t byteAddress = (address * Communication::MaxInputBytesPerModule) + addresses[pos];
-				uint8_t oldData = data[byteAddress];
-				uint8_t diff = oldData ^ newData[pos];
-				for (uint8_t shift = 0; shift < 8; ++shift)
+				if (addresses[pos] >= Communication::MaxInputBytesPerModule)
 				{
-					if ((diff >> shift) & 0x01)
-					{
-						DataModel::Feedback::FeedbackState state = (((newData[pos] >> shift) & 0x01) == 0 ? DataModel::Feedback::FeedbackStateFree : DataModel::Feedback::FeedbackStateOccupied);
-						uint16_t pin = (byteAddress * 8) + shift + 1;
-						logger->Info(Languages::TextFeedbackChange, shift + 1, byteAddress, state);
-						manager->FeedbackState(controlID, pin, state);
-					}
+					continue;
 				}
-				data[byteAddress] = newData[pos];
+				data[baseAddress + addresses[pos]] = newData[pos];
 			}
+			manager->FeedbackStates(controlID, baseAddress * 8 + 1, oldData, data + baseAddress, sizeof(oldData), DataModel::Feedback::FeedbackBitOrderLsbFirst);
 		}
 		Utils::Utils::SleepForMilliseconds(100);
 	}
@@ -70,6 +70,12 @@ namespace Hardware
 				const DataModel::LocoFunctionState on) override;
 
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
+
+			inline bool AccessoryPulsesMayOverlap() const override
+			{
+				return true;
+			}
+
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
 
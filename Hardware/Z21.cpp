@@ -31,6 +31,7 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Hardware
 {
+	const unsigned int Z21::SendWindowMs;
 
 	// create instance of Z21
 	extern "C" Z21* create_Z21(const HardwareParams* params)
@@ -50,7 +51,12 @@ namespace Hardware
 	 	run(true),
 	 	connection(logger, params->GetArg1(), Z21Port),
 	 	lastProgramMode(ProgramModeMm),
-	 	connected(false)
+	 	connected(false),
+	 	accessoryQueue(AccessoryQueueSize, Utils::QueueOverflowBlock),
+	 	sendDatagrams(SendBatchSize, Z21CommandBufferLength),
+	 	senderRun(true),
+	 	packetsSent(0),
+	 	datagramsSent(0)
 	{
 		logger->Info(Languages::TextStarting, name);
 
@@ -62,6 +68,7 @@ namespace Hardware
 		{
 			logger->Error(Languages::TextUnableToCreateUdpSocket, params->GetArg1(), Z21Port);
 		}
+		senderThread = std::thread(&Hardware::Z21::Sender, this);
 		receiverThread = std::thread(&Hardware::Z21::Receiver, this);
 		heartBeatThread = std::thread(&Hardware::Z21::HeartBeatSender, this);
 		accessorySenderThread = std::thread(&Hardware::Z21::AccessorySender, this);
@@ -72,8 +79,14 @@ namespace Hardware
 		run = false;
 		SendLogOff();
 		accessoryQueue.Terminate();
-		connection.Terminate();
 		accessorySenderThread.join();
+		{
+			std::lock_guard<std::mutex> guard(sendMutex);
+			senderRun = false;
+		}
+		sendAvailable.notify_one();
+		senderThread.join();
+		connection.Terminate();
 		heartBeatThread.join();
 		receiverThread.join();
 		logger->Info(Languages::TextTerminatingSenderSocket);
@@ -283,8 +296,7 @@ namespace Hardware
 		{
 			return;
 		}
-		AccessoryQueueEntry entry(protocol, address, state, duration);
-		accessoryQueue.Enqueue(entry);
+		accessoryQueue.Enqueue(AccessoryQueueEntry(protocol, address, state, duration));
 	}
 
 	void Z21::AccessoryOn(const Protocol protocol, const Address address, const DataModel::AccessoryState state)
@@ -313,10 +325,10 @@ namespace Hardware
 		logger->Info(Languages::TextAccessorySenderThreadStarted);
 		while (run)
 		{
-			AccessoryQueueEntry entry = accessoryQueue.Dequeue();
-			if (entry.protocol == ProtocolNone)
+			AccessoryQueueEntry entry;
+			if (accessoryQueue.Dequeue(entry) == false)
 			{
-				// ProtocolNone is in queue when we should quit
+				// queue has been terminated
 				continue;
 			}
 			SendSetTurnoutMode(entry.address, entry.protocol);
@@ -472,38 +484,44 @@ namespace Hardware
 		Utils::Utils::SetThreadName("Z21 Receiver");
 		logger->Info(Languages::TextReceiverThreadStarted);
 
-		unsigned char buffer[Z21CommandBufferLength];
+		Network::UdpDatagrams datagrams(ReceiveBatchSize, Z21CommandBufferLength);
 		while(run)
 		{
-			ssize_t dataLength = connection.Receive(buffer, sizeof(buffer));
+			int nrOfDatagrams = connection.ReceiveBatch(datagrams);
 
 			if (run == false)
 			{
 				break;
 			}
 
-			if (dataLength < 0)
+			if (nrOfDatagrams < 0)
 			{
 				logger->Error(Languages::TextUnableToReceiveData);
 				break;
 			}
 
-			if (dataLength == 0)
+			for (int datagram = 0; datagram < nrOfDatagrams; ++datagram)
 			{
-				continue;
-			}
+				const unsigned char* buffer = datagrams.Data(datagram);
+				const ssize_t dataLength = datagrams.Length(datagram);
+				if (dataLength == 0)
+				{
+					continue;
+				}
 
-			logger->Hex(buffer, dataLength);
+				logger->Hex(buffer, dataLength);
+				Logger::PacketCapture::Received(Logger::PacketCapture::SourceZ21, controlID, buffer, dataLength);
 
-			ssize_t dataRead = 0;
-			while (dataRead < dataLength)
-			{
-				ssize_t ret = ParseData(buffer + dataRead, dataLength - dataRead);
-				if (ret == -1)
+				ssize_t dataRead = 0;
+				while (dataRead < dataLength)
 				{
-					break;
+					ssize_t ret = ParseData(buffer + dataRead, dataLength - dataRead);
+					if (ret == -1)
+					{
+						break;
+					}
+					dataRead += ret;
 				}
-				dataRead += ret;
 			}
 		}
 		logger->Info(Languages::TextTerminatingReceiverThread);
@@ -893,31 +911,17 @@ namespace Hardware
 		{
 			return;
 		}
-		unsigned char moduleShift = buffer[4] * 10;
-		for (unsigned char index = 0; index < 10; ++index)
+		const unsigned char NrOfModules = 10;
+		const unsigned char moduleShift = buffer[4] * NrOfModules;
+		const unsigned char* newData = buffer + 5;
+		unsigned char oldData[NrOfModules];
+		for (unsigned char index = 0; index < NrOfModules; ++index)
 		{
 			const unsigned char module = index + moduleShift;
-			const unsigned char newData = buffer[5 + index];
-			const unsigned char oldData = feedbackCache.Get(module);
-			if (newData == oldData)
-			{
-				continue;
-			}
-			const unsigned char diff = newData ^ oldData;
-			for (unsigned char pinOnModule = 0; pinOnModule < 8; ++pinOnModule)
-			{
-				const unsigned char pinDiff = (diff >> pinOnModule) & 0x01;
-				if (pinDiff == 0)
-				{
-					continue;
-				}
-				const unsigned char pinData = newData >> pinOnModule;
-				const unsigned char pin = module * 8 + pinOnModule + 1;
-				logger->Info(Languages::TextFeedbackChange, pin, module, Languages::GetOnOff(static_cast<DataModel::Feedback::FeedbackState>(pinData)));
-				manager->FeedbackState(controlID, pin, static_cast<DataModel::Feedback::FeedbackState>(pinData));
-			}
-			feedbackCache.Set(module, newData);
+			oldData[index] = feedbackCache.Get(module);
+			feedbackCache.Set(module, newData[index]);
 		}
+		manager->FeedbackStates(controlID, moduleShift * 8 + 1, oldData, newData, NrOfModules, DataModel::Feedback::FeedbackBitOrderLsbFirst);
 	}
 
 	void Z21::ParseDetectorData(const unsigned char *buffer)
@@ -1110,6 +1114,73 @@ namespace Hardware
 	int Z21::Send(const unsigned char* buffer, const size_t bufferLength)
 	{
 		logger->Hex(buffer, bufferLength);
-		return connection.Send(buffer, bufferLength);
+		Logger::PacketCapture::Sent(Logger::PacketCapture::SourceZ21, controlID, buffer, bufferLength);
+		bool first;
+		{
+			std::lock_guard<std::mutex> guard(sendMutex);
+			first = sendDatagrams.IsEmpty();
+			if (first)
+			{
+				sendDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SendWindowMs);
+			}
+			if (sendDatagrams.Append(buffer, bufferLength) == false)
+			{
+				// all datagrams are full, do not wait for the sender
+				SendBufferUnlocked();
+				sendDatagrams.Append(buffer, bufferLength);
+			}
+			++packetsSent;
+		}
+		if (first)
+		{
+			sendAvailable.notify_one();
+		}
+		return bufferLength;
+	}
+
+	void Z21::SendBufferUnlocked()
+	{
+		if (sendDatagrams.IsEmpty())
+		{
+			return;
+		}
+		int ret = connection.SendBatch(sendDatagrams);
+		if (ret > 0)
+		{
+			datagramsSent += ret;
+		}
+		sendDatagrams.Clear();
+	}
+
+	void Z21::Sender()
+	{
+		// the Z21 accepts several LAN packets in one datagram.
+		// Packets are collected for a short time and sent together.
+		Utils::Utils::SetThreadName("Z21 Sender");
+		std::unique_lock<std::mutex> lock(sendMutex);
+		while (true)
+		{
+			if (sendDatagrams.IsEmpty())
+			{
+				if (senderRun == false)
+				{
+					break;
+				}
+				sendAvailable.wait(lock);
+				continue;
+			}
+			if (senderRun && std::chrono::steady_clock::now() < sendDeadline)
+			{
+				sendAvailable.wait_until(lock, sendDeadline);
+				continue;
+			}
+			SendBufferUnlocked();
+		}
+	}
+
+	void Z21::GetStatistics(std::map<Languages::TextSelector,uint64_t>& statistics) const
+	{
+		statistics[Languages::TextPacketsSent] = packetsSent;
+		statistics[Languages::TextDatagramsSent] = datagramsSent;
 	}
 } // namespace
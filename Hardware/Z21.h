@@ -21,7 +21,11 @@ along with RailControl; see the file LICENCE. If not see
 #pragma once
 
 #include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -32,6 +36,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/Z21LocoCache.h"
 #include "Hardware/Z21TurnoutCache.h"
 #include "Logger/Logger.h"
+#include "Logger/PacketCapture.h"
 #include "Network/UdpConnection.h"
 
 // protocol specification at https://www.z21.eu/media/Kwc_Basic_DownloadTag_Component/47-1652-959-downloadTag/default/69bad87e/1558674980/z21-lan-protokoll.pdf
@@ -137,10 +142,16 @@ namespace Hardware
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
 
+			void GetStatistics(std::map<Languages::TextSelector,uint64_t>& statistics) const override;
+
 		private:
 			static const unsigned short Z21Port = 21105;
 			static const unsigned int Z21CommandBufferLength = 1472; // = Max Ethernet MTU
+			static const unsigned int SendWindowMs = 2; // packets sent within this time are packed into one datagram
+			static const unsigned int SendBatchSize = 8; // datagrams sent with one system call
+			static const unsigned int ReceiveBatchSize = 16; // datagrams received with one system call
 			static const Address MaxMMAddress = 255;
+			static const size_t AccessoryQueueSize = 256;
 
 			enum BroadCastFlag : uint32_t
 			{
@@ -249,6 +260,15 @@ namespace Hardware
 
 			Utils::ThreadSafeQueue<AccessoryQueueEntry> accessoryQueue;
 
+			std::thread senderThread;
+			std::mutex sendMutex;
+			std::condition_variable sendAvailable;
+			Network::UdpDatagrams sendDatagrams;
+			std::chrono::steady_clock::time_point sendDeadline;
+			volatile bool senderRun;
+			std::atomic<uint64_t> packetsSent;
+			std::atomic<uint64_t> datagramsSent;
+
 			void ProgramMm(const CvNumber cv, const CvValue value);
 			void ProgramDccRead(const CvNumber cv);
 			void ProgramDccWrite(const CvNumber cv, const CvValue value);
@@ -256,6 +276,8 @@ namespace Hardware
 
 			void LocoSpeedOrientation(const Protocol protocol, const Address address, const Speed speed, const Orientation orientation);
 			void AccessorySender();
+			void Sender();
+			void SendBufferUnlocked();
 			void HeartBeatSender();
 			void Receiver();
 			ssize_t ParseData(const unsigned char* buffer, size_t bufferLength);
@@ -45,33 +45,99 @@ string ZLib::Compress(const string& input)
 	return outputData;
 }
 
-string ZLib::UnCompress(const char* input, const size_t inputSize, const size_t outputSize)
+string ZLib::CompressGzip(const string& input)
 {
 	z_stream strm;
 	strm.zalloc = Z_NULL;
 	strm.zfree = Z_NULL;
 	strm.opaque = Z_NULL;
-	strm.avail_in = 0;
-	strm.next_in = Z_NULL;
-	int ret = inflateInit(&strm);
+	// windowBits 15 + 16 writes a gzip header instead of a zlib header
+	int ret = deflateInit2(&strm, 9, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
 	if (ret != Z_OK)
 	{
 		return "";
 	}
-	strm.avail_in = inputSize;
+
+	const unsigned long outputSize = deflateBound(&strm, input.size()) + 18;
+	unsigned char* outputBuffer = reinterpret_cast<unsigned char*>(malloc(outputSize));
+	if (outputBuffer == nullptr)
+	{
+		deflateEnd(&strm);
+		return "";
+	}
+	strm.avail_in = input.size();
+	strm.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(input.c_str()));
 	strm.avail_out = outputSize;
-	strm.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(input));
-	char* outputBuffer = reinterpret_cast<char*>(malloc(outputSize));
-	strm.next_out = reinterpret_cast<unsigned char*>(outputBuffer);
-	ret = inflate(&strm, Z_NO_FLUSH);
-	inflateEnd(&strm);
+	strm.next_out = outputBuffer;
+	ret = deflate(&strm, Z_FINISH);
+	const unsigned long compressedSize = outputSize - strm.avail_out;
+	deflateEnd(&strm);
 	if (ret != Z_STREAM_END)
 	{
 		free(outputBuffer);
 		return "";
 	}
 
-	std::string output(outputBuffer, outputSize);
+	string outputData(reinterpret_cast<char*>(outputBuffer), compressedSize);
 	free(outputBuffer);
-	return output;
+	return outputData;
+}
+
+ZLib::Inflater::Inflater()
+:	stream(new z_stream),
+	finished(false),
+	error(false)
+{
+	stream->zalloc = Z_NULL;
+	stream->zfree = Z_NULL;
+	stream->opaque = Z_NULL;
+	stream->avail_in = 0;
+	stream->next_in = Z_NULL;
+	error = (inflateInit(stream) != Z_OK);
+}
+
+ZLib::Inflater::~Inflater()
+{
+	inflateEnd(stream);
+	delete stream;
+}
+
+void ZLib::Inflater::Reset()
+{
+	stream->avail_in = 0;
+	stream->next_in = Z_NULL;
+	finished = false;
+	error = (inflateReset(stream) != Z_OK);
+}
+
+void ZLib::Inflater::Input(const unsigned char* input, const size_t inputSize)
+{
+	stream->avail_in = inputSize;
+	stream->next_in = const_cast<unsigned char*>(input);
+}
+
+size_t ZLib::Inflater::Output(unsigned char* output, const size_t outputSize)
+{
+	if (finished || error)
+	{
+		return 0;
+	}
+	stream->avail_out = outputSize;
+	stream->next_out = output;
+	int ret = inflate(stream, Z_NO_FLUSH);
+	switch (ret)
+	{
+		case Z_STREAM_END:
+			finished = true;
+			break;
+
+		case Z_OK:
+		case Z_BUF_ERROR: // no progress possible, more input needed
+			break;
+
+		default:
+			error = true;
+			return 0;
+	}
+	return outputSize - stream->avail_out;
 }
@@ -22,9 +22,43 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <string>
 
+struct z_stream_s;
+
 class ZLib
 {
 	public:
 		static std::string Compress(const std::string& input);
-		static std::string UnCompress(const char* input, const size_t inputSize, const size_t outputSize);
+		// output with gzip header and trailer, as needed for HTTP Content-Encoding: gzip
+		static std::string CompressGzip(const std::string& input);
+
+		// Inflates a zlib stream that arrives in pieces without buffering the whole stream.
+		// Each piece is handed over with Input() and inflated with Output() until Output() returns 0.
+		class Inflater
+		{
+			public:
+				Inflater(const Inflater&) = delete;
+				Inflater& operator=(const Inflater&) = delete;
+
+				Inflater();
+				~Inflater();
+
+				// prepares the inflater for a new stream
+				void Reset();
+
+				// input must stay valid until Output() returns 0
+				void Input(const unsigned char* input, const size_t inputSize);
+
+				// returns the number of bytes written to output, 0 if more input is needed
+				size_t Output(unsigned char* output, const size_t outputSize);
+
+				inline bool IsFinished() const
+				{
+					return finished;
+				}
+
+			private:
+				z_stream_s* stream;
+				bool finished;
+				bool error;
+		};
 };
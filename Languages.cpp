@@ -76,6 +76,8 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextCanNotStartAlreadyRunning */ { "Can not start {0} because it is already running", "Unmöglich {0} zu starten weil schon gestartet", "Imposible poner {0} en marcha porque ya está en marcha" },
 /* TextCanNotStartInErrorState */ { "Can not start {0} because it is in error state", "Unmöglich {0} zu startein weil sie im Fehlerstatus ist", "Imposible poner {0} en marcha perque está en estado error" },
 /* TextCanNotStartNotOnTrack */ { "Can not start {0} because it is not on a track", "Unmöglich {0} zu starten weil sie nicht auf einem Gleis ist", "Imposible poner {0} en marcha porque no está sobre un vía" },
+/* TextCapturedPacketsDropped */ { "{0} captured packets dropped because the capture buffer was full", "{0} aufgezeichnete Pakete verworfen, weil der Aufzeichnungspuffer voll war", "{0} paquetes capturados descartados porque el búfer de captura estaba lleno" },
+/* TextCapturingPackets */ { "Capturing hardware packets to {0}", "Zeichne Hardware-Pakete in {0} auf", "Capturando paquetes de hardware en {0}" },
 /* TextCheckSumError */ { "Checksum error", "Checksummen fehler", "Error de checksum" },
 /* TextClosingSQLite */ { "Closing SQLite database", "Schliesse SQLite Datenbank", "Cerrando base de datos SQLite" },
 /* TextCluster */ { "Cluster", "Gruppe", "Grupo" },
@@ -83,7 +85,12 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextClusterDoesNotExist */ { "Cluster does not exist", "Gruppe existiert nicht", "Grupo no existe" },
 /* TextClusterUpdated */ { "Cluster {0} updated", "Gruppe {0} aktualisiert", "Grupo {0} actualizado" },
 /* TextClusters */ { "Clusters", "Gruppen", "Grupos" },
+/* TextCoalescedCommands */ { "Coalesced", "Zusammengefasst", "Combinados" },
+/* TextCommand */ { "Command", "Befehl", "Comando" },
+/* TextCommandStatistics */ { "Command statistics", "Befehlsstatistik", "Estadísticas de comandos" },
+/* TextConfigFileCrcError */ { "Configuration file received with wrong CRC {0}, calculated CRC is {1}", "Konfigurationsdatei mit falscher CRC {0} empfangen, berechnete CRC ist {1}", "Archivo de configuración recibido con CRC {0} incorrecto, CRC calculado es {1}" },
 /* TextConfigFileReceivedWithSize */ { "Configuration file with {0} bytes received", "Konfigurationsdatei mit {0} Bytes empfangen", "Archivo de configuración recibido con {0} bytes" },
+/* TextConfigFileUncompressError */ { "Unable to uncompress configuration file", "Konfigurationsdatei kann nicht entpackt werden", "Imposible descomprimir el archivo de configuración" },
 /* TextConfigureControlFirst */ { "Please configure a control first", "Bitte zuerst eine Zentrale konfigurieren", "Por favor configura un control antes" },
 /* TextConnectionFailed */ { "Connection to {0}:{1} failed", "Verbindung zu {0}:{1} nicht möglich", "Imposible conectar a {0}:{1}" },
 /* TextConnectionRefused */ { "Connection to {0}:{1} refused", "Verbindung zu {0}:{1} zurückgewiesen", "Falló intento de conectar a {0}:{1}" },
@@ -116,9 +123,9 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextCs2MasterLocoOldName */ { "CS2 Master has locomotive with former name {0}", "CS2 Master hat eine Lokomotive mit dem bisherigen Namen {0}", "CS2 master tiene una locomotora con el nombre antiguo {0}" },
 /* TextCs2MasterLocoRemove */ { "CS2 Master has removed locomotive with name {0}", "CS2 Master hat eine Lokomotive mit dem Namen {0} gelöscht", "CS2 master ha eliminado la locomotora con el nombre {0}" },
 /* TextCs2MinorVersionIsNot4 */ { "Minor version of received file is not 4", "Minor Version des erhaltenen files ist nicht 4", "La versión menor no es 4" },
+/* TextDatagramsSent */ { "Datagrams sent", "Gesendete Datagramme", "Datagramas enviados" },
 /* TextDcc */ { "DCC", "DCC", "DCC" },
-/* TextDebounceThreadStarted */ { "Debounce thread started", "Entprellthread gestartet", "Antirebote thread encendido" },
-/* TextDebounceThreadTerminated */ { "Debounce thread terminated", "Entprellthread beedet", "Antirebote thread apagado" },
+/* TextDebounceTime */ { "Debounce time (ms)", "Entprellzeit (ms)", "Tiempo de antirebote (ms)" },
 /* TextDebouncer */ { "Debouncer", "Entpreller", "Antirebote" },
 /* TextDebug */ { "debug", "Entkäfern", "depurar" },
 /* TextDefaultSwitchingDuration */ { "Default switching duration (ms)", "Standard Schaltzeit (ms)", "Duración de conmutación por defecto (ms)" },
@@ -161,6 +168,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextEditTracks */ { "Edit tracks", "Gleise bearbeiten", "Editar vías" },
 /* TextEnglish */ { "English", "Englisch", "Ingles" },
 /* TextError */ { "error", "Fehler", "errores" },
+/* TextExecutedCommands */ { "Executed", "Ausgeführt", "Ejecutados" },
 /* TextExecutingRoute */ { "Executing route {0}", "Führe Fahrstrasse {0} aus", "Ejecutando itinerario {0}" },
 /* TextExitRailControl */ { "Exit RailControl", "RailControl beenden", "Apagar RailControl" },
 /* TextFeedback */ { "feedback", "Rückmelder", "retroseñal" },
@@ -171,6 +179,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextFeedbackSaved */ { "Feedback {0} saved", "Rückmelder {0} gespeichert", "Retroseñal {0} guardado" },
 /* TextFeedbackStateIsOff */ { "Feedback state of {0} is now off", "Der Status des Rückmelders {0} ist nun aus", "El estado de la retroseñal {0} está apagada" },
 /* TextFeedbackStateIsOn */ { "Feedback state of {0} is now on", "Der Status des Rückmelders {0} ist nun ein", "El estado de la retroseñal {0} está encendida" },
+/* TextFeedbackStatesAreOn */ { "Feedback states of {0} are now on", "Der Status der Rückmelder {0} ist nun ein", "El estado de las retroseñales {0} está encendido" },
 /* TextFeedbackUpdated */ { "Feedback {0} updated", "Rückmelder {0} aktualisiert", "Retroseñal {0} actualizado" },
 /* TextFeedbacks */ { "Feedbacks", "Rückmelder", "Retroseñales" },
 /* TextFoundAccessoryInEcosDatabase */ { "Found accessory in ECoS database: Address: {0} Name: {1}/{2}/{3}", "Zubehörartikel in ECoS Datenbank gefunden: Adresse: {0} Name: {1}/{2}/{3}", "Encontrado un accessorio en la base de datos de ECoS: Dirección: {0} Nombre: {1}/{2}/{3}" },
@@ -199,11 +208,14 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextHitOverrun */ { "{0} hit overrun feedback {1}", "{0} erreichte Überfahr-Rückmelder {1}", "{0} ha pasado a {1}" },
 /* TextHsi88Configured */ { "{0} ({1}/{2}/{3}) S88 modules configured.", "{0} ({1}/{2}/{3}) S88 Module konfiguriert", "{0} ({1}/{2}/{3}) S88 módulos configurado" },
 /* TextHsi88ErrorConfiguring */ { "Unable to configure HSI-88. HSI-88 returned {0} configured modules", "HSI-88 kann nicht konfiguriert werden. HSI-88 meldet {0} module", "Imposible configurar HSI-88. HSI-88 denuncia {0} módulos" },
+/* TextHttpConnectionBadRequest */ { "HTTP connection {0}: 400 Bad request", "HTTP Verbindung {0}: Ungültige Anfrage", "HTTP connectión {0}: solicitud incorrecta" },
 /* TextHttpConnectionClose */ { "HTTP connection {0}: close", "HTTP Verbindung {0}: geschlossen", "HTTP connectión {0}: cerrado" },
 /* TextHttpConnectionNotFound */ { "HTTP connection {0}: 404 Not found: {1}", "HTTP Verbindung {0}: Nicht gefunden: {1}", "HTTP connectión {0}: no encontrado" },
 /* TextHttpConnectionNotImplemented */ { "HTTP connection {0}: HTTP method {1} not implemented", "HTTP Verbindung {0}: Methode {1} nicht implementiert", "HTTP connectión {0}: no implementado" },
 /* TextHttpConnectionOpen */ { "HTTP connection {0}: open", "HTTP Verbindung {0}: geöffnet", "HTTP connectión {0}: abierto" },
 /* TextHttpConnectionRequest */ { "HTTP connection {0}: Request: {1} {2}", "HTTP Verbindung {0}: Anfrage {1} {2}", "HTTP connectión {0}: solicitud: {1} {2}" },
+/* TextHttpConnectionRequestTimeout */ { "HTTP connection {0}: Request not completed in time", "HTTP Verbindung {0}: Anfrage nicht rechtzeitig vollständig", "HTTP connectión {0}: solicitud no completada a tiempo" },
+/* TextHttpConnectionUpdatesOverflow */ { "HTTP connection {0}: Client does not read the updates, closing connection", "HTTP Verbindung {0}: Client liest die Updates nicht, Verbindung wird geschlossen", "HTTP connectión {0}: el cliente no lee las actualizaciones, cerrando conexión" },
 /* TextIPAddress */ { "IP address", "IP Adresse", "Dirección IP" },
 /* TextIndex */ { "Index", "Index", "Index" },
 /* TextInfo */ { "info", "Informationen", "informaciones" },
@@ -248,6 +260,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextLoadedFeedback */ { "Loaded feedback {0}: {1}", "Rückmelder {0} geladen: {1}", "Cargado retroseñal {0}: {1}" },
 /* TextLoadedLayer */ { "Loaded layer {0}: {1}", "Schicht {0} geladen: {1}", "Cargado capa {0}: {1}" },
 /* TextLoadedLoco */ { "Loaded locomotive {0}: {1}", "Lokomotive {0} geladen: {1}", "Cargado locomotora {0}: {1}" },
+/* TextLoadedObjects */ { "{0}: {1} loaded in {2} ms", "{0}: {1} geladen in {2} ms", "{0}: {1} cargados en {2} ms" },
 /* TextLoadedRoute */ { "Loaded route {0}: {1}", "Fahrstrasse {0} geladen: {1}", "Cargado itinerario {0}: {1}" },
 /* TextLoadedSignal */ { "Loaded signal {0}: {1}", "Signal {0} geladen: {1}", "Cargado señal {0}: {1}" },
 /* TextLoadedSwitch */ { "Loaded switch {0}: {1}", "Weiche {0} geladen: {1}", "Cargado desvío {0}: {1}" },
@@ -374,13 +387,18 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextLocoIsReleased */ { "{0} is released", " {0} ist freigegeben", "{0} está desbloqueada" },
 /* TextLocoSaved */ { "Locomotive {0} saved", "Lokomotive {0} gespeichert", "Locomotora {0} guardado" },
 /* TextLocoSpeedIs */ { "Speed of {0} is now {1}", "Die Geschwindigkeit von {0} ist {1}", "La velocidad de {0} está {1}" },
+/* TextLocoStatesProgress */ { "{0} of {1} locomotive states sent to {2}", "{0} von {1} Lokomotiv-Zuständen an {2} gesendet", "{0} de {1} estados de locomotoras enviados a {2}" },
+/* TextLocoStatesSending */ { "Sending states of {0} locomotives to {1}", "Sende Zustände von {0} Lokomotiven an {1}", "Enviando estados de {0} locomotoras a {1}" },
+/* TextLocoStatesSent */ { "States of {0} locomotives sent to {1}", "Zustände von {0} Lokomotiven an {1} gesendet", "Estados de {0} locomotoras enviados a {1}" },
 /* TextLocoUpdated */ { "Locomotive {0} updated", "Lokomotive {0} aktualisiert", "Locomotora {0} actualizado" },
 /* TextLocos */ { "Locomotives", "Lokomotiven", "Locomotoras" },
 /* TextLogLevel */ { "Log level", "Log Level", "Nivel de registro" },
+/* TextLogMessagesDropped */ { "{0} log messages dropped because the log buffer was full", "{0} Log-Meldungen verworfen, weil der Log-Puffer voll war", "{0} mensajes de registro descartados porque el búfer de registro estaba lleno" },
 /* TextLongestUnused */ { "Longest unused", "Am längsten ungenutzt", "El más largo sin usar" },
 /* TextLookingForDestination */ {"Looking for new destination starting from {0}", "Suche von {0} aus neues Ziel", "Buscando nuevo destino deste {0}" },
 /* TextMaerklinMotorola */ { "Märklin Motorola", "Märklin Motorola", "Märklin Motorola" },
 /* TextManager */ { "Manager", "Manager", "Manager" },
+/* TextMaxQueuedCommands */ { "Max. queued", "Max. in Warteschlange", "Máx. en cola" },
 /* TextMaxSpeed */ { "Maximum speed", "Maximale Geschwindigkeit", "Velocidad máxima" },
 /* TextMaxTrainLength */ { "Maximal train length", "Maximale Zuglänge", "Longitud de tren maxima" },
 /* TextMembers */ { "Members", "Teilnehmer", "Miembros" },
@@ -409,6 +427,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextOpeningSQLite */ { "Opening SQLite database with filename {0}", "Öffne SQLite Datenbank mit Dateiname {0}", "Abriendo base de datos SQLite con nombre {0}" },
 /* TextOrientation */ { "Orientation", "Ausrichtung", "Orientaciõn" },
 /* TextOverrunAt */ { "Overrun at", "Überfahrt bei", "Pasar a" },
+/* TextPacketsSent */ { "Packets sent", "Gesendete Pakete", "Paquetes enviados" },
 /* TextParameterFoundInConfigFile */ { "Parameter found in config file: {0} = {1}", "Parameter gefunden in Konfigurationsdate: {0} = {1}", "Parametro encontrado en fila de configuración: {0} = {1}" },
 /* TextPin */ { "Pin", "Anschluss", "Contacto" },
 /* TextPosX */ { "Position X", "Position X", "Posición X" },
@@ -441,11 +460,13 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextPushPullOnly */ { "push-pull trains only", "nur Wendezüge", "solamente push-pull trenes" },
 /* TextPushPullTrain */ { "Push-Pull train", "Wendezug", "Tren push-pull" },
 /* TextQuery */ { "Query: {0} Rows affected {1}", "Abfrage: {0} Geänderte Datensätze: {1}", "Consulta: {0} Líneas afectados: {1}" },
+/* TextQueuedCommands */ { "Queued", "In Warteschlange", "En cola" },
 /* TextRM485ModuleFound */ { "RM485 module {0} found", "RM485 Modul {0} gefunden", "Modulo RM485 {0} encontrado" },
 /* TextRailControlStarted */ { "RailControl started", "RailControl wurde gestartet", "RailControl encendido" },
 /* TextRandom */ { "Random", "Zufall", "Aleatorio" },
 /* TextReachedItsDestination */ { "{0} reached its destination", "{0} erreichte ihr Ziel", "{0} llegó su destino" },
 /* TextRead */ { "read", "lesen", "leer" },
+/* TextReadObjectsAndRelations */ { "Read {0} objects and {1} relations from storage in {2} ms", "{0} Objekte und {1} Beziehungen in {2} ms aus dem Speicher gelesen", "Leídos {0} objetos y {1} relaciones del almacenamiento en {2} ms" },
 /* TextReadingConfigFile */ { "Reading config file {0}", "Lese Konfigurationsdatei {0}", "Leyendo fila de configuración {0}" },
 /* TextReceivedAccessoryCommand */ { "Received command for accessory {0}/{1}: {2}", "Zubehörartikelkommando empfangen {0}/{1}: {2}", "Recibido comando para accesorio {0}/{1}: {2}" },
 /* TextReceivedDirectionCommand */ { "Received direction command for locomotive {0}/{1}: {2}", "Richtungskommando empfangen für Lokomotive {0}/{1}: {2}", "Recibido comando de direccion para locomotora {0}/{1}: {2}" },
@@ -469,6 +490,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextReleaseWhenFree */ { "Release when free", "Freigeben wenn nicht besetzt", "Liberar si no está ocupado" },
 /* TextRemoveBackupFile */ { "Removing backup file {0}", "Lösche Sicherungskopie {0}", "Eliminando copia de respaldo {0}" },
 /* TextRenamingFromTo */ { "Renaming from {0} to {1}", "Benenne von {0} nach {1} um", "Renombrando de {0} a {1}" },
+/* TextRequests */ { "Requests", "Anfragen", "Peticiones" },
 /* TextRestarting */ { "Restarting", "Neustart", "Reiniciando" },
 /* TextRight */ { "right", "rechts", "derecha" },
 /* TextRotation */ { "Rotation", "Drehung", "Rotación", },
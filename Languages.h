@@ -76,6 +76,8 @@ class Languages
 			TextCanNotStartAlreadyRunning,
 			TextCanNotStartInErrorState,
 			TextCanNotStartNotOnTrack,
+			TextCapturedPacketsDropped,
+			TextCapturingPackets,
 			TextCheckSumError,
 			TextClosingSQLite,
 			TextCluster,
@@ -83,7 +85,12 @@ class Languages
 			TextClusterDoesNotExist,
 			TextClusterUpdated,
 			TextClusters,
+			TextCoalescedCommands,
+			TextCommand,
+			TextCommandStatistics,
+			TextConfigFileCrcError,
 			TextConfigFileReceivedWithSize,
+			TextConfigFileUncompressError,
 			TextConfigureControlFirst,
 			TextConnectionFailed,
 			TextConnectionRefused,
@@ -116,9 +123,9 @@ class Languages
 			TextCs2MasterLocoOldName,
 			TextCs2MasterLocoRemove,
 			TextCs2MinorVersionIsNot4,
+			TextDatagramsSent,
 			TextDcc,
-			TextDebounceThreadStarted,
-			TextDebounceThreadTerminated,
+			TextDebounceTime,
 			TextDebouncer,
 			TextDebug,
 			TextDefaultSwitchingDuration,
@@ -161,6 +168,7 @@ class Languages
 			TextEditTracks,
 			TextEnglish,
 			TextError,
+			TextExecutedCommands,
 			TextExecutingRoute,
 			TextExitRailControl,
 			TextFeedback,
@@ -171,6 +179,7 @@ class Languages
 			TextFeedbackSaved,
 			TextFeedbackStateIsOff,
 			TextFeedbackStateIsOn,
+			TextFeedbackStatesAreOn,
 			TextFeedbackUpdated,
 			TextFeedbacks,
 			TextFoundAccessoryInEcosDatabase,
@@ -199,11 +208,14 @@ class Languages
 			TextHitOverrun,
 			TextHsi88Configured,
 			TextHsi88ErrorConfiguring,
+			TextHttpConnectionBadRequest,
 			TextHttpConnectionClose,
 			TextHttpConnectionNotFound,
 			TextHttpConnectionNotImplemented,
 			TextHttpConnectionOpen,
 			TextHttpConnectionRequest,
+			TextHttpConnectionRequestTimeout,
+			TextHttpConnectionUpdatesOverflow,
 			TextIPAddress,
 			TextIndex,
 			TextInfo,
@@ -248,6 +260,7 @@ class Languages
 			TextLoadedFeedback,
 			TextLoadedLayer,
 			TextLoadedLoco,
+			TextLoadedObjects,
 			TextLoadedRoute,
 			TextLoadedSignal,
 			TextLoadedSwitch,
@@ -374,13 +387,18 @@ class Languages
 			TextLocoIsReleased,
 			TextLocoSaved,
 			TextLocoSpeedIs,
+			TextLocoStatesProgress,
+			TextLocoStatesSending,
+			TextLocoStatesSent,
 			TextLocoUpdated,
 			TextLocos,
 			TextLogLevel,
+			TextLogMessagesDropped,
 			TextLongestUnused,
 			TextLookingForDestination,
 			TextMaerklinMotorola,
 			TextManager,
+			TextMaxQueuedCommands,
 			TextMaxSpeed,
 			TextMaxTrainLength,
 			TextMembers,
@@ -409,6 +427,7 @@ class Languages
 			TextOpeningSQLite,
 			TextOrientation,
 			TextOverrunAt,
+			TextPacketsSent,
 			TextParameterFoundInConfigFile,
 			TextPin,
 			TextPosX,
@@ -441,11 +460,13 @@ class Languages
 			TextPushPullOnly,
 			TextPushPullTrain,
 			TextQuery,
+			TextQueuedCommands,
 			TextRM485ModuleFound,
 			TextRailControlStarted,
 			TextRandom,
 			TextReachedItsDestination,
 			TextRead,
+			TextReadObjectsAndRelations,
 			TextReadingConfigFile,
 			TextReceivedAccessoryCommand,
 			TextReceivedDirectionCommand,
@@ -469,6 +490,7 @@ class Languages
 			TextReleaseWhenFree,
 			TextRemoveBackupFile,
 			TextRenamingFromTo,
+			TextRequests,
 			TextRestarting,
 			TextRight,
 			TextRotation,
@@ -0,0 +1,137 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#include <functional>
+
+#include "ControlInterface.h"
+#include "ControlQueue.h"
+#include "DataModel/Loco.h"
+#include "LocoStateSync.h"
+#include "Manager.h"
+#include "Utils/Utils.h"
+
+using std::string;
+using std::vector;
+
+const unsigned int LocoStateSync::ProgressInterval;
+
+LocoStateSync::LocoStateSync(Manager& manager)
+:	manager(manager)
+{
+}
+
+LocoStateSync::~LocoStateSync()
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	while (jobs.empty() == false)
+	{
+		CancelUnlocked(jobs.begin()->first);
+	}
+}
+
+void LocoStateSync::Start(const ControlID controlID, ControlQueue* controlQueue, vector<LocoID>&& locoIDs)
+{
+	if (controlQueue == nullptr || locoIDs.empty())
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> guard(mutex);
+	CancelUnlocked(controlID);
+	Job* job = new Job();
+	jobs[controlID] = job;
+	job->thread = std::thread(&LocoStateSync::Worker, this, job->progress, controlID, controlQueue, std::move(locoIDs));
+}
+
+void LocoStateSync::Cancel(const ControlID controlID)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	CancelUnlocked(controlID);
+}
+
+void LocoStateSync::CancelUnlocked(const ControlID controlID)
+{
+	auto it = jobs.find(controlID);
+	if (it == jobs.end())
+	{
+		return;
+	}
+	Job* job = it->second;
+	jobs.erase(it);
+	job->progress->cancel = true;
+	job->thread.join();
+	delete job;
+}
+
+void LocoStateSync::Worker(const std::shared_ptr<Progress> progress, const ControlID controlID, ControlQueue* controlQueue, const vector<LocoID> locoIDs)
+{
+	Utils::Utils::SetThreadName("LocoStateSync");
+	// give the booster some time to power the track
+	for (unsigned char i = 0; i < 10 && progress->cancel == false; ++i)
+	{
+		Utils::Utils::SleepForMilliseconds(100);
+	}
+	if (progress->cancel)
+	{
+		return;
+	}
+
+	progress->total = locoIDs.size();
+	for (LocoID locoID : locoIDs)
+	{
+		if (progress->cancel)
+		{
+			return;
+		}
+		controlQueue->Enqueue(std::bind(&LocoStateSync::SendLocoState, std::ref(manager), progress, controlID, locoID, std::placeholders::_1));
+	}
+}
+
+void LocoStateSync::SendLocoState(Manager& manager, const std::shared_ptr<Progress> progress, const ControlID controlID, const LocoID locoID, ControlInterface* control)
+{
+	if (progress->cancel)
+	{
+		return;
+	}
+	Logger::Logger* logger = Logger::Logger::GetLogger(Languages::GetText(Languages::TextManager));
+	if (progress->done == 0)
+	{
+		logger->Info(Languages::TextLocoStatesSending, progress->total, control->GetName());
+	}
+	Protocol protocol;
+	Address address;
+	Speed speed;
+	Orientation orientation;
+	vector<DataModel::LocoFunctionEntry> functions;
+	if (manager.LocoState(locoID, controlID, protocol, address, speed, orientation, functions))
+	{
+		control->LocoSpeedOrientationFunctions(protocol, address, speed, orientation, functions);
+		++progress->sent;
+		if (progress->sent % ProgressInterval == 0 && progress->sent < progress->total)
+		{
+			logger->Info(Languages::TextLocoStatesProgress, progress->sent, progress->total, control->GetName());
+		}
+	}
+	++progress->done;
+	if (progress->done == progress->total)
+	{
+		logger->Info(Languages::TextLocoStatesSent, progress->sent, control->GetName());
+	}
+}
@@ -0,0 +1,98 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DataTypes.h"
+
+class ControlInterface;
+class ControlQueue;
+class Manager;
+
+// Sends the speed, orientation and functions of all locos to their command
+// stations, e.g. after the booster has been turned on for the first time.
+// The state of every loco is sent by a command on the ControlQueue of its control,
+// so it is serialized with all other commands of the control and a slow command
+// station does not delay the others. The state is read when the command is executed,
+// so a change queued before is not overwritten by an outdated value.
+class LocoStateSync
+{
+	public:
+		static const unsigned int ProgressInterval = 10;
+
+		LocoStateSync() = delete;
+		LocoStateSync(const LocoStateSync&) = delete;
+		LocoStateSync& operator=(const LocoStateSync&) = delete;
+
+		LocoStateSync(Manager& manager);
+		~LocoStateSync();
+
+		// a running sync of this control is restarted
+		void Start(const ControlID controlID, ControlQueue* controlQueue, std::vector<LocoID>&& locoIDs);
+
+		// stops a running sync of the control, loco states that are still queued are skipped
+		void Cancel(const ControlID controlID);
+
+	private:
+		// shared with the queued commands, which may outlive the job
+		struct Progress
+		{
+			Progress()
+			:	cancel(false),
+				total(0),
+				done(0),
+				sent(0)
+			{}
+
+			std::atomic<bool> cancel;
+			// set before the first command is queued
+			size_t total;
+			// only changed by the thread of the control queue
+			size_t done;
+			size_t sent;
+		};
+
+		struct Job
+		{
+			Job()
+			:	progress(std::make_shared<Progress>())
+			{}
+
+			std::shared_ptr<Progress> progress;
+			std::thread thread;
+		};
+
+		void Worker(const std::shared_ptr<Progress> progress, const ControlID controlID, ControlQueue* controlQueue, const std::vector<LocoID> locoIDs);
+		void CancelUnlocked(const ControlID controlID);
+		static void SendLocoState(Manager& manager, const std::shared_ptr<Progress> progress, const ControlID controlID, const LocoID locoID, ControlInterface* control);
+
+		Manager& manager;
+		std::mutex mutex;
+		std::map<ControlID,Job*> jobs;
+};
@@ -30,11 +30,9 @@ namespace Logger
 {
 	Logger::Level Logger::logLevel = Logger::LevelInfo;
 
-	string Logger::DateTime()
+	string Logger::DateTime(const struct timeval& timestamp)
 	{
 		char buffer[27];
-		struct timeval timestamp;
-		gettimeofday(&timestamp, NULL);
 		struct tm tm;
 		gmtime_r(&timestamp.tv_sec, &tm);
 		strftime(buffer, sizeof(buffer), "%F %T.", &tm);
@@ -83,7 +81,7 @@ namespace Logger
 		}
 	}
 
-	void Logger::Hex(const unsigned char* input, const size_t size)
+	void Logger::HexInternal(const unsigned char* input, const size_t size)
 	{
 		std::stringstream output;
 		size_t index;
@@ -21,6 +21,7 @@ along with RailControl; see the file LICENCE. If not see
 #pragma once
 
 #include <string>
+#include <sys/time.h>
 
 #include "Languages.h"
 #include "Logger/LoggerServer.h"
@@ -145,16 +146,24 @@ namespace Logger
 			}
 
 			void Hex(const std::string& input) { Hex(reinterpret_cast<const unsigned char*>(input.c_str()), input.size()); }
-			void Hex(const unsigned char* input, const size_t size);
+			void Hex(const unsigned char* input, const size_t size)
+			{
+				if (logLevel < LevelDebug)
+				{
+					return;
+				}
+				HexInternal(input, size);
+			}
 
+			static std::string DateTime(const struct timeval& timestamp);
 
 		private:
 			static Level logLevel;
 			LoggerServer& server;
 			const std::string component;
 
+			void HexInternal(const unsigned char* input, const size_t size);
 			static void AsciiPart(std::stringstream& output, const unsigned char* input, const size_t size);
-			static std::string DateTime();
 
 			static void Replace(std::string& workString, const unsigned char argument, const std::string& value);
 			static void Replace(std::string& workString, const unsigned char argument, char* value)
@@ -190,9 +199,10 @@ namespace Logger
 				FormatInternal(workString, argument + 1, args...);
 			}
 
-			template<typename... Args> void Log(const std::string& type, const std::string& text, Args... args)
+			// time stamp and line layout are done by the server, in async mode in its writer thread
+			template<typename... Args> void Log(const char* type, const std::string& text, Args... args)
 			{
-				server.Send(DateTime() + ": " + type + ": " + component + ": " + Format(text, args...) + "\n");
+				server.Log(type, component, Format(text, args...));
 			}
 	};
 }
@@ -18,8 +18,11 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
+#include "Languages.h"
 #include "Logger/Logger.h"
 #include "Logger/LoggerServer.h"
 #include "Utils/Utils.h"
@@ -28,6 +31,10 @@ using std::string;
 
 namespace Logger
 {
+	const size_t LoggerServer::DefaultBufferSize;
+	const size_t LoggerServer::MaxBufferSize;
+	const unsigned int LoggerServer::DefaultFlushIntervalMs;
+
 	LoggerServer::~LoggerServer()
 	{
 		if (run == false)
@@ -37,6 +44,9 @@ namespace Logger
 
 		run = false;
 
+		StopAsync();
+		delete buffer;
+
 		// delete all client memory
 		while (clients.size() > 0)
 		{
@@ -56,6 +66,7 @@ namespace Logger
 
 	Logger* LoggerServer::GetLogger(const std::string& component)
 	{
+		std::lock_guard<std::mutex> guard(loggerMutex);
 		for (auto logger : loggers)
 		{
 			if (logger->IsComponent(component))
@@ -70,9 +81,149 @@ namespace Logger
 
 	void LoggerServer::Send(const std::string& text)
 	{
+		std::lock_guard<std::mutex> guard(clientMutex);
 		for(auto client : clients)
 		{
 			client->Send(text);
 		}
 	}
+
+	void LoggerServer::Log(const char* type, const std::string& component, std::string&& text)
+	{
+		Record record;
+		gettimeofday(&record.timestamp, nullptr);
+		record.type = type;
+		record.component = &component;
+		record.text = std::move(text);
+
+		// the writer does not stop before all producers that have seen async have pushed their record
+		++producers;
+		if (async == false)
+		{
+			--producers;
+			string line;
+			AppendLine(line, record);
+			Send(line);
+			return;
+		}
+
+		if (buffer->Push(std::move(record)) == false)
+		{
+			// the writer thread must never wait for itself
+			if (overflowPolicy == OverflowDrop || std::this_thread::get_id() == writerThread.get_id())
+			{
+				++dropped;
+				--producers;
+				return;
+			}
+			std::unique_lock<std::mutex> lock(spaceMutex);
+			while (buffer->Push(std::move(record)) == false)
+			{
+				writerWakeUp.notify_one();
+				spaceAvailable.wait(lock);
+			}
+		}
+		--producers;
+
+		if (buffer->Fill() >= wakeUpFill)
+		{
+			writerWakeUp.notify_one();
+		}
+	}
+
+	void LoggerServer::StartAsync(const size_t bufferSize, const unsigned int flushIntervalMs, const OverflowPolicy overflowPolicy)
+	{
+		std::lock_guard<std::mutex> guard(writerMutex);
+		if (async == true)
+		{
+			return;
+		}
+		if (buffer == nullptr)
+		{
+			buffer = new Utils::MpmcRingBuffer<Record>(bufferSize == 0 ? DefaultBufferSize : std::min(bufferSize, MaxBufferSize));
+		}
+		this->flushIntervalMs = flushIntervalMs == 0 ? DefaultFlushIntervalMs : flushIntervalMs;
+		this->overflowPolicy = overflowPolicy;
+		wakeUpFill = buffer->Size() / 2;
+		dropped = 0;
+		// producers use writerThread as soon as they see async
+		writerThread = std::thread(&LoggerServer::Writer, this);
+		async = true;
+	}
+
+	void LoggerServer::StopAsync()
+	{
+		{
+			std::lock_guard<std::mutex> guard(writerMutex);
+			if (async == false)
+			{
+				return;
+			}
+			async = false;
+		}
+		writerWakeUp.notify_one();
+		writerThread.join();
+	}
+
+	void LoggerServer::AppendLine(string& output, const Record& record)
+	{
+		output.append(Logger::DateTime(record.timestamp));
+		output.append(": ");
+		output.append(record.type);
+		output.append(": ");
+		output.append(*record.component);
+		output.append(": ");
+		output.append(record.text);
+		output.append("\n");
+	}
+
+	void LoggerServer::WriteBatch(string& batch)
+	{
+		Record record;
+		while (buffer->Pop(record))
+		{
+			AppendLine(batch, record);
+		}
+
+		const unsigned int droppedNow = dropped.exchange(0);
+		if (droppedNow > 0)
+		{
+			record.type = "Warning";
+			gettimeofday(&record.timestamp, nullptr);
+			static const string component("Logger");
+			record.component = &component;
+			record.text = Logger::Format(Languages::GetText(Languages::TextLogMessagesDropped), droppedNow);
+			AppendLine(batch, record);
+		}
+
+		{
+			// a blocked producer waits with spaceMutex held until it sleeps
+			std::lock_guard<std::mutex> guard(spaceMutex);
+		}
+		spaceAvailable.notify_all();
+
+		if (batch.empty())
+		{
+			return;
+		}
+		Send(batch);
+		batch.clear();
+	}
+
+	void LoggerServer::Writer()
+	{
+		Utils::Utils::SetThreadName("Logger");
+		string batch;
+		std::unique_lock<std::mutex> lock(writerMutex);
+		// after async has been reset the writer goes on until the last producer has pushed its record
+		while (async == true || producers > 0)
+		{
+			writerWakeUp.wait_for(lock, std::chrono::milliseconds(async ? flushIntervalMs : 1));
+			lock.unlock();
+			WriteBatch(batch);
+			lock.lock();
+		}
+		lock.unlock();
+		WriteBatch(batch);
+	}
 }
@@ -20,8 +20,13 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <sys/time.h>
+#include <thread>
 #include <vector>
 
 #include "Logger/LoggerClient.h"
@@ -29,6 +34,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Logger/LoggerClientFile.h"
 #include "Logger/LoggerClientTcp.h"
 #include "Network/TcpServer.h"
+#include "Utils/RingBuffer.h"
 
 namespace Logger
 {
@@ -37,12 +43,29 @@ namespace Logger
 	class LoggerServer: private Network::TcpServer
 	{
 		public:
+			enum OverflowPolicy : unsigned char
+			{
+				OverflowBlock = 0,
+				OverflowDrop
+			};
+
+			static const size_t DefaultBufferSize = 4096;
+			static const size_t MaxBufferSize = 1048576;
+			static const unsigned int DefaultFlushIntervalMs = 100;
+
 			LoggerServer(LoggerServer const &) = delete;
 			void operator=(LoggerServer const &) = delete;
 
 			Logger* GetLogger(const std::string& component);
 			void Send(const std::string& text);
 
+			// called by Logger with the already formatted message
+			void Log(const char* type, const std::string& component, std::string&& text);
+
+			// from now on messages are written in batches by a background thread
+			void StartAsync(const size_t bufferSize, const unsigned int flushIntervalMs, const OverflowPolicy overflowPolicy);
+			void StopAsync();
+
 			static const unsigned short defaultLoggerPort = 2223;
 			static LoggerServer& Instance()
 			{
@@ -52,6 +75,7 @@ namespace Logger
 
 			void AddFileLogger(const std::string& fileName)
 			{
+				std::lock_guard<std::mutex> guard(clientMutex);
 				if (fileLoggerStarted == true)
 				{
 					return;
@@ -62,6 +86,7 @@ namespace Logger
 
 			void AddConsoleLogger()
 			{
+				std::lock_guard<std::mutex> guard(clientMutex);
 				if (consoleLoggerStarted == true)
 				{
 					return;
@@ -71,11 +96,26 @@ namespace Logger
 			}
 
 		private:
+			struct Record
+			{
+				struct timeval timestamp;
+				const char* type;
+				const std::string* component;
+				std::string text;
+			};
+
 			LoggerServer()
 			:	Network::TcpServer(defaultLoggerPort, "Logger"),
 			 	run(true),
 			 	fileLoggerStarted(false),
-			 	consoleLoggerStarted(false)
+			 	consoleLoggerStarted(false),
+			 	async(false),
+			 	buffer(nullptr),
+			 	flushIntervalMs(DefaultFlushIntervalMs),
+			 	overflowPolicy(OverflowBlock),
+			 	wakeUpFill(0),
+			 	dropped(0),
+			 	producers(0)
 			{
 			}
 
@@ -83,14 +123,34 @@ namespace Logger
 
 			void Work(Network::TcpConnection* connection) override
 			{
+				std::lock_guard<std::mutex> guard(clientMutex);
 				clients.push_back(new LoggerClientTcp(connection));
 			}
 
+			static void AppendLine(std::string& output, const Record& record);
+			void Writer();
+			void WriteBatch(std::string& batch);
 
 			volatile bool run;
 			bool fileLoggerStarted;
 			bool consoleLoggerStarted;
+			std::mutex clientMutex;
 			std::vector<LoggerClient*> clients;
+			std::mutex loggerMutex;
 			std::vector<Logger*> loggers;
+
+			std::atomic<bool> async;
+			Utils::MpmcRingBuffer<Record>* buffer;
+			unsigned int flushIntervalMs;
+			OverflowPolicy overflowPolicy;
+			size_t wakeUpFill;
+			std::atomic<unsigned int> dropped;
+			// number of producers between the check of async and the end of Push
+			std::atomic<unsigned int> producers;
+			std::mutex writerMutex;
+			std::condition_variable writerWakeUp;
+			std::mutex spaceMutex;
+			std::condition_variable spaceAvailable;
+			std::thread writerThread;
 	};
 }
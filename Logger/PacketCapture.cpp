@@ -0,0 +1,180 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstring>
+
+#include "Languages.h"
+#include "Logger/Logger.h"
+#include "Logger/PacketCapture.h"
+#include "Utils/Utils.h"
+
+using std::string;
+
+namespace Logger
+{
+	const size_t PacketCapture::DefaultBufferSize;
+	const size_t PacketCapture::MaxPacketSize;
+	const unsigned int PacketCapture::FlushIntervalMs;
+	const size_t PacketCapture::PseudoHeaderSize;
+
+	PacketCapture::~PacketCapture()
+	{
+		Stop();
+		delete buffer;
+	}
+
+	bool PacketCapture::Start(const string& fileName, const size_t bufferSize)
+	{
+		std::lock_guard<std::mutex> guard(writerMutex);
+		if (active == true)
+		{
+			return true;
+		}
+		Logger* logger = Logger::GetLogger("PacketCapture");
+		file = fopen(fileName.c_str(), "wb");
+		if (file == nullptr)
+		{
+			logger->Error(Languages::TextUnableToOpenFile, fileName);
+			return false;
+		}
+		WriteFileHeader();
+		if (buffer == nullptr)
+		{
+			buffer = new Utils::MpmcRingBuffer<Packet>(bufferSize == 0 ? DefaultBufferSize : bufferSize);
+		}
+		wakeUpFill = buffer->Size() / 2;
+		dropped = 0;
+		writerThread = std::thread(&PacketCapture::Writer, this);
+		active = true;
+		logger->Info(Languages::TextCapturingPackets, fileName);
+		return true;
+	}
+
+	void PacketCapture::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> guard(writerMutex);
+			if (active == false)
+			{
+				return;
+			}
+			active = false;
+		}
+		writerWakeUp.notify_one();
+		writerThread.join();
+		fclose(file);
+		file = nullptr;
+		// buffer is kept, a hardware thread may still be inside Add
+	}
+
+	void PacketCapture::Add(const Source source, const Direction direction, const ControlID controlID, const unsigned char* data, const size_t size)
+	{
+		Packet packet;
+		gettimeofday(&packet.timestamp, nullptr);
+		packet.source = source;
+		packet.direction = direction;
+		packet.controlID = controlID;
+		packet.size = size;
+		memcpy(packet.data, data, size < MaxPacketSize ? size : MaxPacketSize);
+
+		if (buffer->Push(std::move(packet)) == false)
+		{
+			++dropped;
+			return;
+		}
+
+		if (buffer->Fill() >= wakeUpFill)
+		{
+			writerWakeUp.notify_one();
+		}
+	}
+
+	void PacketCapture::WriteFileHeader()
+	{
+		// pcap header in host byte order, readers detect it from the magic number
+		const uint32_t magic = 0xA1B2C3D4;
+		const uint16_t versionMajor = 2;
+		const uint16_t versionMinor = 4;
+		const int32_t timeZone = 0;
+		const uint32_t significantFigures = 0;
+		const uint32_t snapLength = MaxPacketSize + PseudoHeaderSize;
+		const uint32_t linkTypeUser0 = 147;
+		fwrite(&magic, sizeof(magic), 1, file);
+		fwrite(&versionMajor, sizeof(versionMajor), 1, file);
+		fwrite(&versionMinor, sizeof(versionMinor), 1, file);
+		fwrite(&timeZone, sizeof(timeZone), 1, file);
+		fwrite(&significantFigures, sizeof(significantFigures), 1, file);
+		fwrite(&snapLength, sizeof(snapLength), 1, file);
+		fwrite(&linkTypeUser0, sizeof(linkTypeUser0), 1, file);
+	}
+
+	void PacketCapture::WritePacket(const Packet& packet)
+	{
+		const size_t captured = packet.size < MaxPacketSize ? packet.size : MaxPacketSize;
+		const uint32_t recordHeader[4] =
+		{
+			static_cast<uint32_t>(packet.timestamp.tv_sec),
+			static_cast<uint32_t>(packet.timestamp.tv_usec),
+			static_cast<uint32_t>(captured + PseudoHeaderSize),
+			static_cast<uint32_t>(packet.size + PseudoHeaderSize)
+		};
+		const unsigned char pseudoHeader[PseudoHeaderSize] = { packet.source, packet.direction, packet.controlID, 0 };
+		fwrite(recordHeader, sizeof(recordHeader), 1, file);
+		fwrite(pseudoHeader, sizeof(pseudoHeader), 1, file);
+		fwrite(packet.data, captured, 1, file);
+	}
+
+	void PacketCapture::WriteBatch()
+	{
+		Packet packet;
+		bool written = false;
+		while (buffer->Pop(packet))
+		{
+			WritePacket(packet);
+			written = true;
+		}
+		if (written)
+		{
+			fflush(file);
+		}
+
+		const unsigned int droppedNow = dropped.exchange(0);
+		if (droppedNow > 0)
+		{
+			Logger::GetLogger("PacketCapture")->Warning(Languages::TextCapturedPacketsDropped, droppedNow);
+		}
+	}
+
+	void PacketCapture::Writer()
+	{
+		Utils::Utils::SetThreadName("PacketCapture");
+		std::unique_lock<std::mutex> lock(writerMutex);
+		while (active == true)
+		{
+			writerWakeUp.wait_for(lock, std::chrono::milliseconds(FlushIntervalMs));
+			lock.unlock();
+			WriteBatch();
+			lock.lock();
+		}
+		lock.unlock();
+		WriteBatch();
+	}
+}
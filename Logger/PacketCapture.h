@@ -0,0 +1,132 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <sys/time.h>
+#include <thread>
+
+#include "DataTypes.h"
+#include "Utils/RingBuffer.h"
+
+namespace Logger
+{
+	// Records the raw frames exchanged with the hardware into a pcap file
+	// (link type USER0) for offline analysis.
+	// The hardware threads only copy a frame into a lock free ring buffer,
+	// a background thread writes the file. If the buffer is full the frame is
+	// dropped, so capturing never blocks a hardware thread.
+	// Every record starts with a pseudo header of 4 bytes: source, direction, control ID and 0.
+	class PacketCapture
+	{
+		public:
+			enum Source : unsigned char
+			{
+				SourceCan = 1,
+				SourceZ21,
+				SourceSerial
+			};
+
+			enum Direction : unsigned char
+			{
+				DirectionReceived = 0,
+				DirectionSent
+			};
+
+			static const size_t DefaultBufferSize = 1024;
+			static const size_t MaxPacketSize = 256;
+
+			PacketCapture(const PacketCapture&) = delete;
+			PacketCapture& operator=(const PacketCapture&) = delete;
+
+			static PacketCapture& Instance()
+			{
+				static PacketCapture capture;
+				return capture;
+			}
+
+			static inline void Received(const Source source, const ControlID controlID, const unsigned char* data, const size_t size)
+			{
+				Instance().Capture(source, DirectionReceived, controlID, data, size);
+			}
+
+			static inline void Sent(const Source source, const ControlID controlID, const unsigned char* data, const size_t size)
+			{
+				Instance().Capture(source, DirectionSent, controlID, data, size);
+			}
+
+			bool Start(const std::string& fileName, const size_t bufferSize);
+			void Stop();
+
+			inline void Capture(const Source source, const Direction direction, const ControlID controlID, const unsigned char* data, const size_t size)
+			{
+				if (active.load(std::memory_order_relaxed) == false)
+				{
+					return;
+				}
+				Add(source, direction, controlID, data, size);
+			}
+
+		private:
+			static const unsigned int FlushIntervalMs = 100;
+			static const size_t PseudoHeaderSize = 4;
+
+			struct Packet
+			{
+				struct timeval timestamp;
+				Source source;
+				Direction direction;
+				ControlID controlID;
+				size_t size;
+				unsigned char data[MaxPacketSize];
+			};
+
+			PacketCapture()
+			:	active(false),
+				buffer(nullptr),
+				file(nullptr),
+				wakeUpFill(0),
+				dropped(0)
+			{}
+
+			~PacketCapture();
+
+			void Add(const Source source, const Direction direction, const ControlID controlID, const unsigned char* data, const size_t size);
+			void WriteFileHeader();
+			void WritePacket(const Packet& packet);
+			void WriteBatch();
+			void Writer();
+
+			std::atomic<bool> active;
+			Utils::MpmcRingBuffer<Packet>* buffer;
+			FILE* file;
+			size_t wakeUpFill;
+			std::atomic<unsigned int> dropped;
+			std::mutex writerMutex;
+			std::condition_variable writerWakeUp;
+			std::thread writerThread;
+	};
+}
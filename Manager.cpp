@@ -18,15 +18,19 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <future>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <unistd.h>
 
+#include "AutoModeScheduler.h"
 #include "DataModel/LayoutItem.h"
+#include "FeedbackDebouncer.h"
 #include "Languages.h"
+#include "Hardware/AccessoryPulseTimer.h"
 #include "Hardware/HardwareHandler.h"
 #include "Hardware/HardwareParams.h"
+#include "LocoStateSync.h"
 #include "Manager.h"
 #include "RailControl.h"
 #include "Utils/Utils.h"
@@ -50,13 +54,16 @@ Manager::Manager(Config& config)
 :	logger(Logger::Logger::GetLogger(Languages::GetText(Languages::TextManager))),
  	boosterState(BoosterStateStop),
 	storage(nullptr),
+	autoModeScheduler(new AutoModeScheduler(config.getValue("automodethreads", AutoModeScheduler::DefaultNrOfWorkers))),
+	accessoryPulseTimer(new Hardware::AccessoryPulseTimer()),
+	feedbackDebouncer(new FeedbackDebouncer()),
+	locoStateSync(new LocoStateSync(*this)),
 	defaultAccessoryDuration(DataModel::DefaultAccessoryPulseDuration),
 	autoAddFeedback(false),
 	stopOnFeedbackInFreeTrack(true),
 	selectRouteApproach(DataModel::SelectRouteRandom),
 	nrOfTracksToReserve(DataModel::Loco::ReserveOne),
 	run(false),
-	debounceRun(false),
 	initLocosDone(false),
 	unknownControl(Languages::GetText(Languages::TextControlDoesNotExist)),
 	unknownLoco(Languages::GetText(Languages::TextLocoDoesNotExist)),
@@ -71,6 +78,7 @@ Manager::Manager(Config& config)
 	storageParams.module = "Sqlite";
 	storageParams.filename = config.getValue("dbfilename", "railcontrol.sqlite");
 	storageParams.keepBackups = config.getValue("dbkeepbackups", 10);
+	storageParams.flushInterval = config.getValue("dbflushinterval", 500);
 	storage = new StorageHandler(this, &storageParams);
 	if (storage == nullptr)
 	{
@@ -86,16 +94,28 @@ Manager::Manager(Config& config)
 	selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(Utils::Utils::StringToInteger(storage->GetSetting("SelectRouteApproach")));
 	nrOfTracksToReserve = static_cast<DataModel::Loco::NrOfTracksToReserve>(Utils::Utils::StringToInteger(storage->GetSetting("NrOfTracksToReserve"), 2));
 
-	controls[ControlIdWebserver] = new WebServer::WebServer(*this, config.getValue("webserverport", 8080));
+	for (unsigned char hardwareType = HardwareTypeNone; hardwareType < HardwareTypeNumbers; ++hardwareType)
+	{
+		string key = "locospeedinterval_" + HardwareHandler::GetHardwareSymbol(static_cast<HardwareType>(hardwareType));
+		std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+		locoSpeedIntervals[hardwareType] = config.getValue(key, 0);
+	}
+
+	AddControlUnlocked(ControlIdWebserver, new WebServer::WebServer(*this,
+		config.getValue("webserverport", 8080),
+		config.getValue("webserverupdates", WebServer::WebServer::DefaultMaxUpdates),
+		config.getValue("webserveriothreads", WebServer::WebServer::DefaultNrOfIoThreads)), HardwareTypeNone);
 
 	storage->AllHardwareParams(hardwareParams);
 	for (auto hardwareParam : hardwareParams)
 	{
 		hardwareParam.second->SetManager(this);
-		controls[hardwareParam.second->GetControlID()] = new HardwareHandler(*this, hardwareParam.second);
+		AddControlUnlocked(hardwareParam.second->GetControlID(), new HardwareHandler(*this, hardwareParam.second), hardwareParam.second->GetHardwareType());
 		logger->Info(Languages::TextLoadedControl, hardwareParam.first, hardwareParam.second->GetName());
 	}
 
+	storage->BulkLoad();
+
 	storage->AllLayers(layers);
 	for (auto layer : layers)
 	{
@@ -122,12 +142,14 @@ Manager::Manager(Config& config)
 		{
 			accessory.second->SetProtocol(ProtocolMM);
 		}
+		AddToAddressIndex(accessoriesByAddress, accessory.second);
 		logger->Info(Languages::TextLoadedAccessory, accessory.second->GetID(), accessory.second->GetName());
 	}
 
 	storage->AllFeedbacks(feedbacks);
 	for (auto feedback : feedbacks)
 	{
+		feedbacksByPin.Insert(FeedbackPinKey(feedback.second->GetControlID(), feedback.second->GetPin()), feedback.second);
 		logger->Info(Languages::TextLoadedFeedback, feedback.second->GetID(), feedback.second->GetName());
 	}
 
@@ -148,6 +170,7 @@ Manager::Manager(Config& config)
 		{
 			mySwitch.second->SetProtocol(ProtocolMM);
 		}
+		AddToAddressIndex(switchesByAddress, mySwitch.second);
 		logger->Info(Languages::TextLoadedSwitch, mySwitch.second->GetID(), mySwitch.second->GetName());
 	}
 
@@ -162,6 +185,7 @@ Manager::Manager(Config& config)
 		{
 			signal.second->SetProtocol(ProtocolMM);
 		}
+		AddToAddressIndex(signalsByAddress, signal.second);
 		logger->Info(Languages::TextLoadedSignal, signal.second->GetID(), signal.second->GetName());
 	}
 
@@ -188,12 +212,13 @@ Manager::Manager(Config& config)
 		{
 			loco.second->SetProtocol(ProtocolMM);
 		}
+		AddToAddressIndex(locosByAddress, loco.second);
 		logger->Info(Languages::TextLoadedLoco, loco.second->GetID(), loco.second->GetName());
 	}
 
+	storage->FinishBulkLoad();
+
 	run = true;
-	debounceRun = true;
-	debounceThread = std::thread(&Manager::DebounceWorker, this);
 	InitLocos();
 }
 
@@ -204,14 +229,18 @@ Manager::~Manager()
 		Utils::Utils::SleepForSeconds(1);
 	}
 
-	debounceRun = false;
-	debounceThread.join();
-
 	Booster(ControlTypeInternal, BoosterStateStop);
 
 	run = false;
+	delete locoStateSync;
+	locoStateSync = nullptr;
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
+		for (auto controlQueue : controlQueues)
+		{
+			delete controlQueue.second;
+		}
+		controlQueues.clear();
 		for (auto control : controls)
 		{
 			ControlID controlID = control.first;
@@ -241,11 +270,24 @@ Manager::~Manager()
 		}
 	}
 
+	// the controls report feedbacks until they are deleted, the feedbacks are deleted below
+	delete feedbackDebouncer;
+	feedbackDebouncer = nullptr;
+
+	delete accessoryPulseTimer;
+	accessoryPulseTimer = nullptr;
+
 	if (storage != nullptr)
 	{
 		storage->StartTransaction();
 	}
 
+	locosByAddress.Clear();
+	accessoriesByAddress.Clear();
+	feedbacksByPin.Clear();
+	switchesByAddress.Clear();
+	signalsByAddress.Clear();
+
 	DeleteAllMapEntries(locos, locoMutex);
 	DeleteAllMapEntries(clusters, clusterMutex);
 	DeleteAllMapEntries(routes, routeMutex);
@@ -256,6 +298,9 @@ Manager::~Manager()
 	DeleteAllMapEntries(tracks, trackMutex);
 	DeleteAllMapEntries(layers, layerMutex);
 
+	delete autoModeScheduler;
+	autoModeScheduler = nullptr;
+
 	if (storage == nullptr)
 	{
 		return;
@@ -277,36 +322,38 @@ void Manager::Booster(const ControlType controlType, const BoosterState state)
 		return;
 	}
 	boosterState = state;
-	{
-		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto control : controls)
-		{
-			control.second->Booster(controlType, state);
-		}
-	}
+	PublishToControls(&ControlInterface::Booster, controlType, state);
 
 	if (boosterState != BoosterStateGo || initLocosDone == true)
 	{
 		return;
 	}
 
-	std::async(std::launch::async, InitLocosStatic, this);
 	initLocosDone = true;
+	InitLocos();
 }
 
 void Manager::InitLocos()
 {
-	Utils::Utils::SleepForSeconds(1);
-	std::lock_guard<std::mutex> guard(locoMutex);
-	for (auto loco : locos)
+	std::map<ControlID,std::vector<LocoID>> locosOfControl;
 	{
-		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto control : controls)
+		std::lock_guard<std::mutex> guard(locoMutex);
+		for (auto loco : locos)
 		{
-			std::vector<DataModel::LocoFunctionEntry> functions = loco.second->GetFunctionStates();
-			control.second->LocoSpeedOrientationFunctions(loco.second, loco.second->GetSpeed(), loco.second->GetOrientation(), functions);
+			locosOfControl[loco.second->GetControlID()].push_back(loco.first);
 		}
 	}
+
+	std::lock_guard<std::mutex> guard(controlMutex);
+	for (auto& locoIDs : locosOfControl)
+	{
+		auto controlQueue = controlQueues.find(locoIDs.first);
+		if (controlQueue == controlQueues.end())
+		{
+			continue;
+		}
+		locoStateSync->Start(locoIDs.first, controlQueue->second, std::move(locoIDs.second));
+	}
 }
 
 /***************************
@@ -364,7 +411,7 @@ bool Manager::ControlSave(const ControlID& controlID,
 		{
 			return false;
 		}
-		controls[params->GetControlID()] = control;
+		AddControlUnlocked(params->GetControlID(), control, hardwareType);
 		return true;
 	}
 
@@ -374,7 +421,16 @@ bool Manager::ControlSave(const ControlID& controlID,
 		return false;
 	}
 
+	locoStateSync->Cancel(controlID);
 	control->ReInit(params);
+	{
+		std::lock_guard<std::mutex> guard(controlMutex);
+		auto controlQueue = controlQueues.find(controlID);
+		if (controlQueue != controlQueues.end())
+		{
+			controlQueue->second->SetLocoSpeedInterval(locoSpeedIntervals[hardwareType]);
+		}
+	}
 	return true;
 }
 
@@ -395,6 +451,7 @@ bool Manager::ControlDelete(ControlID controlID)
 		hardwareParams.erase(controlID);
 		delete params;
 	}
+	locoStateSync->Cancel(controlID);
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
 		if (controls.count(controlID) != 1)
@@ -407,6 +464,8 @@ bool Manager::ControlDelete(ControlID controlID)
 			return false;
 		}
 		controls.erase(controlID);
+		delete controlQueues.at(controlID);
+		controlQueues.erase(controlID);
 		delete control;
 	}
 
@@ -417,6 +476,49 @@ bool Manager::ControlDelete(ControlID controlID)
 	return true;
 }
 
+void Manager::AddControlUnlocked(const ControlID controlID, ControlInterface* control, const HardwareType hardwareType)
+{
+	controls[controlID] = control;
+	controlQueues[controlID] = new ControlQueue(controlID, control, locoSpeedIntervals[hardwareType]);
+}
+
+void Manager::FlushControls()
+{
+	std::lock_guard<std::mutex> guard(controlMutex);
+	for (auto controlQueue : controlQueues)
+	{
+		controlQueue.second->Flush();
+	}
+}
+
+const std::map<ControlID,ControlQueue::Statistics> Manager::ControlQueueStatistics() const
+{
+	std::map<ControlID,ControlQueue::Statistics> ret;
+	std::lock_guard<std::mutex> guard(controlMutex);
+	for (auto controlQueue : controlQueues)
+	{
+		ret[controlQueue.first] = controlQueue.second->GetStatistics();
+	}
+	return ret;
+}
+
+const std::map<ControlID,std::map<Languages::TextSelector,uint64_t>> Manager::ControlStatistics() const
+{
+	std::map<ControlID,std::map<Languages::TextSelector,uint64_t>> ret;
+	std::lock_guard<std::mutex> guard(controlMutex);
+	for (auto control : controls)
+	{
+		std::map<Languages::TextSelector,uint64_t> statistics;
+		control.second->GetStatistics(statistics);
+		if (statistics.empty())
+		{
+			continue;
+		}
+		ret[control.first] = std::move(statistics);
+	}
+	return ret;
+}
+
 HardwareParams* Manager::GetHardware(const ControlID controlID)
 {
 	std::lock_guard<std::mutex> guard(hardwareMutex);
@@ -644,19 +746,32 @@ DataModel::Loco* Manager::GetLoco(const LocoID locoID) const
 	return locos.at(locoID);
 }
 
-Loco* Manager::GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const
+bool Manager::LocoState(const LocoID locoID,
+	const ControlID controlID,
+	Protocol& protocol,
+	Address& address,
+	Speed& speed,
+	Orientation& orientation,
+	std::vector<DataModel::LocoFunctionEntry>& functions) const
 {
 	std::lock_guard<std::mutex> guard(locoMutex);
-	for (auto loco : locos)
+	auto it = locos.find(locoID);
+	if (it == locos.end() || it->second->GetControlID() != controlID)
 	{
-		if (loco.second->GetControlID() == controlID
-			&& loco.second->GetProtocol() == protocol
-			&& loco.second->GetAddress() == address)
-		{
-			return loco.second;
-		}
+		return false;
 	}
-	return nullptr;
+	const Loco* loco = it->second;
+	protocol = loco->GetProtocol();
+	address = loco->GetAddress();
+	speed = loco->GetSpeed();
+	orientation = loco->GetOrientation();
+	functions = loco->GetFunctionStates();
+	return true;
+}
+
+Loco* Manager::GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const
+{
+	return locosByAddress.Get(HardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetLocoName(const LocoID locoID) const
@@ -727,9 +842,11 @@ bool Manager::LocoSave(const LocoID locoID,
 	}
 
 	loco->SetName(CheckObjectName(locos, locoMutex, locoID, name.size() == 0 ? "L" : name));
+	RemoveFromAddressIndex(locosByAddress, loco);
 	loco->SetControlID(controlID);
 	loco->SetProtocol(protocol);
 	loco->SetAddress(address);
+	AddToAddressIndex(locosByAddress, loco);
 	loco->SetLength(length);
 	loco->SetPushpull(pushpull);
 	loco->SetMaxSpeed(maxSpeed);
@@ -745,11 +862,7 @@ bool Manager::LocoSave(const LocoID locoID,
 		storage->Save(*loco);
 	}
 	const LocoID locoIdSave = loco->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoSettings(locoIdSave, name);
-	}
+	PublishToControls(&ControlInterface::LocoSettings, locoIdSave, name);
 	return true;
 }
 
@@ -778,6 +891,7 @@ bool Manager::LocoDelete(const LocoID locoID, string& result)
 		}
 
 		locos.erase(locoID);
+		RemoveFromAddressIndex(locosByAddress, loco);
 	}
 
 	if (storage)
@@ -785,11 +899,8 @@ bool Manager::LocoDelete(const LocoID locoID, string& result)
 		storage->DeleteLoco(locoID);
 	}
 	const string& name = loco->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoDelete(locoID, name);
-	}
+	PublishToControls(&ControlInterface::LocoDelete, locoID, name);
+	FlushControls();
 	delete loco;
 	return true;
 }
@@ -846,9 +957,9 @@ bool Manager::LocoSpeed(const ControlType controlType, Loco* loco, const Speed s
 	logger->Info(Languages::TextLocoSpeedIs, locoName, s);
 	loco->SetSpeed(s, withSlaves);
 	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
+	for (auto controlQueue : controlQueues)
 	{
-		control.second->LocoSpeed(controlType, loco, s);
+		controlQueue.second->EnqueueLocoSpeed(controlType, loco, s);
 	}
 	return true;
 }
@@ -887,11 +998,7 @@ void Manager::LocoOrientation(const ControlType controlType, Loco* loco, const O
 	}
 	loco->SetOrientation(orientation);
 	logger->Info(orientation ? Languages::TextLocoDirectionOfTravelIsRight : Languages::TextLocoDirectionOfTravelIsLeft, loco->GetName());
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoOrientation(controlType, loco, orientation);
-	}
+	PublishToControls(&ControlInterface::LocoOrientation, controlType, loco, orientation);
 }
 
 void Manager::LocoFunctionState(const ControlType controlType,
@@ -930,11 +1037,7 @@ void Manager::LocoFunctionState(const ControlType controlType,
 
 	loco->SetFunctionState(function, on);
 	logger->Info(on ? Languages::TextLocoFunctionIsOn : Languages::TextLocoFunctionIsOff, loco->GetName(), function);
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoFunction(controlType, loco, function, on);
-	}
+	PublishToControls(&ControlInterface::LocoFunction, controlType, loco, function, on);
 }
 
 /***************************
@@ -991,11 +1094,7 @@ void Manager::AccessoryState(const ControlType controlType, Accessory* accessory
 
 	accessory->SetAccessoryState(state);
 
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->AccessoryState(controlType, accessory);
-	}
+	PublishToControls(&ControlInterface::AccessoryState, controlType, accessory);
 }
 
 Accessory* Manager::GetAccessory(const AccessoryID accessoryID) const
@@ -1010,17 +1109,7 @@ Accessory* Manager::GetAccessory(const AccessoryID accessoryID) const
 
 Accessory* Manager::GetAccessory(const ControlID controlID, const Protocol protocol, const Address address) const
 {
-	std::lock_guard<std::mutex> guard(accessoryMutex);
-	for (auto accessory : accessories)
-	{
-		if (accessory.second->GetControlID() == controlID
-			&& accessory.second->GetProtocol() == protocol
-			&& accessory.second->GetAddress() == address)
-		{
-			return accessory.second;
-		}
-	}
-	return nullptr;
+	return accessoriesByAddress.Get(HardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetAccessoryName(const AccessoryID accessoryID) const
@@ -1076,9 +1165,11 @@ bool Manager::AccessorySave(const AccessoryID accessoryID, const string& name, c
 	accessory->SetPosX(posX);
 	accessory->SetPosY(posY);
 	accessory->SetPosZ(posZ);
+	RemoveFromAddressIndex(accessoriesByAddress, accessory);
 	accessory->SetControlID(controlID);
 	accessory->SetProtocol(protocol);
 	accessory->SetAddress(address);
+	AddToAddressIndex(accessoriesByAddress, accessory);
 	accessory->SetType(type);
 	accessory->SetAccessoryPulseDuration(duration);
 	accessory->SetInverted(inverted);
@@ -1089,11 +1180,7 @@ bool Manager::AccessorySave(const AccessoryID accessoryID, const string& name, c
 		storage->Save(*accessory);
 	}
 	AccessoryID accessoryIdSave = accessory->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->AccessorySettings(accessoryIdSave, name);
-	}
+	PublishToControls(&ControlInterface::AccessorySettings, accessoryIdSave, name);
 	return true;
 }
 
@@ -1134,17 +1221,15 @@ bool Manager::AccessoryDelete(const AccessoryID accessoryID,
 		}
 
 		accessories.erase(accessoryID);
+		RemoveFromAddressIndex(accessoriesByAddress, accessory);
 	}
 
 	if (storage)
 	{
 		storage->DeleteAccessory(accessoryID);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->AccessoryDelete(accessoryID, accessory->GetName());
-	}
+	PublishToControls(&ControlInterface::AccessoryDelete, accessoryID, accessory->GetName());
+	FlushControls();
 	delete accessory;
 	return true;
 }
@@ -1182,7 +1267,7 @@ void Manager::FeedbackState(const ControlID controlID, const FeedbackPin pin, co
 	logger->Info(Languages::TextAddingFeedback, name);
 	string result;
 
-	FeedbackSave(FeedbackNone, name, DataModel::LayoutItem::VisibleNo, 0, 0, 0, controlID, pin, false, result);
+	FeedbackSave(FeedbackNone, name, DataModel::LayoutItem::VisibleNo, 0, 0, 0, controlID, pin, false, DataModel::DefaultFeedbackDebounceTime, result);
 }
 
 void Manager::FeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state)
@@ -1195,6 +1280,76 @@ void Manager::FeedbackState(const FeedbackID feedbackID, const DataModel::Feedba
 	FeedbackState(feedback, state);
 }
 
+void Manager::FeedbackStates(const ControlID controlID,
+	const FeedbackPin firstPin,
+	const unsigned char* oldStates,
+	const unsigned char* newStates,
+	const size_t nrOfBytes,
+	const DataModel::Feedback::FeedbackBitOrder bitOrder)
+{
+	std::vector<FeedbackPin> pins;
+	std::vector<uint64_t> keys;
+	std::vector<DataModel::Feedback::FeedbackState> states;
+	for (size_t byte = 0; byte < nrOfBytes; ++byte)
+	{
+		const unsigned char diff = oldStates[byte] ^ newStates[byte];
+		if (diff == 0)
+		{
+			continue;
+		}
+		for (unsigned char bit = 0; bit < 8; ++bit)
+		{
+			const unsigned char shift = (bitOrder == DataModel::Feedback::FeedbackBitOrderMsbFirst ? 7 - bit : bit);
+			if (((diff >> shift) & 0x01) == 0)
+			{
+				continue;
+			}
+			const FeedbackPin pin = firstPin + (byte << 3) + bit;
+			pins.push_back(pin);
+			keys.push_back(FeedbackPinKey(controlID, pin));
+			states.push_back(static_cast<DataModel::Feedback::FeedbackState>((newStates[byte] >> shift) & 0x01));
+		}
+	}
+	if (keys.empty())
+	{
+		return;
+	}
+
+	std::vector<Feedback*> found;
+	feedbacksByPin.Get(keys, found);
+
+	std::vector<Feedback*> occupied;
+	std::vector<DataModel::Feedback::StateChange> changes;
+	for (size_t i = 0; i < found.size(); ++i)
+	{
+		Feedback* feedback = found[i];
+		if (feedback == nullptr)
+		{
+			// auto adding is rare and takes the slow path
+			FeedbackState(controlID, pins[i], states[i]);
+			continue;
+		}
+		if (feedback->SetStateUnpublished(states[i]) == false)
+		{
+			continue;
+		}
+		const string& feedbackName = feedback->GetName();
+		logger->Info(Languages::TextFeedbackStateIsOn, feedbackName);
+		occupied.push_back(feedback);
+		changes.push_back({ feedback->GetID(), feedbackName, DataModel::Feedback::FeedbackStateOccupied });
+	}
+	if (changes.empty())
+	{
+		return;
+	}
+
+	PublishToControls(&ControlInterface::FeedbackStates, changes);
+	for (auto feedback : occupied)
+	{
+		feedback->UpdateTrackState(DataModel::Feedback::FeedbackStateOccupied);
+	}
+}
+
 void Manager::FeedbackPublishState(const Feedback* feedback)
 {
 	if (feedback == nullptr)
@@ -1205,13 +1360,12 @@ void Manager::FeedbackPublishState(const Feedback* feedback)
 	const string& feedbackName = feedback->GetName();
 	logger->Info(state ? Languages::TextFeedbackStateIsOn : Languages::TextFeedbackStateIsOff, feedbackName);
 	const FeedbackID feedbackID = feedback->GetID();
-	{
-		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto control : controls)
-		{
-			control.second->FeedbackState(feedbackName, feedbackID, state);
-		}
-	}
+	PublishToControls(&ControlInterface::FeedbackState, feedbackName, feedbackID, state);
+}
+
+void Manager::FeedbackDebounce(Feedback* feedback, const unsigned int generation)
+{
+	feedbackDebouncer->Schedule(feedback, feedback->GetDebounceTime(), generation);
 }
 
 Feedback* Manager::GetFeedback(const FeedbackID feedbackID) const
@@ -1231,16 +1385,7 @@ Feedback* Manager::GetFeedbackUnlocked(const FeedbackID feedbackID) const
 
 Feedback* Manager::GetFeedback(const ControlID controlID, const FeedbackPin pin) const
 {
-	std::lock_guard<std::mutex> guard(feedbackMutex);
-	for (auto feedback : feedbacks)
-	{
-		if (feedback.second->GetControlID() == controlID
-			&& feedback.second->GetPin() == pin)
-		{
-			return feedback.second;
-		}
-	}
-	return nullptr;
+	return feedbacksByPin.Get(FeedbackPinKey(controlID, pin));
 }
 
 const std::string& Manager::GetFeedbackName(const FeedbackID feedbackID) const
@@ -1272,7 +1417,7 @@ bool Manager::CheckFeedbackPosition(const Feedback* feedback, const LayoutPositi
 	return CheckPositionFree(posX, posY, posZ, DataModel::LayoutItem::Width1, DataModel::LayoutItem::Height1, DataModel::LayoutItem::Rotation0, result);
 }
 
-FeedbackID Manager::FeedbackSave(const FeedbackID feedbackID, const std::string& name, const Visible visible, const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted, string& result)
+FeedbackID Manager::FeedbackSave(const FeedbackID feedbackID, const std::string& name, const Visible visible, const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted, const DataModel::FeedbackDebounceTime debounceTime, string& result)
 {
 	Feedback* feedback = GetFeedback(feedbackID);
 	if (visible && !CheckFeedbackPosition(feedback, posX, posY, posZ, result))
@@ -1296,9 +1441,12 @@ FeedbackID Manager::FeedbackSave(const FeedbackID feedbackID, const std::string&
 	feedback->SetPosX(posX);
 	feedback->SetPosY(posY);
 	feedback->SetPosZ(posZ);
+	feedbacksByPin.Erase(FeedbackPinKey(feedback->GetControlID(), feedback->GetPin()), feedback);
 	feedback->SetControlID(controlID);
 	feedback->SetPin(pin);
+	feedbacksByPin.Insert(FeedbackPinKey(controlID, pin), feedback);
 	feedback->SetInverted(inverted);
+	feedback->SetDebounceTime(debounceTime);
 
 	// save in db
 	if (storage)
@@ -1306,11 +1454,7 @@ FeedbackID Manager::FeedbackSave(const FeedbackID feedbackID, const std::string&
 		storage->Save(*feedback);
 	}
 	FeedbackID feedbackIdSave = feedback->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->FeedbackSettings(feedbackIdSave, name);
-	}
+	PublishToControls(&ControlInterface::FeedbackSettings, feedbackIdSave, name);
 	return feedbackIdSave;
 }
 
@@ -1367,6 +1511,7 @@ bool Manager::FeedbackDelete(const FeedbackID feedbackID,
 		}
 
 		feedbacks.erase(feedbackID);
+		feedbacksByPin.Erase(FeedbackPinKey(feedback->GetControlID(), feedback->GetPin()), feedback);
 	}
 
 	if (storage)
@@ -1374,11 +1519,10 @@ bool Manager::FeedbackDelete(const FeedbackID feedbackID,
 		storage->DeleteFeedback(feedbackID);
 	}
 	const string& name = feedback->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->FeedbackDelete(feedbackID, name);
-	}
+	PublishToControls(&ControlInterface::FeedbackDelete, feedbackID, name);
+	FlushControls();
+	feedback->StopDebounce();
+	feedbackDebouncer->Cancel(feedback);
 	delete feedback;
 	return true;
 }
@@ -1612,12 +1756,8 @@ TrackID Manager::TrackSave(const TrackID trackID,
 	{
 		storage->Save(*track);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
 	TrackID trackIdSave = track->GetID();
-	for (auto control : controls)
-	{
-		control.second->TrackSettings(trackIdSave, name);
-	}
+	PublishToControls(&ControlInterface::TrackSettings, trackIdSave, name);
 	return trackIdSave;
 }
 
@@ -1681,11 +1821,8 @@ bool Manager::TrackDelete(const TrackID trackID,
 		storage->DeleteTrack(trackID);
 	}
 	const string& name = track->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->TrackDelete(trackID, name);
-	}
+	PublishToControls(&ControlInterface::TrackDelete, trackID, name);
+	FlushControls();
 
 	Cluster* cluster = track->GetCluster();
 	if (cluster != nullptr)
@@ -1728,11 +1865,7 @@ void Manager::SwitchState(const ControlType controlType, Switch* mySwitch, const
 
 	mySwitch->SetAccessoryState(state);
 
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SwitchState(controlType, mySwitch);
-	}
+	PublishToControls(&ControlInterface::SwitchState, controlType, mySwitch);
 }
 
 Switch* Manager::GetSwitch(const SwitchID switchID) const
@@ -1747,17 +1880,7 @@ Switch* Manager::GetSwitch(const SwitchID switchID) const
 
 Switch* Manager::GetSwitch(const ControlID controlID, const Protocol protocol, const Address address) const
 {
-	std::lock_guard<std::mutex> guard(switchMutex);
-	for (auto mySwitch : switches)
-	{
-		if (mySwitch.second->GetControlID() == controlID
-			&& mySwitch.second->GetProtocol() == protocol
-			&& mySwitch.second->GetAddress() == address)
-		{
-			return mySwitch.second;
-		}
-	}
-	return nullptr;
+	return switchesByAddress.Get(HardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetSwitchName(const SwitchID switchID) const
@@ -1824,9 +1947,11 @@ bool Manager::SwitchSave(const SwitchID switchID,
 	mySwitch->SetPosY(posY);
 	mySwitch->SetPosZ(posZ);
 	mySwitch->SetRotation(rotation);
+	RemoveFromAddressIndex(switchesByAddress, mySwitch);
 	mySwitch->SetControlID(controlID);
 	mySwitch->SetProtocol(protocol);
 	mySwitch->SetAddress(address);
+	AddToAddressIndex(switchesByAddress, mySwitch);
 	mySwitch->SetType(type);
 	mySwitch->SetAccessoryPulseDuration(duration);
 	mySwitch->SetInverted(inverted);
@@ -1837,11 +1962,7 @@ bool Manager::SwitchSave(const SwitchID switchID,
 		storage->Save(*mySwitch);
 	}
 	const SwitchID switchIdSave = mySwitch->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SwitchSettings(switchIdSave, name);
-	}
+	PublishToControls(&ControlInterface::SwitchSettings, switchIdSave, name);
 	return true;
 }
 
@@ -1870,6 +1991,7 @@ bool Manager::SwitchDelete(const SwitchID switchID,
 			return false;
 		}
 		switches.erase(switchID);
+		RemoveFromAddressIndex(switchesByAddress, mySwitch);
 	}
 
 	if (storage)
@@ -1878,11 +2000,8 @@ bool Manager::SwitchDelete(const SwitchID switchID,
 	}
 
 	const string& switchName = mySwitch->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SwitchDelete(switchID, switchName);
-	}
+	PublishToControls(&ControlInterface::SwitchDelete, switchID, switchName);
+	FlushControls();
 	delete mySwitch;
 	return true;
 }
@@ -2111,11 +2230,7 @@ bool Manager::RouteSave(const RouteID routeID,
 	{
 		storage->Save(*route);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->RouteSettings(route->GetID(), name);
-	}
+	PublishToControls(&ControlInterface::RouteSettings, route->GetID(), name);
 	return true;
 }
 
@@ -2176,11 +2291,8 @@ bool Manager::RouteDelete(const RouteID routeID,
 	}
 
 	const string& routeName = route->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->RouteDelete(routeID, routeName);
-	}
+	PublishToControls(&ControlInterface::RouteDelete, routeID, routeName);
+	FlushControls();
 	delete route;
 	return true;
 }
@@ -2257,11 +2369,7 @@ bool Manager::LayerSave(const LayerID layerID, const std::string&name, std::stri
 		storage->Save(*layer);
 	}
 	const LayerID layerIdSave = layer->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LayerSettings(layerIdSave, name);
-	}
+	PublishToControls(&ControlInterface::LayerSettings, layerIdSave, name);
 	return true;
 }
 
@@ -2365,11 +2473,8 @@ bool Manager::LayerDelete(const LayerID layerID,
 	}
 
 	const string& layerName = layer->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LayerDelete(layerID, layerName);
-	}
+	PublishToControls(&ControlInterface::LayerDelete, layerID, layerName);
+	FlushControls();
 	delete layer;
 	return true;
 }
@@ -2413,11 +2518,7 @@ bool Manager::SignalState(const ControlType controlType, Signal* signal, const D
 
 void Manager::SignalPublishState(const ControlType controlType, const DataModel::Signal* signal)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SignalState(controlType, signal);
-	}
+	PublishToControls(&ControlInterface::SignalState, controlType, signal);
 }
 
 Signal* Manager::GetSignal(const SignalID signalID) const
@@ -2432,17 +2533,7 @@ Signal* Manager::GetSignal(const SignalID signalID) const
 
 Signal* Manager::GetSignal(const ControlID controlID, const Protocol protocol, const Address address) const
 {
-	std::lock_guard<std::mutex> guard(signalMutex);
-	for (auto signal : signals)
-	{
-		if (signal.second->GetControlID() == controlID
-			&& signal.second->GetProtocol() == protocol
-			&& signal.second->GetAddress() == address)
-		{
-			return signal.second;
-		}
-	}
-	return nullptr;
+	return signalsByAddress.Get(HardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetSignalName(const SignalID signalID) const
@@ -2522,9 +2613,11 @@ bool Manager::SignalSave(const SignalID signalID,
 	signal->SetSelectRouteApproach(selectRouteApproach);
 	signal->SetAllowLocoTurn(allowLocoTurn);
 	signal->SetReleaseWhenFree(releaseWhenFree);
+	RemoveFromAddressIndex(signalsByAddress, signal);
 	signal->SetControlID(controlID);
 	signal->SetProtocol(protocol);
 	signal->SetAddress(address);
+	AddToAddressIndex(signalsByAddress, signal);
 	signal->SetType(type);
 	signal->SetAccessoryPulseDuration(duration);
 	signal->SetInverted(inverted);
@@ -2535,11 +2628,7 @@ bool Manager::SignalSave(const SignalID signalID,
 		storage->Save(*signal);
 	}
 	const SignalID signalIdSave = signal->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SignalSettings(signalIdSave, name);
-	}
+	PublishToControls(&ControlInterface::SignalSettings, signalIdSave, name);
 	return true;
 }
 
@@ -2597,6 +2686,7 @@ bool Manager::SignalDelete(const SignalID signalID,
 
 		signal = signals.at(signalID);
 		signals.erase(signalID);
+		RemoveFromAddressIndex(signalsByAddress, signal);
 	}
 
 	if (storage)
@@ -2605,11 +2695,8 @@ bool Manager::SignalDelete(const SignalID signalID,
 	}
 
 	const string& signalName = signal->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SignalDelete(signalID, signalName);
-	}
+	PublishToControls(&ControlInterface::SignalDelete, signalID, signalName);
+	FlushControls();
 
 	Cluster* cluster = signal->GetCluster();
 	if (cluster != nullptr)
@@ -2715,11 +2802,8 @@ bool Manager::ClusterDelete(const ClusterID clusterID)
 	}
 
 	const string& clusterName = cluster->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->ClusterDelete(clusterID, clusterName);
-	}
+	PublishToControls(&ControlInterface::ClusterDelete, clusterID, clusterName);
+	FlushControls();
 	delete cluster;
 	return true;
 }
@@ -2791,11 +2875,7 @@ bool Manager::LocoReleaseInternal(Loco* loco)
 		return false;
 	}
 	LocoID locoID = loco->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoRelease(locoID);
-	}
+	PublishToControls(&ControlInterface::LocoRelease, locoID);
 	return true;
 }
 
@@ -2887,11 +2967,7 @@ void Manager::TrackBasePublishState(const DataModel::TrackBase* trackBase)
 
 void Manager::TrackPublishState(const DataModel::Track* track)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->TrackState(track);
-	}
+	PublishToControls(&ControlInterface::TrackState, track);
 }
 
 bool Manager::RouteRelease(const RouteID routeID)
@@ -2907,11 +2983,7 @@ bool Manager::RouteRelease(const RouteID routeID)
 
 bool Manager::LocoDestinationReached(const Loco* loco, const Route* route, const TrackBase* track)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoDestinationReached(loco, route, track);
-	}
+	PublishToControls(&ControlInterface::LocoDestinationReached, loco, route, track);
 	return true;
 }
 
@@ -2927,11 +2999,7 @@ bool Manager::LocoStart(const LocoID locoID)
 	{
 		return false;
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoStart(locoID, loco->GetName());
-	}
+	PublishToControls(&ControlInterface::LocoStart, locoID, loco->GetName());
 	return true;
 }
 
@@ -2945,13 +3013,7 @@ bool Manager::LocoStartAll()
 		{
 			continue;
 		}
-		{
-			std::lock_guard<std::mutex> guard(controlMutex);
-			for (auto control : controls)
-			{
-				control.second->LocoStart(loco.first, loco.second->GetName());
-			}
-		}
+		PublishToControls(&ControlInterface::LocoStart, loco.first, loco.second->GetName());
 	}
 	return true;
 }
@@ -2972,11 +3034,7 @@ bool Manager::LocoStop(const LocoID locoID)
 	{
 		Utils::Utils::SleepForSeconds(1);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoStop(locoID, loco->GetName());
-	}
+	PublishToControls(&ControlInterface::LocoStop, locoID, loco->GetName());
 	return true;
 }
 
@@ -3010,11 +3068,7 @@ bool Manager::LocoStopAll()
 			if (locoInManualMode)
 			{
 				const string& locoName = loco.second->GetName();
-				std::lock_guard<std::mutex> guard(controlMutex);
-				for (auto control : controls)
-				{
-					control.second->LocoStop(loco.first, locoName);
-				}
+				PublishToControls(&ControlInterface::LocoStop, loco.first, locoName);
 			}
 		}
 	}
@@ -3250,24 +3304,6 @@ bool Manager::SaveSettings(const Languages::Language language,
 	return true;
 }
 
-void Manager::DebounceWorker()
-{
-	Utils::Utils::SetThreadName(Languages::GetText(Languages::TextDebouncer));
-	logger->Info(Languages::TextDebounceThreadStarted);
-	while (debounceRun)
-	{
-		{
-			std::lock_guard<std::mutex> guard(feedbackMutex);
-			for (auto feedback : feedbacks)
-			{
-				feedback.second->Debounce();
-			}
-		}
-		Utils::Utils::SleepForMilliseconds(250);
-	}
-	logger->Info(Languages::TextDebounceThreadTerminated);
-}
-
 template<class ID, class T>
 T* Manager::CreateAndAddObject(std::map<ID,T*>& objects, std::mutex& mutex)
 {
@@ -3369,11 +3405,7 @@ void Manager::ProgramWrite(const ControlID controlID, const ProgramMode mode, co
 
 void Manager::ProgramValue(const CvNumber cv, const CvValue value)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->ProgramValue(cv, value);;
-	}
+	PublishToControls(&ControlInterface::ProgramValue, cv, value);
 }
 
 bool Manager::CanHandle(const Hardware::Capabilities capability) const
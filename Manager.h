@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <mutex>
 #include <sstream>
@@ -29,10 +30,21 @@ along with RailControl; see the file LICENCE. If not see
 
 #include "Config.h"
 #include "ControlInterface.h"
+#include "ControlQueue.h"
 #include "DataModel/DataModel.h"
 #include "Hardware/HardwareParams.h"
 #include "Logger/Logger.h"
 #include "Storage/StorageHandler.h"
+#include "Utils/ThreadSafeIndex.h"
+
+class AutoModeScheduler;
+class FeedbackDebouncer;
+class LocoStateSync;
+
+namespace Hardware
+{
+	class AccessoryPulseTimer;
+}
 
 class Manager
 {
@@ -74,6 +86,8 @@ class Manager
 		const std::map<ControlID,std::string> AccessoryControlListNames() const;
 		const std::map<ControlID,std::string> FeedbackControlListNames() const;
 		const std::map<ControlID,std::string> ProgramControlListNames() const;
+		const std::map<ControlID,ControlQueue::Statistics> ControlQueueStatistics() const;
+		const std::map<ControlID,std::map<Languages::TextSelector,uint64_t>> ControlStatistics() const;
 
 		inline const std::map<std::string,Protocol> LocoProtocolsOfControl(const ControlID controlID) const
 		{
@@ -92,6 +106,15 @@ class Manager
 		DataModel::Loco* GetLoco(const LocoID locoID) const;
 		const std::string& GetLocoName(const LocoID locoID) const;
 
+		// copies the current state of the loco, returns false if it does not exist or belongs to another control
+		bool LocoState(const LocoID locoID,
+			const ControlID controlID,
+			Protocol& protocol,
+			Address& address,
+			Speed& speed,
+			Orientation& orientation,
+			std::vector<DataModel::LocoFunctionEntry>& functions) const;
+
 		inline const std::map<LocoID,DataModel::Loco*>& locoList() const
 		{
 			return locos;
@@ -174,7 +197,19 @@ class Manager
 		// feedback
 		void FeedbackState(const ControlID controlID, const FeedbackPin pin, const DataModel::Feedback::FeedbackState state);
 		void FeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state);
+
+		// Applies all pins of a contiguous range that differ between oldStates and newStates.
+		// Bit 0 of byte 0 (or bit 7 with FeedbackBitOrderMsbFirst) is firstPin.
+		// The changed feedbacks are resolved in one pass and published to the controls in one update.
+		void FeedbackStates(const ControlID controlID,
+			const FeedbackPin firstPin,
+			const unsigned char* oldStates,
+			const unsigned char* newStates,
+			const size_t nrOfBytes,
+			const DataModel::Feedback::FeedbackBitOrder bitOrder);
+
 		void FeedbackPublishState(const DataModel::Feedback* feedback);
+		void FeedbackDebounce(DataModel::Feedback* feedback, const unsigned int generation);
 		DataModel::Feedback* GetFeedback(const FeedbackID feedbackID) const;
 		DataModel::Feedback* GetFeedbackUnlocked(const FeedbackID feedbackID) const;
 		const std::string& GetFeedbackName(const FeedbackID feedbackID) const;
@@ -186,7 +221,7 @@ class Manager
 
 		const std::map<std::string,DataModel::Feedback*> FeedbackListByName() const;
 		const std::map<std::string,FeedbackID> FeedbacksOfTrack(const DataModel::ObjectIdentifier& identifier) const;
-		FeedbackID FeedbackSave(const FeedbackID feedbackID, const std::string& name, const DataModel::LayoutItem::Visible visible, const DataModel::LayoutItem::LayoutPosition posX, const DataModel::LayoutItem::LayoutPosition posY, const DataModel::LayoutItem::LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted,  std::string& result);
+		FeedbackID FeedbackSave(const FeedbackID feedbackID, const std::string& name, const DataModel::LayoutItem::Visible visible, const DataModel::LayoutItem::LayoutPosition posX, const DataModel::LayoutItem::LayoutPosition posY, const DataModel::LayoutItem::LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted, const DataModel::FeedbackDebounceTime debounceTime, std::string& result);
 
 		bool FeedbackDelete(const FeedbackID feedbackID,
 			std::string& result);
@@ -377,6 +412,16 @@ class Manager
 		bool LocoStopAll();
 		void StopAllLocosImmediately(const ControlType controlType);
 
+		inline AutoModeScheduler* GetAutoModeScheduler() const
+		{
+			return autoModeScheduler;
+		}
+
+		inline Hardware::AccessoryPulseTimer* GetAccessoryPulseTimer() const
+		{
+			return accessoryPulseTimer;
+		}
+
 		// settings
 		inline DataModel::AccessoryPulseDuration GetDefaultAccessoryDuration() const
 		{
@@ -549,7 +594,6 @@ class Manager
 		}
 
 		const std::vector<FeedbackID> CleanupAndCheckFeedbacksForTrack(const DataModel::ObjectIdentifier& identifier, const std::vector<FeedbackID>& newFeedbacks);
-		void DebounceWorker();
 
 		template<class ID, class T>
 		T* CreateAndAddObject(std::map<ID,T*>& objects, std::mutex& mutex);
@@ -617,15 +661,50 @@ class Manager
 			}
 		}
 
+		// reverse lookup of objects by their hardware address
+		static inline uint32_t HardwareAddressKey(const ControlID controlID, const Protocol protocol, const Address address)
+		{
+			return (static_cast<uint32_t>(controlID) << 24) | (static_cast<uint32_t>(protocol) << 16) | address;
+		}
+
+		static inline uint64_t FeedbackPinKey(const ControlID controlID, const FeedbackPin pin)
+		{
+			return (static_cast<uint64_t>(controlID) << 32) | pin;
+		}
+
+		template<class T>
+		static void AddToAddressIndex(Utils::ThreadSafeIndex<uint32_t,T>& index, T* object)
+		{
+			index.Insert(HardwareAddressKey(object->GetControlID(), object->GetProtocol(), object->GetAddress()), object);
+		}
+
+		template<class T>
+		static void RemoveFromAddressIndex(Utils::ThreadSafeIndex<uint32_t,T>& index, const T* object)
+		{
+			index.Erase(HardwareAddressKey(object->GetControlID(), object->GetProtocol(), object->GetAddress()), object);
+		}
+
 		bool LocoIntoTrackBase(Logger::Logger *logger, DataModel::Loco* loco, const ObjectType objectType, DataModel::TrackBase* track);
 
 		void InitLocos();
 
-		static inline void InitLocosStatic(Manager* manager)
+		void AddControlUnlocked(const ControlID controlID, ControlInterface* control, const HardwareType hardwareType);
+
+		// queues the call for every control, each control executes it in its own thread
+		template<typename... Params, typename... Args>
+		void PublishToControls(void (ControlInterface::*function)(Params...), Args... args)
 		{
-			manager->InitLocos();
+			std::lock_guard<std::mutex> guard(controlMutex);
+			for (auto controlQueue : controlQueues)
+			{
+				controlQueue.second->Enqueue(std::bind(function, std::placeholders::_1, args...));
+			}
 		}
 
+		// waits until all queued calls have been executed by the controls
+		// has to be called before an object that is referenced by a call is deleted
+		void FlushControls();
+
 		void ProgramCheckBooster(const ProgramMode mode);
 
 		bool ObjectIsPartOfRoute(const DataModel::ObjectIdentifier& identifier,
@@ -639,6 +718,9 @@ class Manager
 
 		// controls (Webserver & hardwareHandler. So each hardware is also added here).
 		std::map<ControlID,ControlInterface*> controls;
+		std::map<ControlID,ControlQueue*> controlQueues;
+		// minimum time between two speeds of the same loco, configured per hardware type
+		unsigned int locoSpeedIntervals[HardwareTypeNumbers];
 		mutable std::mutex controlMutex;
 
 		// hardware (virt, CS2, ...)
@@ -651,14 +733,17 @@ class Manager
 		// loco
 		std::map<LocoID,DataModel::Loco*> locos;
 		mutable std::mutex locoMutex;
+		Utils::ThreadSafeIndex<uint32_t,DataModel::Loco> locosByAddress;
 
 		// accessory
 		std::map<AccessoryID,DataModel::Accessory*> accessories;
 		mutable std::mutex accessoryMutex;
+		Utils::ThreadSafeIndex<uint32_t,DataModel::Accessory> accessoriesByAddress;
 
 		// feedback
 		std::map<FeedbackID,DataModel::Feedback*> feedbacks;
 		mutable std::mutex feedbackMutex;
+		Utils::ThreadSafeIndex<uint64_t,DataModel::Feedback> feedbacksByPin;
 
 		// track
 		std::map<TrackID,DataModel::Track*> tracks;
@@ -667,6 +752,7 @@ class Manager
 		// switch
 		std::map<SwitchID,DataModel::Switch*> switches;
 		mutable std::mutex switchMutex;
+		Utils::ThreadSafeIndex<uint32_t,DataModel::Switch> switchesByAddress;
 
 		// route
 		std::map<RouteID,DataModel::Route*> routes;
@@ -679,6 +765,7 @@ class Manager
 		// signal
 		std::map<SignalID,DataModel::Signal*> signals;
 		mutable std::mutex signalMutex;
+		Utils::ThreadSafeIndex<uint32_t,DataModel::Signal> signalsByAddress;
 
 		// cluster
 		std::map<SignalID,DataModel::Cluster*> clusters;
@@ -687,6 +774,18 @@ class Manager
 		// storage
 		Storage::StorageHandler* storage;
 
+		// automode
+		AutoModeScheduler* autoModeScheduler;
+
+		// accessory pulses of all controls
+		Hardware::AccessoryPulseTimer* accessoryPulseTimer;
+
+		// feedbacks going free
+		FeedbackDebouncer* feedbackDebouncer;
+
+		// initial loco states of all controls
+		LocoStateSync* locoStateSync;
+
 		DataModel::AccessoryPulseDuration defaultAccessoryDuration;
 		bool autoAddFeedback;
 		bool stopOnFeedbackInFreeTrack;
@@ -694,8 +793,6 @@ class Manager
 		DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve;
 
 		volatile bool run;
-		volatile bool debounceRun;
-		std::thread debounceThread;
 
 		volatile bool initLocosDone;
 
@@ -145,6 +145,10 @@ namespace Network
 		{
 			return -1;
 		}
+		if (controlID != ControlNone)
+		{
+			Logger::PacketCapture::Received(Logger::PacketCapture::SourceSerial, controlID, data, ret);
+		}
 		return ret;
 	}
 
@@ -25,14 +25,18 @@ along with RailControl; see the file LICENCE. If not see
 #include <termios.h>
 #include <unistd.h>   //close & write;
 
+#include "DataTypes.h"
 #include "Logger/Logger.h"
+#include "Logger/PacketCapture.h"
 
 namespace Network
 {
 	class Serial
 	{
 		public:
+			// frames are captured for the control controlID, ControlNone disables capturing
 			Serial(Logger::Logger* logger,
+				const ControlID controlID,
 				const std::string& tty,
 				const unsigned int dataSpeed, // from termio (ex. B9600)
 				const unsigned char dataBits,
@@ -40,6 +44,7 @@ namespace Network
 				const unsigned char stopBits,
 				const bool hardwareFlowControl = false)
 			:	logger(logger),
+			 	controlID(controlID),
 			 	tty(tty),
 			 	dataSpeed(dataSpeed),
 			 	dataBits(dataBits),
@@ -77,6 +82,10 @@ namespace Network
 				{
 					return 0;
 				}
+				if (controlID != ControlNone)
+				{
+					Logger::PacketCapture::Sent(Logger::PacketCapture::SourceSerial, controlID, data, size);
+				}
 				std::lock_guard<std::mutex> Guard(fileHandleMutex);
 				return write(fileHandle, data, size);
 			}
@@ -91,6 +100,7 @@ namespace Network
 			void Close();
 
 			Logger::Logger* logger;
+			const ControlID controlID;
 			const std::string tty;
 			const unsigned int dataSpeed;
 			const unsigned char dataBits;
@@ -19,6 +19,11 @@ along with RailControl; see the file LICENCE. If not see
 */
 
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 #include <unistd.h>   // close & TEMP_FAILURE_RETRY;
 
 #include "Network/Select.h"
@@ -44,24 +49,32 @@ namespace Network
 			return -1;
 		}
 		errno = 0;
-		fd_set set;
-		FD_ZERO(&set);
-		FD_SET(connectionSocket, &set);
-		struct timeval timeout;
-		timeout.tv_sec = 5;
-		timeout.tv_usec = 0;
+		// poll instead of select, socket numbers may exceed FD_SETSIZE
+		struct pollfd fd;
+		fd.fd = connectionSocket;
+		fd.events = POLLOUT;
 
-		int ret = TEMP_FAILURE_RETRY(select(FD_SETSIZE, NULL, &set, NULL, &timeout));
+		// with MSG_DONTWAIT only as much as fits into the socket buffer is sent, possibly nothing
+		const bool dontWait = (flags & MSG_DONTWAIT) != 0;
+		int ret = TEMP_FAILURE_RETRY(poll(&fd, 1, dontWait ? 0 : 5000));
 		if (ret < 0)
 		{
 			return ret;
 		}
 		if (ret == 0)
 		{
+			if (dontWait)
+			{
+				return 0;
+			}
 			errno = ETIMEDOUT;
 			return -1;
 		}
 		ret = send(connectionSocket, buffer, bufferLength, flags | MSG_NOSIGNAL);
+		if (ret < 0 && dontWait && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			return 0;
+		}
 		if (ret <= 0)
 		{
 			errno = ECONNRESET;
@@ -71,6 +84,48 @@ namespace Network
 		return ret;
 	}
 
+	long TcpConnection::SendFile(const std::string& fileName, const size_t size)
+	{
+		int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+		if (fileDescriptor < 0)
+		{
+			return -1;
+		}
+		size_t sent = 0;
+		while (sent < size && connected)
+		{
+#ifdef __linux__
+			struct pollfd fd;
+			fd.fd = connectionSocket;
+			fd.events = POLLOUT;
+			int ret = TEMP_FAILURE_RETRY(poll(&fd, 1, 5000));
+			if (ret <= 0)
+			{
+				break;
+			}
+			ssize_t r = sendfile(connectionSocket, fileDescriptor, nullptr, size - sent);
+			if (r <= 0)
+			{
+				if (r < 0 && (errno == EINTR || errno == EAGAIN))
+				{
+					continue;
+				}
+				break;
+			}
+#else
+			char buffer[16384];
+			ssize_t r = TEMP_FAILURE_RETRY(read(fileDescriptor, buffer, sizeof(buffer)));
+			if (r <= 0 || Send(buffer, r) != r)
+			{
+				break;
+			}
+#endif
+			sent += r;
+		}
+		close(fileDescriptor);
+		return sent == size ? static_cast<long>(sent) : -1;
+	}
+
 	int TcpConnection::Receive(char* buf, const size_t buflen, const int flags)
 	{
 		if (connectionSocket == 0 || connected == false)
@@ -79,14 +134,12 @@ namespace Network
 			return -1;
 		}
 		errno = 0;
-		fd_set set;
-		FD_ZERO(&set);
-		FD_SET(connectionSocket, &set);
-		struct timeval timeout;
-		timeout.tv_sec = 1;
-		timeout.tv_usec = 0;
+		struct pollfd fd;
+		fd.fd = connectionSocket;
+		fd.events = POLLIN;
 
-		int ret = TEMP_FAILURE_RETRY(select(FD_SETSIZE, &set, NULL, NULL, &timeout));
+		// with MSG_DONTWAIT only the data that is already there is read
+		int ret = TEMP_FAILURE_RETRY(poll(&fd, 1, (flags & MSG_DONTWAIT) ? 0 : 1000));
 		if (ret < 0)
 		{
 			return ret;
@@ -39,6 +39,7 @@ namespace Network
 			}
 
 			void Terminate();
+			// with flags MSG_DONTWAIT the number of bytes sent may be less than bufferLength or 0
 			int Send(const char* buffer, const size_t bufferLength, const int flags = 0);
 			int Send(const unsigned char* buffer, const size_t bufferLength, const int flags = 0) { return Send(reinterpret_cast<const char*>(buffer), bufferLength, flags); }
 			int Send(const std::string& string, const int flags = 0)
@@ -46,11 +47,18 @@ namespace Network
 				return Send(string.c_str(), string.size(), flags);
 			}
 
+			// sends size bytes of the file without copying them through user space where possible
+			// returns the number of bytes sent or -1 on error
+			long SendFile(const std::string& fileName, const size_t size);
+
+			// fails with ETIMEDOUT if no data arrives within a second, immediately with flags MSG_DONTWAIT
 			int Receive(char* buf, const size_t buflen, const int flags = 0);
 			int Receive(unsigned char* buffer, const size_t bufferLength, const int flags = 0) { return Receive(reinterpret_cast<char*>(buffer), bufferLength, flags); }
 
 			bool IsConnected() const { return connected; }
 
+			int GetSocket() const { return connectionSocket; }
+
 		private:
 			int connectionSocket;
 			volatile bool connected;
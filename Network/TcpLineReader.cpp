@@ -0,0 +1,82 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstring>
+
+#include "Network/TcpLineReader.h"
+
+namespace Network
+{
+	const size_t TcpLineReader::BufferSize;
+
+	ssize_t TcpLineReader::ReadLine(char* line, const size_t lineSize)
+	{
+		while (true)
+		{
+			const size_t available = end - begin;
+			const char* lineEnd = static_cast<const char*>(memchr(buffer + begin, '\n', available));
+			if (lineEnd != nullptr)
+			{
+				size_t length = lineEnd - (buffer + begin);
+				if (length > lineSize)
+				{
+					return CopyLine(line, lineSize, lineSize);
+				}
+				if (length > 0 && buffer[begin + length - 1] == '\r')
+				{
+					--length;
+				}
+				return CopyLine(line, length, lineEnd - (buffer + begin) + 1);
+			}
+
+			if (available >= lineSize)
+			{
+				return CopyLine(line, lineSize, lineSize);
+			}
+
+			if (begin > 0)
+			{
+				memmove(buffer, buffer + begin, available);
+				begin = 0;
+				end = available;
+			}
+
+			int ret = connection.Receive(buffer + end, BufferSize - end);
+			if (ret <= 0)
+			{
+				return -1;
+			}
+			end += ret;
+		}
+	}
+
+	ssize_t TcpLineReader::CopyLine(char* line, const size_t length, const size_t consumed)
+	{
+		memcpy(line, buffer + begin, length);
+		begin += consumed;
+		if (begin == end)
+		{
+			begin = 0;
+			end = 0;
+		}
+		return length;
+	}
+}
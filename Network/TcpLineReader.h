@@ -0,0 +1,62 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <sys/types.h>
+
+#include "Network/TcpConnection.h"
+
+namespace Network
+{
+	// Reads a line based protocol from a tcp connection in large chunks
+	// and splits it into lines in user space.
+	class TcpLineReader
+	{
+		public:
+			TcpLineReader() = delete;
+			TcpLineReader(const TcpLineReader&) = delete;
+			TcpLineReader& operator=(const TcpLineReader&) = delete;
+
+			TcpLineReader(TcpConnection& connection)
+			:	connection(connection),
+				begin(0),
+				end(0)
+			{}
+
+			// Copies the next line without its line end into line and returns the length.
+			// A line longer than lineSize is split into several lines.
+			// Returns -1 with errno set if no complete line has been received. A partial line
+			// is kept, so after a timeout (errno == ETIMEDOUT) reading can simply be continued.
+			ssize_t ReadLine(char* line, const size_t lineSize);
+
+		private:
+			static const size_t BufferSize = 16384;
+
+			ssize_t CopyLine(char* line, const size_t length, const size_t consumed);
+
+			TcpConnection& connection;
+			char buffer[BufferSize];
+			size_t begin;
+			size_t end;
+	};
+}
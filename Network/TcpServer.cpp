@@ -22,8 +22,12 @@ along with RailControl; see the file LICENCE. If not see
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include <iostream>
 
@@ -33,11 +37,37 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Network
 {
-	TcpServer::TcpServer(const unsigned short port, const std::string& threadName)
+	TcpServer::TcpServer(const unsigned short port, const std::string& threadName, const unsigned char nrOfIoThreads)
 	:	run(false),
 	 	error(""),
-	 	threadName(threadName)
+	 	threadName(threadName),
+	 	epollFd(-1)
 	{
+		terminatePipe[0] = -1;
+		terminatePipe[1] = -1;
+		if (pipe(terminatePipe) != 0)
+		{
+			error = "Unable to create pipe for tcp server. Unable to serve clients.";
+			return;
+		}
+
+#ifdef __linux__
+		if (nrOfIoThreads > 0)
+		{
+			epollFd = epoll_create1(EPOLL_CLOEXEC);
+		}
+		if (epollFd >= 0)
+		{
+			// level triggered: once written the terminate pipe wakes up all I/O threads
+			struct epoll_event event;
+			event.events = EPOLLIN;
+			event.data.ptr = nullptr;
+			epoll_ctl(epollFd, EPOLL_CTL_ADD, terminatePipe[0], &event);
+		}
+#else
+		(void)nrOfIoThreads;
+#endif
+
 		struct sockaddr_in6 serverAddr6;
 		memset(reinterpret_cast<char*>(&serverAddr6), 0, sizeof(serverAddr6));
 		serverAddr6.sin6_family = AF_INET6;
@@ -53,6 +83,15 @@ namespace Network
 		serverAddr4.sin_port = htons(port);
 		SocketCreateBindListen(serverAddr4.sin_family, reinterpret_cast<struct sockaddr*>(&serverAddr4));
 #endif
+
+		if (run == false || epollFd < 0)
+		{
+			return;
+		}
+		for (unsigned char i = 0; i < nrOfIoThreads; ++i)
+		{
+			ioThreads.push_back(std::thread(&Network::TcpServer::IoWorker, this));
+		}
 	}
 
 	TcpServer::~TcpServer()
@@ -65,6 +104,16 @@ namespace Network
 			connections.pop_back();
 			delete client;
 		}
+
+		if (epollFd >= 0)
+		{
+			close(epollFd);
+		}
+		if (terminatePipe[0] >= 0)
+		{
+			close(terminatePipe[0]);
+			close(terminatePipe[1]);
+		}
 	}
 
 	void TcpServer::SocketCreateBindListen(int family, struct sockaddr* address)
@@ -114,39 +163,128 @@ namespace Network
 		}
 
 		run = false;
+		const char terminate = 0;
+		__attribute__((unused)) ssize_t unused = write(terminatePipe[1], &terminate, sizeof(terminate));
 
 		for(std::thread& serverThread : serverThreads)
 		{
 			serverThread.join();
 		}
+		for(std::thread& ioThread : ioThreads)
+		{
+			ioThread.join();
+		}
+	}
+
+	void TcpServer::Watch(TcpConnection* connection)
+	{
+#ifdef __linux__
+		WatchEvents(connection, EPOLLIN | EPOLLRDHUP);
+#else
+		(void)connection;
+#endif
+	}
+
+	void TcpServer::WatchWritable(TcpConnection* connection)
+	{
+#ifdef __linux__
+		WatchEvents(connection, EPOLLOUT);
+#else
+		(void)connection;
+#endif
+	}
+
+	void TcpServer::WatchEvents(TcpConnection* connection, const unsigned int events)
+	{
+#ifdef __linux__
+		struct epoll_event event;
+		event.events = events | EPOLLONESHOT;
+		event.data.ptr = connection;
+		const int socket = connection->GetSocket();
+		if (epoll_ctl(epollFd, EPOLL_CTL_MOD, socket, &event) != 0 && errno == ENOENT)
+		{
+			epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &event);
+		}
+#else
+		(void)connection;
+		(void)events;
+#endif
+	}
+
+	void TcpServer::CloseConnection(TcpConnection* connection)
+	{
+		{
+			std::lock_guard<std::mutex> guard(connectionMutex);
+			for (auto it = connections.begin(); it != connections.end(); ++it)
+			{
+				if (*it == connection)
+				{
+					connections.erase(it);
+					break;
+				}
+			}
+		}
+#ifdef __linux__
+		// a closed socket has already been removed by the kernel and its number may be reused
+		if (epollFd >= 0 && connection->IsConnected())
+		{
+			epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->GetSocket(), nullptr);
+		}
+#endif
+		delete connection;
+	}
+
+	void TcpServer::IoWorker()
+	{
+#ifdef __linux__
+		Utils::Utils::SetThreadName(threadName);
+		struct epoll_event events[MaxEvents];
+		while (run == true)
+		{
+			int ret = TEMP_FAILURE_RETRY(epoll_wait(epollFd, events, MaxEvents, -1));
+			if (ret < 0)
+			{
+				return;
+			}
+			for (int i = 0; i < ret && run == true; ++i)
+			{
+				TcpConnection* connection = static_cast<TcpConnection*>(events[i].data.ptr);
+				if (connection == nullptr)
+				{
+					// terminate pipe
+					continue;
+				}
+				if (events[i].events & EPOLLOUT)
+				{
+					ConnectionWritable(connection);
+					continue;
+				}
+				ConnectionReadable(connection);
+			}
+		}
+#endif
 	}
 
 	void TcpServer::Worker(int socket)
 	{
 		Utils::Utils::SetThreadName(threadName);
-		fd_set set;
-		struct timeval tv;
 		struct sockaddr_in6 client_addr;
 		socklen_t client_addr_len = sizeof(client_addr);
+		struct pollfd fds[2];
+		fds[0].fd = socket;
+		fds[0].events = POLLIN;
+		fds[1].fd = terminatePipe[0];
+		fds[1].events = POLLIN;
 		while (run == true)
 		{
 			// wait for connection and abort on shutdown
-			int ret;
-			do
+			int ret = TEMP_FAILURE_RETRY(poll(fds, 2, -1));
+			if (run == false)
 			{
-				FD_ZERO(&set);
-				FD_SET(socket, &set);
-				tv.tv_sec = 1;
-				tv.tv_usec = 0;
-				ret = TEMP_FAILURE_RETRY(select(FD_SETSIZE, &set, NULL, NULL, &tv));
-
-				if (run == false)
-				{
-					return;
-				}
-			} while (ret == 0);
+				return;
+			}
 
-			if (ret < 0)
+			if (ret <= 0 || (fds[0].revents & POLLIN) == 0)
 			{
 				continue;
 			}
@@ -160,7 +298,10 @@ namespace Network
 
 			// create client and fill into vector
 			auto con = new TcpConnection(socketClient);
-			connections.push_back(con);
+			{
+				std::lock_guard<std::mutex> guard(connectionMutex);
+				connections.push_back(con);
+			}
 			Work(con);
 		}
 	}
@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -36,20 +37,49 @@ namespace Network
 			TcpServer() = delete;
 
 		protected:
-			TcpServer(const unsigned short port, const std::string& threadName);
+			// with nrOfIoThreads > 0 the server runs in reactor mode:
+			// a connection only occupies a thread while it has data to be handled.
+			// Reactor mode is only available on linux, elsewhere nrOfIoThreads is ignored.
+			TcpServer(const unsigned short port, const std::string& threadName, const unsigned char nrOfIoThreads = 0);
 			virtual ~TcpServer();
 			void TerminateTcpServer();
 
+			// called for every accepted connection
 			virtual void Work(Network::TcpConnection* connection) = 0;
 
+			// reactor mode only: called by one of the I/O threads when a watched connection is readable or closed
+			virtual void ConnectionReadable(__attribute__((unused)) Network::TcpConnection* connection) {}
+
+			bool IsReactor() const { return ioThreads.size() > 0; }
+
+			// reactor mode only: called by one of the I/O threads when a connection watched with WatchWritable can be written
+			virtual void ConnectionWritable(__attribute__((unused)) Network::TcpConnection* connection) {}
+
+			// reactor mode only: call ConnectionReadable once the next time the connection is readable
+			void Watch(Network::TcpConnection* connection);
+
+			// reactor mode only: call ConnectionWritable once the next time the connection can be written
+			void WatchWritable(Network::TcpConnection* connection);
+
+			// closes the connection and frees its memory
+			void CloseConnection(Network::TcpConnection* connection);
+
 		private:
+			static const int MaxEvents = 8;
+
+			void WatchEvents(Network::TcpConnection* connection, const unsigned int events);
 			void SocketCreateBindListen(int family, struct sockaddr* address);
 			void Worker(int socket);
+			void IoWorker();
 
 			volatile bool run;
 			std::vector<std::thread> serverThreads;
+			std::vector<std::thread> ioThreads;
+			std::mutex connectionMutex;
 			std::vector<TcpConnection*> connections;
 			std::string error;
 			const std::string threadName;
+			int terminatePipe[2];
+			int epollFd;
 	};
 }
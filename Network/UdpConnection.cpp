@@ -28,6 +28,51 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Network
 {
+	UdpDatagrams::UdpDatagrams(const unsigned int maxDatagrams, const size_t maxDatagramLength)
+	:	maxDatagrams(maxDatagrams),
+		maxDatagramLength(maxDatagramLength),
+		size(0),
+		buffer(maxDatagrams * maxDatagramLength),
+		lengths(maxDatagrams),
+		iovecs(maxDatagrams)
+#ifdef __linux__
+		, headers(maxDatagrams)
+#endif
+	{
+#ifdef __linux__
+		memset(headers.data(), 0, headers.size() * sizeof(struct mmsghdr));
+#endif
+		for (unsigned int index = 0; index < maxDatagrams; ++index)
+		{
+			iovecs[index].iov_base = Buffer(index);
+#ifdef __linux__
+			headers[index].msg_hdr.msg_iov = &iovecs[index];
+			headers[index].msg_hdr.msg_iovlen = 1;
+#endif
+		}
+	}
+
+	bool UdpDatagrams::Append(const unsigned char* data, const size_t length)
+	{
+		if (length > maxDatagramLength)
+		{
+			return false;
+		}
+		if (size == 0 || lengths[size - 1] + length > maxDatagramLength)
+		{
+			if (size == maxDatagrams)
+			{
+				return false;
+			}
+			lengths[size] = 0;
+			++size;
+		}
+		size_t& lastLength = lengths[size - 1];
+		memcpy(Buffer(size - 1) + lastLength, data, length);
+		lastLength += length;
+		return true;
+	}
+
 	UdpConnection::UdpConnection(Logger::Logger* logger, const std::string& server, const unsigned short port)
 	:	logger(logger),
 	 	connected(false),
@@ -94,6 +139,131 @@ namespace Network
 		return sendto(connectionSocket, buffer, bufferLength, 0, &sockaddr, sizeof(struct sockaddr));
 	}
 
+	int UdpConnection::SendBatch(UdpDatagrams& datagrams)
+	{
+		if (!connected)
+		{
+			logger->Error(Languages::TextConnectionReset);
+			errno = ECONNRESET;
+			return -1;
+		}
+#ifdef __linux__
+		for (unsigned int index = 0; index < datagrams.size; ++index)
+		{
+			struct msghdr& header = datagrams.headers[index].msg_hdr;
+			header.msg_name = &sockaddr;
+			header.msg_namelen = sizeof(struct sockaddr);
+			datagrams.iovecs[index].iov_len = datagrams.lengths[index];
+		}
+		unsigned int sent = 0;
+		while (sent < datagrams.size)
+		{
+			int ret = sendmmsg(connectionSocket, datagrams.headers.data() + sent, datagrams.size - sent, 0);
+			if (ret < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return sent > 0 ? sent : -1;
+			}
+			sent += ret;
+		}
+		return sent;
+#else
+		unsigned int sent = 0;
+		while (sent < datagrams.size)
+		{
+			int ret = sendto(connectionSocket, datagrams.Buffer(sent), datagrams.lengths[sent], 0, &sockaddr, sizeof(struct sockaddr));
+			if (ret < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return sent > 0 ? sent : -1;
+			}
+			++sent;
+		}
+		return sent;
+#endif
+	}
+
+	int UdpConnection::ReceiveBatch(UdpDatagrams& datagrams)
+	{
+		datagrams.size = 0;
+		if (!connected)
+		{
+			logger->Error(Languages::TextConnectionReset);
+			errno = ECONNRESET;
+			return -1;
+		}
+#ifdef __linux__
+		for (unsigned int index = 0; index < datagrams.maxDatagrams; ++index)
+		{
+			struct msghdr& header = datagrams.headers[index].msg_hdr;
+			header.msg_name = nullptr;
+			header.msg_namelen = 0;
+			header.msg_flags = 0;
+			datagrams.iovecs[index].iov_len = datagrams.maxDatagramLength;
+		}
+		int ret;
+		do
+		{
+			if (!connected)
+			{
+				return 0;
+			}
+			ret = recvmmsg(connectionSocket, datagrams.headers.data(), datagrams.maxDatagrams, MSG_WAITFORONE, nullptr);
+		} while(ret < 0 && (errno == EAGAIN || errno == EINTR));
+		if (ret <= 0)
+		{
+			return ret;
+		}
+		for (int index = 0; index < ret; ++index)
+		{
+			const struct mmsghdr& header = datagrams.headers[index];
+			// a truncated datagram is handed over as empty datagram
+			datagrams.lengths[index] = (header.msg_hdr.msg_flags & MSG_TRUNC) ? 0 : header.msg_len;
+		}
+		datagrams.size = ret;
+		return ret;
+#else
+		unsigned int received = 0;
+		while (received < datagrams.maxDatagrams)
+		{
+			struct msghdr header;
+			memset(&header, 0, sizeof(header));
+			datagrams.iovecs[received].iov_len = datagrams.maxDatagramLength;
+			header.msg_iov = &datagrams.iovecs[received];
+			header.msg_iovlen = 1;
+			// like MSG_WAITFORONE: only the first datagram is waited for
+			ssize_t ret = recvmsg(connectionSocket, &header, received == 0 ? 0 : MSG_DONTWAIT);
+			if (ret < 0)
+			{
+				if (received > 0)
+				{
+					break;
+				}
+				if (errno != EAGAIN && errno != EINTR)
+				{
+					return -1;
+				}
+				if (!connected)
+				{
+					return 0;
+				}
+				continue;
+			}
+			// a truncated datagram is handed over as empty datagram
+			datagrams.lengths[received] = (header.msg_flags & MSG_TRUNC) ? 0 : ret;
+			++received;
+		}
+		datagrams.size = received;
+		return received;
+#endif
+	}
+
 	int UdpConnection::Receive(char* buffer, const size_t bufferLength)
 	{
 		if (!connected)
@@ -22,11 +22,72 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <arpa/inet.h>
 #include <string>
+#include <sys/socket.h>
+#include <vector>
 
 #include "Logger/Logger.h"
 
 namespace Network
 {
+	// Preallocated buffers for several datagrams that are received or sent with one system call.
+	// Without sendmmsg and recvmmsg (not linux) the datagrams are sent and received one by one.
+	class UdpDatagrams
+	{
+		friend class UdpConnection;
+
+		public:
+			UdpDatagrams() = delete;
+			UdpDatagrams(const UdpDatagrams&) = delete;
+			UdpDatagrams& operator=(const UdpDatagrams&) = delete;
+
+			UdpDatagrams(const unsigned int maxDatagrams, const size_t maxDatagramLength);
+
+			inline unsigned int Size() const
+			{
+				return size;
+			}
+
+			inline bool IsEmpty() const
+			{
+				return size == 0;
+			}
+
+			inline const unsigned char* Data(const unsigned int index) const
+			{
+				return buffer.data() + index * maxDatagramLength;
+			}
+
+			inline size_t Length(const unsigned int index) const
+			{
+				return lengths[index];
+			}
+
+			inline void Clear()
+			{
+				size = 0;
+			}
+
+			// appends data to the last datagram or starts a new one if it does not fit.
+			// Returns false if all datagrams are full.
+			bool Append(const unsigned char* data, const size_t length);
+
+		private:
+			inline unsigned char* Buffer(const unsigned int index)
+			{
+				return buffer.data() + index * maxDatagramLength;
+			}
+
+			const unsigned int maxDatagrams;
+			const size_t maxDatagramLength;
+			unsigned int size;
+			std::vector<unsigned char> buffer;
+			std::vector<size_t> lengths;
+			std::vector<struct iovec> iovecs;
+#ifdef __linux__
+			std::vector<struct mmsghdr> headers;
+#endif
+	};
+
 	class UdpConnection
 	{
 		public:
@@ -48,6 +109,13 @@ namespace Network
 			int Receive(char* buffer, const size_t bufferLength);
 			int Receive(unsigned char* buffer, const size_t bufferLength) { return Receive(reinterpret_cast<char*>(buffer), bufferLength); }
 
+			// sends all datagrams with as few system calls as possible. Returns the number of datagrams sent or -1
+			int SendBatch(UdpDatagrams& datagrams);
+
+			// waits like Receive for the first datagram and takes all others that are already available.
+			// Returns the number of datagrams received, 0 if the connection has been terminated or -1
+			int ReceiveBatch(UdpDatagrams& datagrams);
+
 		private:
 			Logger::Logger* logger;
 			int connectionSocket;
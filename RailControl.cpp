@@ -31,6 +31,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/HardwareHandler.h"
 #include "Languages.h"
 #include "Logger/Logger.h"
+#include "Logger/PacketCapture.h"
 #include "Manager.h"
 #include "Network/Select.h"
 #include "RailControl.h"
@@ -129,6 +130,26 @@ int main (int argc, char* argv[])
 	const string configFileName = argumentHandler.GetArgumentString('c', "railcontrol.conf");
 	Config config(configFileName);
 
+	if (config.getValue("logasync", 1) != 0)
+	{
+		const Logger::LoggerServer::OverflowPolicy overflowPolicy = config.getValue("logoverflow", "block").compare("drop") == 0
+			? Logger::LoggerServer::OverflowDrop
+			: Logger::LoggerServer::OverflowBlock;
+		// negative values fall back to the defaults
+		const int logBufferSize = config.getValue("logbuffersize", Logger::LoggerServer::DefaultBufferSize);
+		const int logFlushInterval = config.getValue("logflushinterval", Logger::LoggerServer::DefaultFlushIntervalMs);
+		Logger::LoggerServer::Instance().StartAsync(logBufferSize > 0 ? logBufferSize : 0,
+			logFlushInterval > 0 ? logFlushInterval : 0,
+			overflowPolicy);
+	}
+
+	const string captureFileName = config.getValue("capturefile", "");
+	if (captureFileName.length() > 0)
+	{
+		Logger::PacketCapture::Instance().Start(captureFileName,
+			config.getValue("capturebuffersize", Logger::PacketCapture::DefaultBufferSize));
+	}
+
 	Manager m(config);
 
 	// wait for q followed by \n or SIGINT or SIGTERM
@@ -39,6 +39,24 @@ using std::to_string;
 
 namespace Storage
 {
+	const char* SQLite::statementQueries[NumberOfStatements] =
+	{
+		/* StatementSaveHardwareParams */ "INSERT OR REPLACE INTO hardware VALUES (?, ?, ?, ?, ?, ?, ?, ?);",
+		/* StatementAllHardwareParams */ "SELECT controlid, hardwaretype, name, arg1, arg2, arg3, arg4, arg5 FROM hardware ORDER BY controlid;",
+		/* StatementDeleteHardwareParams */ "DELETE FROM hardware WHERE controlid = ?;",
+		/* StatementSaveObject */ "INSERT OR REPLACE INTO objects (objecttype, objectid, name, object) VALUES (?, ?, ?, ?);",
+		/* StatementDeleteObject */ "DELETE FROM objects WHERE objecttype = ? AND objectid = ?;",
+		/* StatementObjectsOfType */ "SELECT object FROM objects WHERE objecttype = ? ORDER BY objectid;",
+		/* StatementAllObjects */ "SELECT objecttype, object FROM objects ORDER BY objecttype, objectid;",
+		/* StatementSaveRelation */ "INSERT OR REPLACE INTO relations (type, objectid1, objecttype2, objectid2, priority, relation) VALUES (?, ?, ?, ?, ?, ?);",
+		/* StatementDeleteRelationsFrom */ "DELETE FROM relations WHERE type = ? AND objectid1 = ?;",
+		/* StatementDeleteRelationsTo */ "DELETE FROM relations WHERE objecttype2 = ? AND objectid2 = ?;",
+		/* StatementRelationsFrom */ "SELECT relation FROM relations WHERE type = ? AND objectid1 = ? ORDER BY priority ASC;",
+		/* StatementRelationsTo */ "SELECT relation FROM relations WHERE objecttype2 = ? AND objectid2 = ?;",
+		/* StatementAllRelations */ "SELECT type, objectid1, relation FROM relations ORDER BY type, objectid1, priority ASC;",
+		/* StatementSaveSetting */ "INSERT OR REPLACE INTO settings (key, value) values (?, ?);",
+		/* StatementGetSetting */ "SELECT value FROM settings WHERE key = ?;"
+	};
 
 	// create instance of sqlite
 	extern "C" SQLite* create_Sqlite(const StorageParams* params)
@@ -57,6 +75,10 @@ namespace Storage
 	 	logger(Logger::Logger::GetLogger("SQLite")),
 	 	keepBackups(params->keepBackups)
 	{
+		for (sqlite3_stmt*& statement : statements)
+		{
+			statement = nullptr;
+		}
 		RemoveOldBackupFiles();
 		logger->Info(Languages::TextOpeningSQLite, filename);
 		int rc = sqlite3_open(filename.c_str(), &db);
@@ -131,6 +153,7 @@ namespace Storage
 		}
 
 		logger->Info(Languages::TextClosingSQLite);
+		FinalizeStatements();
 		sqlite3_close(db);
 		db = nullptr;
 
@@ -203,6 +226,8 @@ namespace Storage
 
 	bool SQLite::DropTable(const string table)
 	{
+		// prepared statements must not survive a change of the schema
+		FinalizeStatements();
 		logger->Info(Languages::TextDroppingTable, table);
 		string query = "DROP TABLE " + table + ";";
 		return Execute(query);
@@ -348,127 +373,228 @@ namespace Storage
 
 	void SQLite::SaveHardwareParams(const Hardware::HardwareParams& hardwareParams)
 	{
-		string query = "INSERT OR REPLACE INTO hardware VALUES ("
-			+ to_string(hardwareParams.GetControlID()) + ", "
-			+ to_string(hardwareParams.GetHardwareType()) + ", '"
-			+ EscapeString(hardwareParams.GetName()) + "', '"
-			+ EscapeString(hardwareParams.GetArg1()) + "', '"
-			+ EscapeString(hardwareParams.GetArg2()) + "', '"
-			+ EscapeString(hardwareParams.GetArg3()) + "', '"
-			+ EscapeString(hardwareParams.GetArg4()) + "', '"
-			+ EscapeString(hardwareParams.GetArg5()) + "');";
-		Execute(query);
+		// the arguments are returned by value and must outlive Step
+		const string arg1 = hardwareParams.GetArg1();
+		const string arg2 = hardwareParams.GetArg2();
+		const string arg3 = hardwareParams.GetArg3();
+		const string arg4 = hardwareParams.GetArg4();
+		const string arg5 = hardwareParams.GetArg5();
+		sqlite3_stmt* statement = GetStatement(StatementSaveHardwareParams);
+		if (statement == nullptr
+			|| Bind(statement, 1, hardwareParams.GetControlID()) == false
+			|| Bind(statement, 2, hardwareParams.GetHardwareType()) == false
+			|| Bind(statement, 3, hardwareParams.GetName()) == false
+			|| Bind(statement, 4, arg1) == false
+			|| Bind(statement, 5, arg2) == false
+			|| Bind(statement, 6, arg3) == false
+			|| Bind(statement, 7, arg4) == false
+			|| Bind(statement, 8, arg5) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	void SQLite::AllHardwareParams(std::map<ControlID, Hardware::HardwareParams*>& hardwareParams)
 	{
-		const char* query = "SELECT controlid, hardwaretype, name, arg1, arg2, arg3, arg4, arg5 FROM hardware ORDER BY controlid;";
-		Execute(query, CallbackAllHardwareParams, &hardwareParams);
-	}
-
-	// callback read hardwareparams
-	int SQLite::CallbackAllHardwareParams(void* v, int argc, char **argv, __attribute__((unused)) char **colName)
-	{
-		map<ControlID,HardwareParams*>* hardwareParams = static_cast<map<ControlID,HardwareParams*>*>(v);
-		if (argc != 8)
+		sqlite3_stmt* statement = GetStatement(StatementAllHardwareParams);
+		if (statement == nullptr)
 		{
-			return 0;
+			return;
 		}
-		ControlID controlID = Utils::Utils::StringToInteger(argv[0]);
-
-		HardwareParams* params = new HardwareParams(controlID, static_cast<HardwareType>(Utils::Utils::StringToInteger(argv[1])), argv[2], argv[3], argv[4], argv[5], argv[6], argv[7]);
-		(*hardwareParams)[controlID] = params;
-		return 0;
+		while (sqlite3_step(statement) == SQLITE_ROW)
+		{
+			ControlID controlID = sqlite3_column_int(statement, 0);
+			HardwareParams* params = new HardwareParams(controlID,
+				static_cast<HardwareType>(sqlite3_column_int(statement, 1)),
+				ColumnText(statement, 2),
+				ColumnText(statement, 3),
+				ColumnText(statement, 4),
+				ColumnText(statement, 5),
+				ColumnText(statement, 6),
+				ColumnText(statement, 7));
+			hardwareParams[controlID] = params;
+		}
+		LogStatement(statement);
+		sqlite3_reset(statement);
 	}
 
 	// delete control
 	void SQLite::DeleteHardwareParams(const ControlID controlID)
 	{
-		string query = "DELETE FROM hardware WHERE controlid = " + to_string(controlID) + ";";
-		Execute(query);
+		sqlite3_stmt* statement = GetStatement(StatementDeleteHardwareParams);
+		if (statement == nullptr
+			|| Bind(statement, 1, controlID) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	// save DataModelobject
 	void SQLite::SaveObject(const ObjectType objectType, const ObjectID objectID, const std::string& name, const std::string& object)
 	{
-		string query = "INSERT OR REPLACE INTO objects (objecttype, objectid, name, object) VALUES ("
-			+ to_string(objectType) + ", "
-			+ to_string(objectID) + ", '"
-			+ EscapeString(name) + "', '"
-			+ EscapeString(object) + "');";
-		Execute(query);
+		sqlite3_stmt* statement = GetStatement(StatementSaveObject);
+		if (statement == nullptr
+			|| Bind(statement, 1, objectType) == false
+			|| Bind(statement, 2, objectID) == false
+			|| Bind(statement, 3, name) == false
+			|| Bind(statement, 4, object) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	// delete DataModelobject
 	void SQLite::DeleteObject(const ObjectType objectType, const ObjectID objectID)
 	{
-		string query = "DELETE FROM objects WHERE objecttype = " + to_string(objectType)
-			+ " AND objectid = " + to_string(objectID) + ";";
-		Execute(query);
+		sqlite3_stmt* statement = GetStatement(StatementDeleteObject);
+		if (statement == nullptr
+			|| Bind(statement, 1, objectType) == false
+			|| Bind(statement, 2, objectID) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	// read DataModelobjects
 	void SQLite::ObjectsOfType(const ObjectType objectType, vector<string>& objects)
 	{
-		string query = "SELECT object FROM objects WHERE objecttype = " + to_string(objectType) + " ORDER BY objectid;";
-		Execute(query, CallbackStringVector, &objects);
+		sqlite3_stmt* statement = GetStatement(StatementObjectsOfType);
+		if (statement == nullptr
+			|| Bind(statement, 1, objectType) == false)
+		{
+			return;
+		}
+		Step(statement, objects);
+	}
+
+	void SQLite::AllObjects(map<ObjectType,vector<string>>& objects)
+	{
+		sqlite3_stmt* statement = GetStatement(StatementAllObjects);
+		if (statement == nullptr)
+		{
+			return;
+		}
+		while (sqlite3_step(statement) == SQLITE_ROW)
+		{
+			const ObjectType objectType = static_cast<ObjectType>(sqlite3_column_int(statement, 0));
+			objects[objectType].push_back(ColumnText(statement, 1));
+		}
+		LogStatement(statement);
+		sqlite3_reset(statement);
 	}
 
 	// save DataModelrelation
 	void SQLite::SaveRelation(const DataModel::Relation::Type type, const ObjectID objectID1, const ObjectType objectType2, const ObjectID objectID2, const Priority priority, const std::string& relation)
 	{
-		string query = "INSERT OR REPLACE INTO relations (type, objectid1, objecttype2, objectid2, priority, relation) VALUES ("
-			+ to_string(type) + ", "
-			+ to_string(objectID1) + ", "
-			+ to_string(objectType2) + ", "
-			+ to_string(objectID2) + ", "
-			+ to_string(priority) + ", '"
-			+ EscapeString(relation) + "');";
-		Execute(query);
+		sqlite3_stmt* statement = GetStatement(StatementSaveRelation);
+		if (statement == nullptr
+			|| Bind(statement, 1, type) == false
+			|| Bind(statement, 2, objectID1) == false
+			|| Bind(statement, 3, objectType2) == false
+			|| Bind(statement, 4, objectID2) == false
+			|| Bind(statement, 5, priority) == false
+			|| Bind(statement, 6, relation) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	// delete DataModelrelaton
 	void SQLite::DeleteRelationsFrom(const DataModel::Relation::Type type, const ObjectID objectID)
 	{
-		string query = "DELETE FROM relations WHERE type = " + to_string(type)
-			+ " AND objectid1 = " + to_string(objectID) + ";";
-		Execute(query);
+		sqlite3_stmt* statement = GetStatement(StatementDeleteRelationsFrom);
+		if (statement == nullptr
+			|| Bind(statement, 1, type) == false
+			|| Bind(statement, 2, objectID) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	// delete DataModelrelaton
 	void SQLite::DeleteRelationsTo(const ObjectType objectType, const ObjectID objectID)
 	{
-		string query = "DELETE FROM relations WHERE objecttype2 = " + to_string(objectType)
-			+ " AND objectid2 = " + to_string(objectID) + ";";
-		Execute(query);
+		sqlite3_stmt* statement = GetStatement(StatementDeleteRelationsTo);
+		if (statement == nullptr
+			|| Bind(statement, 1, objectType) == false
+			|| Bind(statement, 2, objectID) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	// read DataModelrelations
 	void SQLite::RelationsFrom(const DataModel::Relation::Type type, const ObjectID objectID, vector<string>& relations)
 	{
-		string query = "SELECT relation FROM relations WHERE type = " + to_string(type)
-			+ " AND objectid1 = " + to_string(objectID) + " ORDER BY priority ASC;";
-		Execute(query, CallbackStringVector, &relations);
+		sqlite3_stmt* statement = GetStatement(StatementRelationsFrom);
+		if (statement == nullptr
+			|| Bind(statement, 1, type) == false
+			|| Bind(statement, 2, objectID) == false)
+		{
+			return;
+		}
+		Step(statement, relations);
+	}
+
+	void SQLite::AllRelations(map<std::pair<DataModel::Relation::Type,ObjectID>,vector<string>>& relations)
+	{
+		sqlite3_stmt* statement = GetStatement(StatementAllRelations);
+		if (statement == nullptr)
+		{
+			return;
+		}
+		while (sqlite3_step(statement) == SQLITE_ROW)
+		{
+			const DataModel::Relation::Type type = static_cast<DataModel::Relation::Type>(sqlite3_column_int(statement, 0));
+			const ObjectID objectID = static_cast<ObjectID>(sqlite3_column_int(statement, 1));
+			relations[std::make_pair(type, objectID)].push_back(ColumnText(statement, 2));
+		}
+		LogStatement(statement);
+		sqlite3_reset(statement);
 	}
 
 	// read DataModelrelations
 	void SQLite::RelationsTo(const ObjectType objectType, const ObjectID objectID, vector<string>& relations)
 	{
-		string query = "SELECT relation FROM relations WHERE objecttype2 = " + to_string(objectType)
-			+ " AND objectid2 = " + to_string(objectID) + ";";
-		Execute(query, CallbackStringVector, &relations);
+		sqlite3_stmt* statement = GetStatement(StatementRelationsTo);
+		if (statement == nullptr
+			|| Bind(statement, 1, objectType) == false
+			|| Bind(statement, 2, objectID) == false)
+		{
+			return;
+		}
+		Step(statement, relations);
 	}
 
 	void SQLite::SaveSetting(const string& key, const string& value)
 	{
-		Execute("INSERT OR REPLACE INTO settings (key, value) values ('" + EscapeString(key) + "', '" + EscapeString(value) + "');");
+		sqlite3_stmt* statement = GetStatement(StatementSaveSetting);
+		if (statement == nullptr
+			|| Bind(statement, 1, key) == false
+			|| Bind(statement, 2, value) == false)
+		{
+			return;
+		}
+		Step(statement);
 	}
 
 	string SQLite::GetSetting(const string& key)
 	{
+		sqlite3_stmt* statement = GetStatement(StatementGetSetting);
+		if (statement == nullptr
+			|| Bind(statement, 1, key) == false)
+		{
+			return "";
+		}
 		vector<string> values;
-		string query = "SELECT value FROM settings WHERE key = '" + EscapeString(key) + "';";
-		bool ret = Execute(query, CallbackStringVector, &values);
+		bool ret = Step(statement, values);
 		if (ret == false || values.size() == 0)
 		{
 			return "";
@@ -477,16 +603,118 @@ namespace Storage
 		return values[0];
 	}
 
-	// callback read all DataModel objects/relations
-	int SQLite::CallbackStringVector(void* v, int argc, char **argv, __attribute__((unused)) char **colName)
+	sqlite3_stmt* SQLite::GetStatement(const StatementType type)
 	{
-		vector<string>* objects = static_cast<vector<string>*>(v);
-		if (argc != 1)
+		if (db == nullptr)
 		{
-			return 0;
+			return nullptr;
 		}
-		objects->push_back(argv[0]);
-		return 0;
+
+		sqlite3_stmt*& statement = statements[type];
+		if (statement != nullptr)
+		{
+			sqlite3_reset(statement);
+			sqlite3_clear_bindings(statement);
+			return statement;
+		}
+
+		int rc = sqlite3_prepare_v2(db, statementQueries[type], -1, &statement, nullptr);
+		if (rc == SQLITE_OK)
+		{
+			return statement;
+		}
+
+		logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), statementQueries[type]);
+		sqlite3_finalize(statement);
+		statement = nullptr;
+		return nullptr;
+	}
+
+	void SQLite::FinalizeStatements()
+	{
+		for (sqlite3_stmt*& statement : statements)
+		{
+			if (statement == nullptr)
+			{
+				continue;
+			}
+			sqlite3_finalize(statement);
+			statement = nullptr;
+		}
+	}
+
+	bool SQLite::Bind(sqlite3_stmt* statement, const int index, const int value)
+	{
+		int rc = sqlite3_bind_int(statement, index, value);
+		if (rc == SQLITE_OK)
+		{
+			return true;
+		}
+		logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), sqlite3_sql(statement));
+		return false;
+	}
+
+	bool SQLite::Bind(sqlite3_stmt* statement, const int index, const string& value)
+	{
+		int rc = sqlite3_bind_text(statement, index, value.c_str(), value.size(), SQLITE_STATIC);
+		if (rc == SQLITE_OK)
+		{
+			return true;
+		}
+		logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), sqlite3_sql(statement));
+		return false;
+	}
+
+	bool SQLite::Step(sqlite3_stmt* statement)
+	{
+		int rc = sqlite3_step(statement);
+		LogStatement(statement);
+		sqlite3_reset(statement);
+		if (rc == SQLITE_DONE)
+		{
+			return true;
+		}
+		logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), sqlite3_sql(statement));
+		return false;
+	}
+
+	bool SQLite::Step(sqlite3_stmt* statement, vector<string>& result)
+	{
+		int rc;
+		while ((rc = sqlite3_step(statement)) == SQLITE_ROW)
+		{
+			result.push_back(ColumnText(statement, 0));
+		}
+		LogStatement(statement);
+		sqlite3_reset(statement);
+		if (rc == SQLITE_DONE)
+		{
+			return true;
+		}
+		logger->Error(Languages::TextSQLiteErrorQuery, sqlite3_errmsg(db), sqlite3_sql(statement));
+		return false;
+	}
+
+	void SQLite::LogStatement(sqlite3_stmt* statement)
+	{
+		if (Logger::Logger::GetLogLevel() < Logger::Logger::LevelDebug)
+		{
+			return;
+		}
+		char* query = sqlite3_expanded_sql(statement);
+		const char* constQuery = query;
+		logger->Debug(Languages::TextQuery, constQuery, sqlite3_changes(db));
+		sqlite3_free(query);
+	}
+
+	string SQLite::ColumnText(sqlite3_stmt* statement, const int column)
+	{
+		const char* text = reinterpret_cast<const char*>(sqlite3_column_text(statement, column));
+		if (text == nullptr)
+		{
+			return "";
+		}
+		return string(text, sqlite3_column_bytes(statement, column));
 	}
 
 	void SQLite::StartTransaction()
@@ -520,18 +748,4 @@ namespace Storage
 		sqlite3_free(dbError);
 		return false;
 	}
-
-	string SQLite::EscapeString(const string& input)
-	{
-		string output;
-		for (size_t i = 0; i < input.size(); ++i)
-		{
-			if (input[i] == '\'')
-			{
-				output += "'";
-			}
-			output += input[i];
-		}
-		return output;
-	}
 } // namespace Storage
@@ -44,25 +44,61 @@ namespace Storage
 			void SaveObject(const ObjectType objectType, const ObjectID objectID, const std::string& name, const std::string& object) override;
 			void DeleteObject(const ObjectType objectType, const ObjectID objectID) override;
 			void ObjectsOfType(const ObjectType objectType, std::vector<std::string>& objects) override;
+			void AllObjects(std::map<ObjectType,std::vector<std::string>>& objects) override;
 			void SaveRelation(const DataModel::Relation::Type type, const ObjectID objectID1, const ObjectType objectType2, const ObjectID objectID2, const Priority priority, const std::string& relation) override;
 			void DeleteRelationsFrom(const DataModel::Relation::Type type, const ObjectID objectID) override;
 			void DeleteRelationsTo(const ObjectType objectType, const ObjectID objectID) override;
 			void RelationsFrom(const DataModel::Relation::Type type, const ObjectID objectID, std::vector<std::string>& relations) override;
 			void RelationsTo(const ObjectType objectType, const ObjectID objectID, std::vector<std::string>& relations) override;
+			void AllRelations(std::map<std::pair<DataModel::Relation::Type,ObjectID>,std::vector<std::string>>& relations) override;
 			void SaveSetting(const std::string& key, const std::string& value) override;
 			std::string GetSetting(const std::string& key) override;
 			void StartTransaction() override;
 			void CommitTransaction() override;
 
 		private:
+			enum StatementType : unsigned char
+			{
+				StatementSaveHardwareParams = 0,
+				StatementAllHardwareParams,
+				StatementDeleteHardwareParams,
+				StatementSaveObject,
+				StatementDeleteObject,
+				StatementObjectsOfType,
+				StatementAllObjects,
+				StatementSaveRelation,
+				StatementDeleteRelationsFrom,
+				StatementDeleteRelationsTo,
+				StatementRelationsFrom,
+				StatementRelationsTo,
+				StatementAllRelations,
+				StatementSaveSetting,
+				StatementGetSetting,
+				NumberOfStatements
+			};
+
+			static const char* statementQueries[NumberOfStatements];
+
 			sqlite3 *db;
 			const std::string filename;
 			Logger::Logger* logger;
 			unsigned int keepBackups;
+			sqlite3_stmt* statements[NumberOfStatements];
 
 			void RemoveOldBackupFiles();
 			bool Execute(const std::string& query, sqlite3_callback callback = nullptr, void* result = nullptr) { return Execute(query.c_str(), callback, result); }
 			bool Execute(const char* query, sqlite3_callback callback, void* result);
+
+			// returns the prepared statement reset and with cleared bindings, nullptr on error
+			sqlite3_stmt* GetStatement(const StatementType type);
+			void FinalizeStatements();
+			bool Bind(sqlite3_stmt* statement, const int index, const int value);
+			// the text is bound without a copy, value must live until the statement is stepped
+			bool Bind(sqlite3_stmt* statement, const int index, const std::string& value);
+			bool Bind(sqlite3_stmt* statement, const int index, std::string&& value) = delete;
+			bool Step(sqlite3_stmt* statement);
+			bool Step(sqlite3_stmt* statement, std::vector<std::string>& result);
+			void LogStatement(sqlite3_stmt* statement);
 			bool DropTable(const std::string table);
 			bool CreateTableHardware();
 			bool CreateTableObjects();
@@ -74,9 +110,7 @@ namespace Storage
 
 			static int CallbackTableInfo(void *v, int argc, char **argv, char **colName);
 			static int CallbackListTables(void *v, int argc, char **argv, char **colName);
-			static int CallbackAllHardwareParams(void *v, int argc, char **argv, char **colName);
-			static int CallbackStringVector(void* v, int argc, char **argv, char **colName);
-			static std::string EscapeString(const std::string& input);
+			static std::string ColumnText(sqlite3_stmt* statement, const int column);
 	};
 
 	extern "C" SQLite* create_Sqlite(const StorageParams* params);
@@ -21,7 +21,10 @@ along with RailControl; see the file LICENCE. If not see
 #ifndef AMALGAMATION
 #include <dlfcn.h>              // dl*
 #endif
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Logger/Logger.h"
@@ -47,6 +50,8 @@ using std::vector;
 
 namespace Storage
 {
+	const size_t StorageHandler::MinObjectsPerThread;
+
 	StorageHandler::StorageHandler(Manager* manager, const StorageParams* params)
 	:	manager(manager),
 		createStorage(nullptr),
@@ -55,7 +60,10 @@ namespace Storage
 #ifndef AMALGAMATION
 		dlhandle(nullptr),
 #endif
-		transactionRunning(false)
+		transactionRunning(false),
+		bulkLoaded(false),
+		flushInterval(params->flushInterval),
+		run(false)
 	{
 #ifdef AMALGAMATION
 		createStorage = (Storage::StorageInterface* (*)(const Storage::StorageParams*))(&create_Sqlite);
@@ -103,10 +111,28 @@ namespace Storage
 		{
 			instance = createStorage(params);
 		}
+
+		if (instance == nullptr || flushInterval == 0)
+		{
+			return;
+		}
+		run = true;
+		writerThread = std::thread(&StorageHandler::Writer, this);
 	}
 
 	StorageHandler::~StorageHandler()
 	{
+		if (writerThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> guard(pendingMutex);
+				run = false;
+			}
+			pendingAvailable.notify_one();
+			writerThread.join();
+		}
+		Flush();
+
 		// stop storage
 		if (instance)
 		{
@@ -130,6 +156,7 @@ namespace Storage
 		{
 			return;
 		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->SaveHardwareParams(hardwareParams);
 		CommitTransactionInternal();
@@ -141,6 +168,7 @@ namespace Storage
 		{
 			return;
 		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		instance->AllHardwareParams(hardwareParams);
 	}
 
@@ -150,25 +178,73 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteHardwareParams(controlID);
 		CommitTransactionInternal();
 	}
 
+	template<class ID, class T, class Create>
+	void StorageHandler::Deserialize(const ObjectType objectType, const Languages::TextSelector typeName, map<ID,T*>& objects, Create create)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		vector<string> serialized;
+		ObjectsOfType(objectType, serialized);
+		vector<T*> deserialized(serialized.size(), nullptr);
+
+		auto deserializeRange = [&serialized, &deserialized, &create](const size_t from, const size_t to)
+		{
+			for (size_t i = from; i < to; ++i)
+			{
+				deserialized[i] = create(serialized[i]);
+			}
+		};
+
+		size_t nrOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		nrOfThreads = std::min(nrOfThreads, (serialized.size() + MinObjectsPerThread - 1) / MinObjectsPerThread);
+		if (nrOfThreads <= 1)
+		{
+			deserializeRange(0, serialized.size());
+		}
+		else
+		{
+			const size_t chunkSize = (serialized.size() + nrOfThreads - 1) / nrOfThreads;
+			vector<std::thread> threads;
+			for (size_t from = chunkSize; from < serialized.size(); from += chunkSize)
+			{
+				threads.push_back(std::thread(deserializeRange, from, std::min(from + chunkSize, serialized.size())));
+			}
+			deserializeRange(0, chunkSize);
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		}
+
+		for (T* object : deserialized)
+		{
+			if (object == nullptr)
+			{
+				continue;
+			}
+			objects[object->GetID()] = object;
+		}
+		const unsigned int duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+		Logger::Logger::GetLogger("StorageHandler")->Info(Languages::TextLoadedObjects, Languages::GetText(typeName), objects.size(), duration);
+	}
+
 	void StorageHandler::AllLocos(map<LocoID,DataModel::Loco*>& locos)
 	{
 		if (instance == nullptr)
 		{
 			return;
 		}
-		vector<string> objects;
-		instance->ObjectsOfType(ObjectTypeLoco, objects);
-		for(auto object : objects)
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeLoco, Languages::TextLocos, locos, [this](const string& object) { return new Loco(manager, object); });
+		for (auto loco : locos)
 		{
-			Loco* loco = new Loco(manager, object);
-			const RouteID locoID = loco->GetID();
-			loco->AssignSlaves(RelationsFrom(DataModel::Relation::TypeLocoSlave, locoID));
-			locos[locoID] = loco;
+			loco.second->AssignSlaves(RelationsFrom(DataModel::Relation::TypeLocoSlave, loco.first));
 		}
 	}
 
@@ -178,6 +254,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteRelationsFrom(DataModel::Relation::TypeLocoSlave, locoID);
 		instance->DeleteRelationsTo(ObjectTypeLoco, locoID);
@@ -191,17 +269,8 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> objects;
-		instance->ObjectsOfType(ObjectTypeAccessory, objects);
-		for(auto object : objects)
-		{
-			Accessory* accessory = new Accessory(object);
-			if (accessory == nullptr)
-			{
-				continue;
-			}
-			accessories[accessory->GetID()] = accessory;
-		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeAccessory, Languages::TextAccessories, accessories, [](const string& object) { return new Accessory(object); });
 	}
 
 	void StorageHandler::DeleteAccessory(const AccessoryID accessoryID)
@@ -210,6 +279,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteObject(ObjectTypeAccessory, accessoryID);
 		CommitTransactionInternal();
@@ -221,17 +292,8 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> objects;
-		instance->ObjectsOfType(ObjectTypeFeedback, objects);
-		for(auto object : objects)
-		{
-			Feedback* feedback = new Feedback(manager, object);
-			if (feedback == nullptr)
-			{
-				continue;
-			}
-			feedbacks[feedback->GetID()] = feedback;
-		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeFeedback, Languages::TextFeedbacks, feedbacks, [this](const string& object) { return new Feedback(manager, object); });
 	}
 
 	void StorageHandler::DeleteFeedback(const FeedbackID feedbackID)
@@ -240,6 +302,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteObject(ObjectTypeFeedback, feedbackID);
 		CommitTransactionInternal();
@@ -251,17 +315,8 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> objects;
-		instance->ObjectsOfType(ObjectTypeTrack, objects);
-		for(auto object : objects)
-		{
-			Track* track = new Track(manager, object);
-			if (track == nullptr)
-			{
-				continue;
-			}
-			tracks[track->GetID()] = track;
-		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeTrack, Languages::TextTracks, tracks, [this](const string& object) { return new Track(manager, object); });
 	}
 
 	void StorageHandler::DeleteTrack(const TrackID trackID)
@@ -270,6 +325,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteRelationsTo(ObjectTypeTrack, trackID);
 		instance->DeleteObject(ObjectTypeTrack, trackID);
@@ -282,17 +339,8 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> objects;
-		instance->ObjectsOfType(ObjectTypeSwitch, objects);
-		for(auto object : objects)
-		{
-			Switch* mySwitch = new Switch(object);
-			if (mySwitch == nullptr)
-			{
-				continue;
-			}
-			switches[mySwitch->GetID()] = mySwitch;
-		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeSwitch, Languages::TextSwitches, switches, [](const string& object) { return new Switch(object); });
 	}
 
 	void StorageHandler::DeleteSwitch(const SwitchID switchID)
@@ -301,6 +349,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteObject(ObjectTypeSwitch, switchID);
 		CommitTransactionInternal();
@@ -312,15 +362,14 @@ namespace Storage
 		{
 			return;
 		}
-		string serialized = route.Serialize();
-		StartTransactionInternal();
-		const RouteID routeID = route.GetID();
-		instance->SaveObject(ObjectTypeRoute, routeID, route.GetName(), serialized);
-		instance->DeleteRelationsFrom(DataModel::Relation::TypeRouteAtLock, routeID);
-		SaveRelations(route.GetRelationsAtLock());
-		instance->DeleteRelationsFrom(DataModel::Relation::TypeRouteAtUnlock, routeID);
-		SaveRelations(route.GetRelationsAtUnlock());
-		CommitTransactionInternal();
+		PendingObject pending;
+		pending.objectType = ObjectTypeRoute;
+		pending.objectID = route.GetID();
+		pending.name = route.GetName();
+		pending.serialized = route.Serialize();
+		AddRelations(pending, DataModel::Relation::TypeRouteAtLock, route.GetRelationsAtLock());
+		AddRelations(pending, DataModel::Relation::TypeRouteAtUnlock, route.GetRelationsAtUnlock());
+		Enqueue(pending);
 	}
 
 	void StorageHandler::Save(const DataModel::Loco& loco)
@@ -329,13 +378,13 @@ namespace Storage
 		{
 			return;
 		}
-		string serialized = loco.Serialize();
-		StartTransactionInternal();
-		const LocoID locoID = loco.GetID();
-		instance->SaveObject(ObjectTypeLoco, locoID, loco.GetName(), serialized);
-		instance->DeleteRelationsFrom(DataModel::Relation::TypeLocoSlave, locoID);
-		SaveRelations(loco.GetSlaves());
-		CommitTransactionInternal();
+		PendingObject pending;
+		pending.objectType = ObjectTypeLoco;
+		pending.objectID = loco.GetID();
+		pending.name = loco.GetName();
+		pending.serialized = loco.Serialize();
+		AddRelations(pending, DataModel::Relation::TypeLocoSlave, loco.GetSlaves());
+		Enqueue(pending);
 	}
 
 	void StorageHandler::Save(const DataModel::Cluster& cluster)
@@ -344,15 +393,14 @@ namespace Storage
 		{
 			return;
 		}
-		string serialized = cluster.Serialize();
-		StartTransactionInternal();
-		const ClusterID clusterID = cluster.GetID();
-		instance->SaveObject(ObjectTypeCluster, clusterID, cluster.GetName(), serialized);
-		instance->DeleteRelationsFrom(DataModel::Relation::TypeClusterTrack, clusterID);
-		SaveRelations(cluster.GetTracks());
-		instance->DeleteRelationsFrom(DataModel::Relation::TypeClusterSignal, clusterID);
-		SaveRelations(cluster.GetSignals());
-		CommitTransactionInternal();
+		PendingObject pending;
+		pending.objectType = ObjectTypeCluster;
+		pending.objectID = cluster.GetID();
+		pending.name = cluster.GetName();
+		pending.serialized = cluster.Serialize();
+		AddRelations(pending, DataModel::Relation::TypeClusterTrack, cluster.GetTracks());
+		AddRelations(pending, DataModel::Relation::TypeClusterSignal, cluster.GetSignals());
+		Enqueue(pending);
 	}
 
 	void StorageHandler::AllRoutes(std::map<RouteID,DataModel::Route*>& routes)
@@ -361,18 +409,15 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> objects;
-		instance->ObjectsOfType(ObjectTypeRoute, objects);
-		for (auto object : objects) {
-			Route* route = new Route(manager, object);
-			if (route == nullptr)
-			{
-				continue;
-			}
-			const RouteID routeID = route->GetID();
-			route->AssignRelationsAtLock(RelationsFrom(Relation::TypeRouteAtLock, routeID));
-			route->AssignRelationsAtUnlock(RelationsFrom(Relation::TypeRouteAtUnlock, routeID));
-			routes[routeID] = route;
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeRoute, Languages::TextRoutes, routes, [this](const string& object) { return new Route(manager, object); });
+		// in order of the IDs, so the routes of a track are always in the same order
+		for (auto route : routes)
+		{
+			const RouteID routeID = route.first;
+			route.second->AddToFromTrack();
+			route.second->AssignRelationsAtLock(RelationsFrom(Relation::TypeRouteAtLock, routeID));
+			route.second->AssignRelationsAtUnlock(RelationsFrom(Relation::TypeRouteAtUnlock, routeID));
 		}
 	}
 
@@ -382,6 +427,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteRelationsFrom(DataModel::Relation::TypeRouteAtLock, routeID);
 		instance->DeleteRelationsFrom(DataModel::Relation::TypeRouteAtUnlock, routeID);
@@ -395,16 +442,8 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> objects;
-		instance->ObjectsOfType(ObjectTypeLayer, objects);
-		for(auto object : objects) {
-			Layer* layer = new Layer(object);
-			if (layer == nullptr)
-			{
-				continue;
-			}
-			layers[layer->GetID()] = layer;
-		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeLayer, Languages::TextLayers, layers, [](const string& object) { return new Layer(object); });
 	}
 
 	void StorageHandler::DeleteLayer(const LayerID layerID)
@@ -413,6 +452,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteObject(ObjectTypeLayer, layerID);
 		CommitTransactionInternal();
@@ -424,17 +465,8 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> serializedObjects;
-		instance->ObjectsOfType(ObjectTypeSignal, serializedObjects);
-		for(auto serializedObject : serializedObjects)
-		{
-			Signal* signal = new Signal(manager, serializedObject);
-			if (signal == nullptr)
-			{
-				continue;
-			}
-			signals[signal->GetID()] = signal;
-		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeSignal, Languages::TextSignals, signals, [this](const string& object) { return new Signal(manager, object); });
 	}
 
 	void StorageHandler::DeleteSignal(const SignalID signalID)
@@ -443,6 +475,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteRelationsTo(ObjectTypeSignal, signalID);
 		instance->DeleteObject(ObjectTypeSignal, signalID);
@@ -455,19 +489,12 @@ namespace Storage
 		{
 			return;
 		}
-		vector<string> serializedObjects;
-		instance->ObjectsOfType(ObjectTypeCluster, serializedObjects);
-		for(auto serializedObject : serializedObjects)
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		Deserialize(ObjectTypeCluster, Languages::TextClusters, clusters, [](const string& object) { return new Cluster(object); });
+		for (auto cluster : clusters)
 		{
-			Cluster* cluster = new Cluster(serializedObject);
-			if (cluster == nullptr)
-			{
-				continue;
-			}
-			const ClusterID clusterID = cluster->GetID();
-			cluster->AssignTracks(RelationsFrom(DataModel::Relation::TypeClusterTrack, clusterID));
-			cluster->AssignSignals(RelationsFrom(DataModel::Relation::TypeClusterSignal, clusterID));
-			clusters[cluster->GetID()] = cluster;
+			cluster.second->AssignTracks(RelationsFrom(DataModel::Relation::TypeClusterTrack, cluster.first));
+			cluster.second->AssignSignals(RelationsFrom(DataModel::Relation::TypeClusterSignal, cluster.first));
 		}
 	}
 
@@ -477,6 +504,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->DeleteObject(ObjectTypeCluster, clusterID);
 		CommitTransactionInternal();
@@ -488,6 +517,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		StartTransactionInternal();
 		instance->SaveSetting(key, value);
 		CommitTransactionInternal();
@@ -499,6 +530,7 @@ namespace Storage
 		{
 			return "";
 		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		return instance->GetSetting(key);
 	}
 
@@ -508,6 +540,7 @@ namespace Storage
 		{
 			return;
 		}
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		transactionRunning = true;
 		instance->StartTransaction();
 	}
@@ -518,6 +551,8 @@ namespace Storage
 		{
 			return;
 		}
+		Flush();
+		std::lock_guard<std::mutex> guard(instanceMutex);
 		transactionRunning = false;
 		instance->CommitTransaction();
 	}
@@ -540,19 +575,156 @@ namespace Storage
 		instance->CommitTransaction();
 	}
 
-	void StorageHandler::SaveRelations(const vector<DataModel::Relation*> relations)
+	void StorageHandler::AddRelations(PendingObject& pending, const DataModel::Relation::Type type, const vector<DataModel::Relation*>& relations)
 	{
+		pending.relationTypes.push_back(type);
 		for (auto relation : relations)
 		{
-			string serializedRelation = relation->Serialize();
-			instance->SaveRelation(relation->GetType(), relation->ObjectID1(), relation->ObjectType2(), relation->ObjectID2(), relation->GetPriority(), serializedRelation);
+			PendingRelation pendingRelation;
+			pendingRelation.type = relation->GetType();
+			pendingRelation.objectID1 = relation->ObjectID1();
+			pendingRelation.objectType2 = relation->ObjectType2();
+			pendingRelation.objectID2 = relation->ObjectID2();
+			pendingRelation.priority = relation->GetPriority();
+			pendingRelation.serialized = relation->Serialize();
+			pending.relations.push_back(pendingRelation);
+		}
+	}
+
+	void StorageHandler::Enqueue(PendingObject& pending)
+	{
+		bool wasEmpty;
+		{
+			std::lock_guard<std::mutex> guard(pendingMutex);
+			wasEmpty = pendingObjects.empty();
+			pendingObjects[std::make_pair(pending.objectType, pending.objectID)] = std::move(pending);
+		}
+		if (run == false)
+		{
+			Flush();
+			return;
+		}
+		if (wasEmpty)
+		{
+			pendingAvailable.notify_one();
+		}
+	}
+
+	void StorageHandler::Flush()
+	{
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		std::map<std::pair<ObjectType,ObjectID>,PendingObject> objects;
+		{
+			std::lock_guard<std::mutex> pendingGuard(pendingMutex);
+			objects.swap(pendingObjects);
+		}
+		if (objects.empty() || instance == nullptr)
+		{
+			return;
+		}
+
+		StartTransactionInternal();
+		for (auto& object : objects)
+		{
+			const PendingObject& pending = object.second;
+			instance->SaveObject(pending.objectType, pending.objectID, pending.name, pending.serialized);
+			for (auto type : pending.relationTypes)
+			{
+				instance->DeleteRelationsFrom(type, pending.objectID);
+			}
+			for (auto& relation : pending.relations)
+			{
+				instance->SaveRelation(relation.type, relation.objectID1, relation.objectType2, relation.objectID2, relation.priority, relation.serialized);
+			}
 		}
+		CommitTransactionInternal();
+	}
+
+	void StorageHandler::Writer()
+	{
+		Utils::Utils::SetThreadName("Storage");
+		std::unique_lock<std::mutex> lock(pendingMutex);
+		while (run)
+		{
+			if (pendingObjects.empty())
+			{
+				pendingAvailable.wait(lock);
+				continue;
+			}
+
+			// collect further saves, only a stop request wakes us up earlier
+			pendingAvailable.wait_for(lock, std::chrono::milliseconds(flushInterval));
+			lock.unlock();
+			Flush();
+			lock.lock();
+		}
+	}
+
+	void StorageHandler::BulkLoad()
+	{
+		if (instance == nullptr)
+		{
+			return;
+		}
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		instance->AllObjects(bulkObjects);
+		instance->AllRelations(bulkRelations);
+		bulkLoaded = true;
+
+		size_t nrOfObjects = 0;
+		for (auto& objects : bulkObjects)
+		{
+			nrOfObjects += objects.second.size();
+		}
+		size_t nrOfRelations = 0;
+		for (auto& relations : bulkRelations)
+		{
+			nrOfRelations += relations.second.size();
+		}
+		const unsigned int duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+		Logger::Logger::GetLogger("StorageHandler")->Info(Languages::TextReadObjectsAndRelations, nrOfObjects, nrOfRelations, duration);
+	}
+
+	void StorageHandler::FinishBulkLoad()
+	{
+		std::lock_guard<std::mutex> guard(instanceMutex);
+		bulkLoaded = false;
+		bulkObjects.clear();
+		bulkRelations.clear();
+	}
+
+	void StorageHandler::ObjectsOfType(const ObjectType objectType, vector<string>& objects)
+	{
+		if (bulkLoaded == false)
+		{
+			instance->ObjectsOfType(objectType, objects);
+			return;
+		}
+		auto it = bulkObjects.find(objectType);
+		if (it == bulkObjects.end())
+		{
+			return;
+		}
+		objects.swap(it->second);
+		bulkObjects.erase(it);
 	}
 
 	vector<Relation*> StorageHandler::RelationsFrom(const DataModel::Relation::Type type, const ObjectID objectID)
 	{
 		vector<string> relationStrings;
-		instance->RelationsFrom(type, objectID, relationStrings);
+		if (bulkLoaded)
+		{
+			auto it = bulkRelations.find(std::make_pair(type, objectID));
+			if (it != bulkRelations.end())
+			{
+				relationStrings.swap(it->second);
+			}
+		}
+		else
+		{
+			instance->RelationsFrom(type, objectID, relationStrings);
+		}
 		vector<Relation*> output;
 		for (auto relationString : relationStrings)
 		{
@@ -20,12 +20,16 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
-#include <vector>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "DataModel/DataModel.h"
 #include "DataTypes.h"
 #include "Hardware/HardwareParams.h"
+#include "Languages.h"
 #include "Storage/StorageInterface.h"
 #include "Storage/StorageParams.h"
 
@@ -70,10 +74,12 @@ namespace Storage
 				{
 					return;
 				}
-				const std::string serialized = t.Serialize();
-				StartTransactionInternal();
-				instance->SaveObject(t.GetObjectType(), t.GetID(), t.GetName(), serialized);
-				CommitTransactionInternal();
+				PendingObject pending;
+				pending.objectType = t.GetObjectType();
+				pending.objectID = t.GetID();
+				pending.name = t.GetName();
+				pending.serialized = t.Serialize();
+				Enqueue(pending);
 			}
 
 			template <class T> static void Save(StorageHandler* storageHandler, const T* t) { storageHandler->Save(*t); }
@@ -82,11 +88,49 @@ namespace Storage
 			void StartTransaction();
 			void CommitTransaction();
 
+			// writes all pending saves in one transaction
+			void Flush();
+
+			// reads all objects and relations with one query each. Until FinishBulkLoad() is called
+			// the All* methods take their objects and relations from this data instead of querying them.
+			void BulkLoad();
+			void FinishBulkLoad();
+
 		private:
+			struct PendingRelation
+			{
+				DataModel::Relation::Type type;
+				ObjectID objectID1;
+				ObjectType objectType2;
+				ObjectID objectID2;
+				Priority priority;
+				std::string serialized;
+			};
+
+			// snapshot of an object to be saved. The relations of relationTypes are replaced by relations.
+			struct PendingObject
+			{
+				ObjectType objectType;
+				ObjectID objectID;
+				std::string name;
+				std::string serialized;
+				std::vector<DataModel::Relation::Type> relationTypes;
+				std::vector<PendingRelation> relations;
+			};
+
 			void StartTransactionInternal();
 			void CommitTransactionInternal();
-			void SaveRelations(const std::vector<DataModel::Relation*> relations);
+			void AddRelations(PendingObject& pending, const DataModel::Relation::Type type, const std::vector<DataModel::Relation*>& relations);
+			void Enqueue(PendingObject& pending);
+			void Writer();
 			std::vector<DataModel::Relation*> RelationsFrom(const DataModel::Relation::Type type, const ObjectID objectID);
+			void ObjectsOfType(const ObjectType objectType, std::vector<std::string>& objects);
+
+			// deserializes the objects of a type on all cores, objects of the same type must not depend on each other
+			template<class ID, class T, class Create>
+			void Deserialize(const ObjectType objectType, const Languages::TextSelector typeName, std::map<ID,T*>& objects, Create create);
+
+			static const size_t MinObjectsPerThread = 64;
 
 
 			Manager* manager;
@@ -97,6 +141,22 @@ namespace Storage
 			void* dlhandle;
 #endif
 			bool transactionRunning;
+
+			// guards instance and transactionRunning
+			std::mutex instanceMutex;
+
+			// bulk load at startup, guarded by instanceMutex
+			bool bulkLoaded;
+			std::map<ObjectType,std::vector<std::string>> bulkObjects;
+			std::map<std::pair<DataModel::Relation::Type,ObjectID>,std::vector<std::string>> bulkRelations;
+
+			// write behind: repeated saves of the same object are coalesced until the next flush
+			const unsigned int flushInterval;
+			std::mutex pendingMutex;
+			std::condition_variable pendingAvailable;
+			std::map<std::pair<ObjectType,ObjectID>,PendingObject> pendingObjects;
+			volatile bool run;
+			std::thread writerThread;
 	};
 
 } // namespace Storage
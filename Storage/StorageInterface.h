@@ -22,6 +22,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "DataTypes.h"
 #include "Hardware/HardwareParams.h"
@@ -55,6 +56,9 @@ namespace Storage
 			// read datamodelobject
 			virtual void ObjectsOfType(const ObjectType objectType, std::vector<std::string>& objects) = 0;
 
+			// read all datamodelobjects grouped by type
+			virtual void AllObjects(std::map<ObjectType,std::vector<std::string>>& objects) = 0;
+
 			// save datamodelrelation
 			virtual void SaveRelation(const DataModel::Relation::Type type, const ObjectID objectID1, const ObjectType objectType2, const ObjectID objectID2, const Priority priority, const std::string& relation) = 0;
 
@@ -70,6 +74,9 @@ namespace Storage
 			// read datamodelrelation
 			virtual void RelationsTo(const ObjectType objectType, const ObjectID objectID, std::vector<std::string>& relations) = 0;
 
+			// read all datamodelrelations grouped by type and owner, ordered by priority
+			virtual void AllRelations(std::map<std::pair<DataModel::Relation::Type,ObjectID>,std::vector<std::string>>& relations) = 0;
+
 			// save setting
 			virtual void SaveSetting(const std::string& key, const std::string& value) = 0;
 
@@ -28,6 +28,7 @@ namespace Storage {
 		std::string module;
 		std::string filename;
 		unsigned int keepBackups;
+		unsigned int flushInterval; // ms, 0 means write through
 	};
 
 } // namespace Storage
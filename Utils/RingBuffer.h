@@ -0,0 +1,234 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace Utils
+{
+	static const size_t CacheLineSize = 64;
+
+	inline size_t RingBufferSize(const size_t minSize)
+	{
+		size_t out = 2;
+		while (out < minSize)
+		{
+			out <<= 1;
+		}
+		return out;
+	}
+
+	// Bounded multi producer multi consumer ring buffer.
+	// Nobody ever takes a lock. Every cell carries a sequence number that tells
+	// if it is free for the producer of this round or ready for the consumer.
+	template<class T>
+	class MpmcRingBuffer
+	{
+		public:
+			MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+			MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+			MpmcRingBuffer(const size_t minSize)
+			:	size(RingBufferSize(minSize)),
+				mask(size - 1),
+				cells(new Cell[size]),
+				enqueuePos(0),
+				dequeuePos(0)
+			{
+				for (size_t i = 0; i < size; ++i)
+				{
+					cells[i].sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			~MpmcRingBuffer()
+			{
+				delete[] cells;
+			}
+
+			// returns false if the buffer is full, item is only moved from on success
+			bool Push(T&& item)
+			{
+				Cell* cell;
+				size_t pos = enqueuePos.load(std::memory_order_relaxed);
+				while (true)
+				{
+					cell = &cells[pos & mask];
+					const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+					const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+					if (diff == 0)
+					{
+						if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+						continue;
+					}
+					if (diff < 0)
+					{
+						return false;
+					}
+					pos = enqueuePos.load(std::memory_order_relaxed);
+				}
+				cell->data = std::move(item);
+				cell->sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+
+			// returns false if the buffer is empty
+			bool Pop(T& item)
+			{
+				Cell* cell;
+				size_t pos = dequeuePos.load(std::memory_order_relaxed);
+				while (true)
+				{
+					cell = &cells[pos & mask];
+					const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+					const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos + 1);
+					if (diff == 0)
+					{
+						if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+						continue;
+					}
+					if (diff < 0)
+					{
+						return false;
+					}
+					pos = dequeuePos.load(std::memory_order_relaxed);
+				}
+				item = std::move(cell->data);
+				cell->sequence.store(pos + size, std::memory_order_release);
+				return true;
+			}
+
+			// approximation, only for deciding when to wake up somebody
+			size_t Fill() const
+			{
+				return enqueuePos.load(std::memory_order_relaxed) - dequeuePos.load(std::memory_order_relaxed);
+			}
+
+			size_t Size() const { return size; }
+
+		private:
+			struct Cell
+			{
+				std::atomic<size_t> sequence;
+				T data;
+			};
+
+			const size_t size;
+			const size_t mask;
+			Cell* const cells;
+			char padding1[CacheLineSize];
+			std::atomic<size_t> enqueuePos;
+			char padding2[CacheLineSize];
+			std::atomic<size_t> dequeuePos;
+			char padding3[CacheLineSize];
+	};
+
+	// Bounded single producer single consumer ring buffer.
+	// Push must only be called by one thread and Pop by one other thread.
+	// Each side keeps a copy of the position of the other side and only
+	// reloads it when the buffer looks full or empty.
+	template<class T>
+	class SpscRingBuffer
+	{
+		public:
+			SpscRingBuffer(const SpscRingBuffer&) = delete;
+			SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+			SpscRingBuffer(const size_t minSize)
+			:	size(RingBufferSize(minSize)),
+				mask(size - 1),
+				cells(new T[size]),
+				enqueuePos(0),
+				dequeuePosCache(0),
+				dequeuePos(0),
+				enqueuePosCache(0)
+			{
+			}
+
+			~SpscRingBuffer()
+			{
+				delete[] cells;
+			}
+
+			// returns false if the buffer is full, item is only moved from on success
+			bool Push(T&& item)
+			{
+				const size_t pos = enqueuePos.load(std::memory_order_relaxed);
+				if (pos - dequeuePosCache >= size)
+				{
+					dequeuePosCache = dequeuePos.load(std::memory_order_acquire);
+					if (pos - dequeuePosCache >= size)
+					{
+						return false;
+					}
+				}
+				cells[pos & mask] = std::move(item);
+				enqueuePos.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+
+			// returns false if the buffer is empty
+			bool Pop(T& item)
+			{
+				const size_t pos = dequeuePos.load(std::memory_order_relaxed);
+				if (pos == enqueuePosCache)
+				{
+					enqueuePosCache = enqueuePos.load(std::memory_order_acquire);
+					if (pos == enqueuePosCache)
+					{
+						return false;
+					}
+				}
+				item = std::move(cells[pos & mask]);
+				dequeuePos.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+
+			// approximation, only for deciding when to wake up somebody
+			size_t Fill() const
+			{
+				return enqueuePos.load(std::memory_order_relaxed) - dequeuePos.load(std::memory_order_relaxed);
+			}
+
+			size_t Size() const { return size; }
+
+		private:
+			const size_t size;
+			const size_t mask;
+			T* const cells;
+			char padding1[CacheLineSize];
+			// written by the producer
+			std::atomic<size_t> enqueuePos;
+			size_t dequeuePosCache;
+			char padding2[CacheLineSize];
+			// written by the consumer
+			std::atomic<size_t> dequeuePos;
+			size_t enqueuePosCache;
+			char padding3[CacheLineSize];
+	};
+}
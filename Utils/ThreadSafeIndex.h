@@ -0,0 +1,113 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Utils
+{
+	// Hash index from a key (e.g. hardware address) to objects owned by someone else.
+	// More than one object may share a key. In this case the one with the lowest ID is returned.
+	template<class Key, class T>
+	class ThreadSafeIndex
+	{
+		public:
+			ThreadSafeIndex()
+			:	index(),
+				mutex()
+			{}
+
+			void Insert(const Key key, T* object)
+			{
+				if (object == nullptr)
+				{
+					return;
+				}
+				std::lock_guard<std::mutex> guard(mutex);
+				auto range = index.equal_range(key);
+				for (auto it = range.first; it != range.second; ++it)
+				{
+					if (it->second == object)
+					{
+						return;
+					}
+				}
+				index.emplace(key, object);
+			}
+
+			void Erase(const Key key, const T* object)
+			{
+				std::lock_guard<std::mutex> guard(mutex);
+				auto range = index.equal_range(key);
+				for (auto it = range.first; it != range.second; ++it)
+				{
+					if (it->second == object)
+					{
+						index.erase(it);
+						return;
+					}
+				}
+			}
+
+			T* Get(const Key key) const
+			{
+				std::lock_guard<std::mutex> guard(mutex);
+				return GetUnlocked(key);
+			}
+
+			// resolves all keys while taking the lock only once
+			void Get(const std::vector<Key>& keys, std::vector<T*>& out) const
+			{
+				out.resize(keys.size());
+				std::lock_guard<std::mutex> guard(mutex);
+				for (size_t i = 0; i < keys.size(); ++i)
+				{
+					out[i] = GetUnlocked(keys[i]);
+				}
+			}
+
+			void Clear()
+			{
+				std::lock_guard<std::mutex> guard(mutex);
+				index.clear();
+			}
+
+		private:
+			T* GetUnlocked(const Key key) const
+			{
+				auto range = index.equal_range(key);
+				T* out = nullptr;
+				for (auto it = range.first; it != range.second; ++it)
+				{
+					if (out == nullptr || it->second->GetID() < out->GetID())
+					{
+						out = it->second;
+					}
+				}
+				return out;
+			}
+
+			std::unordered_multimap<Key,T*> index;
+			mutable std::mutex mutex;
+	};
+}
@@ -20,70 +20,169 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <queue>
 #include <mutex>
 
+#include "Utils/RingBuffer.h"
+
 namespace Utils
 {
-	template<class T>
+	// what Enqueue does when the queue is full
+	enum QueueOverflow : unsigned char
+	{
+		QueueOverflowReject,
+		QueueOverflowBlock
+	};
+
+	// Bounded queue on a lock free ring buffer (MpmcRingBuffer or SpscRingBuffer).
+	// The mutex is only taken by a thread that has to wait and by the thread
+	// waking it up, so neither side spins or polls while the queue is idle.
+	template<class T, class Buffer = MpmcRingBuffer<T>>
 	class ThreadSafeQueue
 	{
 		public:
-			ThreadSafeQueue(void)
-			:	queue(),
-				mutex(),
+			ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+			ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
+
+			ThreadSafeQueue(const size_t minSize, const QueueOverflow overflow)
+			:	buffer(minSize),
+				overflow(overflow),
+				producersWaiting(false),
+				consumersWaiting(false),
 				run(true)
 			{}
 
-			~ThreadSafeQueue(void)
+			~ThreadSafeQueue()
 			{
 				Terminate();
 			}
 
-			void Enqueue(T t)
+			// returns false if the item has been rejected because the queue is full
+			// or if the queue has been terminated
+			bool Enqueue(T&& item)
 			{
-				std::unique_lock<std::mutex> lock(mutex);
-				queue.push(t);
-				cv.notify_all();
+				while (buffer.Push(std::move(item)) == false)
+				{
+					if (overflow == QueueOverflowReject || run == false)
+					{
+						return false;
+					}
+					std::unique_lock<std::mutex> lock(mutex);
+					producersWaiting = true;
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (buffer.Fill() >= buffer.Size() && run)
+					{
+						spaceAvailable.wait(lock);
+					}
+				}
+				WakeUp(consumersWaiting, itemAvailable);
+				return true;
 			}
 
-			T Dequeue(void)
+			// blocks until an item is available, returns false if the queue has been terminated
+			// the items that are still queued are returned before
+			bool Dequeue(T& item)
 			{
-				std::unique_lock<std::mutex> lock(mutex);
-				while (true)
+				while (TryDequeue(item) == false)
 				{
-					if (queue.empty() == false)
+					if (run == false)
 					{
-						break;
+						return false;
 					}
-					if (run == false)
+					std::unique_lock<std::mutex> lock(mutex);
+					consumersWaiting = true;
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (buffer.Fill() == 0 && run)
+					{
+						itemAvailable.wait(lock);
+					}
+				}
+				return true;
+			}
+
+			// like Dequeue, but returns false also if no item has been available until the deadline
+			template<class Clock, class Duration>
+			bool DequeueUntil(T& item, const std::chrono::time_point<Clock,Duration>& deadline)
+			{
+				while (TryDequeue(item) == false)
+				{
+					if (run == false || Clock::now() >= deadline)
+					{
+						return false;
+					}
+					std::unique_lock<std::mutex> lock(mutex);
+					consumersWaiting = true;
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (buffer.Fill() == 0 && run)
 					{
-						return T();
+						itemAvailable.wait_until(lock, deadline);
 					}
-					cv.wait_for(lock, std::chrono::seconds(1));
 				}
-				T val = queue.front();
-				queue.pop();
-				return val;
+				return true;
+			}
+
+			bool TryDequeue(T& item)
+			{
+				if (buffer.Pop(item) == false)
+				{
+					return false;
+				}
+				// waiting producers are woken when the queue is half empty, so they refill
+				// it in one go instead of switching threads for every single item
+				if (buffer.Fill() <= buffer.Size() / 2)
+				{
+					WakeUp(producersWaiting, spaceAvailable);
+				}
+				return true;
+			}
+
+			bool IsEmpty() const
+			{
+				return buffer.Fill() == 0;
 			}
 
-			bool IsEmpty()
+			bool IsTerminated() const
 			{
-				std::unique_lock<std::mutex> lock(mutex);
-				return queue.empty();
+				return run == false;
 			}
 
 			void Terminate()
 			{
-				run = false;
-				cv.notify_all();
+				{
+					std::lock_guard<std::mutex> guard(mutex);
+					run = false;
+				}
+				itemAvailable.notify_all();
+				spaceAvailable.notify_all();
 			}
 
 		private:
-			std::queue<T> queue;
-			mutable std::mutex mutex;
-			std::condition_variable cv;
-			volatile bool run;
+			// The fence pairs with the one of the waiting thread: either the waiting thread
+			// sees the new fill of the buffer or we see its flag. The flag is reset by the
+			// first thread waking up the waiting ones, so the others do not take the mutex.
+			void WakeUp(std::atomic<bool>& waiting, std::condition_variable& cv)
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (waiting.load(std::memory_order_relaxed) == false || waiting.exchange(false) == false)
+				{
+					return;
+				}
+				{
+					// the waiting thread holds the mutex until it is inside wait
+					std::lock_guard<std::mutex> guard(mutex);
+				}
+				cv.notify_all();
+			}
+
+			Buffer buffer;
+			const QueueOverflow overflow;
+			std::mutex mutex;
+			std::condition_variable itemAvailable;
+			std::condition_variable spaceAvailable;
+			std::atomic<bool> producersWaiting;
+			std::atomic<bool> consumersWaiting;
+			std::atomic<bool> run;
 	};
 }
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <future>
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace Logger
@@ -0,0 +1,173 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Hardware/ZLib.h"
+#include "WebServer/FileCache.h"
+
+using std::shared_ptr;
+using std::string;
+
+namespace WebServer
+{
+	const off_t FileCache::MaxCachedFileSize;
+
+	FileCache::FileCache()
+	{
+		char workingDir[4096];
+		if (getcwd(workingDir, sizeof(workingDir)))
+		{
+			htmlDirectory = workingDir;
+		}
+		htmlDirectory += "/html";
+	}
+
+	shared_ptr<const FileCache::File> FileCache::Get(const string& virtualFile)
+	{
+		if (virtualFile.find("..") != string::npos)
+		{
+			return nullptr;
+		}
+
+		const string path = htmlDirectory + virtualFile;
+		struct stat fileStat;
+		if (stat(path.c_str(), &fileStat) != 0 || S_ISREG(fileStat.st_mode) == false)
+		{
+			return nullptr;
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			auto it = files.find(virtualFile);
+			if (it != files.end() && it->second->modified == fileStat.st_mtime && it->second->size == fileStat.st_size)
+			{
+				return it->second;
+			}
+		}
+
+		shared_ptr<const File> file = Load(path, virtualFile, fileStat);
+		if (file == nullptr)
+		{
+			return nullptr;
+		}
+		std::lock_guard<std::mutex> guard(mutex);
+		files[virtualFile] = file;
+		return file;
+	}
+
+	shared_ptr<const FileCache::File> FileCache::Load(const string& path, const string& virtualFile, const struct stat& fileStat)
+	{
+		shared_ptr<File> file = std::make_shared<File>();
+		file->path = path;
+		file->modified = fileStat.st_mtime;
+		file->size = fileStat.st_size;
+		file->contentType = ContentType(virtualFile);
+
+		char buffer[64];
+		snprintf(buffer, sizeof(buffer), "\"%lx-%lx\"", static_cast<unsigned long>(fileStat.st_size), static_cast<unsigned long>(fileStat.st_mtime));
+		file->etag = buffer;
+		struct tm tm;
+		gmtime_r(&fileStat.st_mtime, &tm);
+		strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+		file->lastModified = buffer;
+
+		file->cached = fileStat.st_size <= MaxCachedFileSize;
+		if (file->cached == false)
+		{
+			return file;
+		}
+
+		FILE* f = fopen(path.c_str(), "r");
+		if (f == nullptr)
+		{
+			return nullptr;
+		}
+		file->content.resize(fileStat.st_size);
+		const size_t r = fread(&file->content[0], 1, fileStat.st_size, f);
+		fclose(f);
+		if (r != static_cast<size_t>(fileStat.st_size))
+		{
+			return nullptr;
+		}
+
+		if (Compressible(file->contentType) == false)
+		{
+			return file;
+		}
+		file->gzipContent = ZLib::CompressGzip(file->content);
+		if (file->gzipContent.size() >= file->content.size())
+		{
+			file->gzipContent.clear();
+		}
+		return file;
+	}
+
+	const char* FileCache::ContentType(const string& virtualFile)
+	{
+		const size_t dot = virtualFile.rfind('.');
+		if (dot == string::npos)
+		{
+			return nullptr;
+		}
+		const string extension = virtualFile.substr(dot + 1);
+		if (extension.compare("ico") == 0)
+		{
+			return "image/x-icon";
+		}
+		if (extension.compare("css") == 0)
+		{
+			return "text/css";
+		}
+		if (extension.compare("png") == 0)
+		{
+			return "image/png";
+		}
+		if (extension.compare("ttf") == 0)
+		{
+			return "application/x-font-ttf";
+		}
+		if (extension.compare("js") == 0)
+		{
+			return "application/javascript";
+		}
+		if (extension.compare("svg") == 0)
+		{
+			return "image/svg+xml";
+		}
+		return nullptr;
+	}
+
+	bool FileCache::Compressible(const char* contentType)
+	{
+		if (contentType == nullptr)
+		{
+			return false;
+		}
+		const string type(contentType);
+		return type.compare("text/css") == 0
+			|| type.compare("application/javascript") == 0
+			|| type.compare("image/svg+xml") == 0
+			|| type.compare("image/x-icon") == 0;
+	}
+} // namespace WebServer
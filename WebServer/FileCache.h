@@ -0,0 +1,73 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+
+namespace WebServer
+{
+	// Static files of the html directory, kept in memory together with their
+	// validators (ETag, Last-Modified) and a gzip compressed variant.
+	// A file is reloaded if its size or modification time has changed.
+	class FileCache
+	{
+		public:
+			struct File
+			{
+				std::string path;
+				time_t modified;
+				off_t size;
+				const char* contentType;
+				std::string etag;
+				std::string lastModified;
+				// false if the file is too big to be cached, content and gzipContent are empty then
+				bool cached;
+				std::string content;
+				// empty if compression does not pay off
+				std::string gzipContent;
+			};
+
+			static const off_t MaxCachedFileSize = 1024 * 1024;
+
+			FileCache(const FileCache&) = delete;
+			FileCache& operator=(const FileCache&) = delete;
+
+			FileCache();
+
+			// returns nullptr if the file does not exist
+			std::shared_ptr<const File> Get(const std::string& virtualFile);
+
+		private:
+			static const char* ContentType(const std::string& virtualFile);
+			static bool Compressible(const char* contentType);
+			static std::shared_ptr<const File> Load(const std::string& path, const std::string& virtualFile, const struct stat& fileStat);
+
+			std::string htmlDirectory;
+			std::mutex mutex;
+			std::map<std::string,std::shared_ptr<const File>> files;
+	};
+} // namespace WebServer
@@ -18,7 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
+#include <utility>
 
 #include "WebServer/HtmlFullResponse.h"
 
@@ -28,47 +28,31 @@ namespace WebServer
 	:	HtmlResponse(responseCode)
 	{}
 
-	HtmlFullResponse::HtmlFullResponse(const std::string& title, const HtmlTag body)
-	:	HtmlResponse(title, body)
+	HtmlFullResponse::HtmlFullResponse(const std::string& title, HtmlTag body)
+	:	HtmlResponse(title, std::move(body))
 	{}
 
-	HtmlFullResponse::HtmlFullResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body)
-	:	HtmlResponse(responseCode, title, body)
+	HtmlFullResponse::HtmlFullResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body)
+	:	HtmlResponse(responseCode, title, std::move(body))
 	{}
 
-	HtmlFullResponse::operator std::string()
+	size_t HtmlFullResponse::RenderBodySize() const
 	{
-		std::stringstream reply;
-		reply << *this;
-		return reply.str();
+		return content.RenderSize() + title.size() + 512;
 	}
 
-	std::ostream& operator<<(std::ostream& stream, const HtmlFullResponse& response)
+	void HtmlFullResponse::RenderBody(std::string& output) const
 	{
-		stream << "HTTP/1.1 " << response.responseCode << " " << HtmlResponse::responseTexts.at(response.responseCode) << "\r\n";
-		for(auto header : response.headers)
-		{
-			stream << header.first << ": " << header.second << "\r\n";
-		}
-
-		std::stringstream body;
-		body << "<!DOCTYPE html>";
-
+		output += "<!DOCTYPE html><html>";
 		HtmlTag head("head");
-		head.AddChildTag(HtmlTag("title").AddId("title").AddContent(response.title));
+		head.AddChildTag(HtmlTag("title").AddId("title").AddContent(title));
 		head.AddChildTag(HtmlTag("link").AddAttribute("rel", "stylesheet").AddAttribute("type", "text/css").AddAttribute("href", "/style.css"));
 		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/nosleep.js"));
 		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/javascript.js"));
 		head.AddChildTag(HtmlTag("meta").AddAttribute("name", "viewport").AddAttribute("content", "width=device-width, initial-scale=1.0"));
 		head.AddChildTag(HtmlTag("meta").AddAttribute("name", "robots").AddAttribute("content", "noindex,nofollow"));
-
-		body << HtmlTag("html").AddChildTag(head).AddChildTag(response.content);
-
-		std::string bodyString(body.str());
-
-		stream << "Content-Length: " << bodyString.size();
-		stream << "\r\n\r\n";
-		stream << bodyString;
-		return stream;
+		head.Render(output);
+		content.Render(output);
+		output += "</html>";
 	}
 } // namespace WebServer
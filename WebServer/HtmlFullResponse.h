@@ -20,7 +20,6 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
-#include <ostream>
 #include <string>
 
 #include "HtmlResponse.h"
@@ -32,12 +31,13 @@ namespace WebServer
 		public:
 			HtmlFullResponse() = delete;
 			HtmlFullResponse(const ResponseCode responseCode);
-			HtmlFullResponse(const std::string& title, const HtmlTag body);
-			HtmlFullResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body);
+			HtmlFullResponse(const std::string& title, HtmlTag body);
+			HtmlFullResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body);
 			~HtmlFullResponse() {};
-			operator std::string();
 
-			friend std::ostream& operator<<(std::ostream& stream, const HtmlFullResponse& response);
+		protected:
+			size_t RenderBodySize() const override;
+			void RenderBody(std::string& output) const override;
 	};
 } // namespace WebServer
 
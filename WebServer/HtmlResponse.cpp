@@ -18,14 +18,14 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
+#include <utility>
 
 #include "WebServer/HtmlResponse.h"
 
 namespace WebServer
 {
-	HtmlResponse::HtmlResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body)
-	:	Response(responseCode, body),
+	HtmlResponse::HtmlResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body)
+	:	Response(responseCode, std::move(body)),
 	 	title(title)
 	{
 		AddHeader("Cache-Control", "no-cache, must-revalidate");
@@ -42,41 +42,24 @@ namespace WebServer
 
 	void HtmlResponse::AddChildTag(HtmlTag content)
 	{
-		this->content.AddChildTag(content);
+		this->content.AddChildTag(std::move(content));
 	}
 
-	HtmlResponse::operator std::string()
+	size_t HtmlResponse::RenderBodySize() const
 	{
-		std::stringstream reply;
-		reply << *this;
-		return reply.str();
+		return content.RenderSize() + title.size() + 64;
 	}
 
-	std::ostream& operator<<(std::ostream& stream, const HtmlResponse& response)
+	void HtmlResponse::RenderBody(std::string& output) const
 	{
-		stream << "HTTP/1.1 " << response.responseCode << " " << HtmlResponse::responseTexts.at(response.responseCode) << "\r\n";
-		for(auto header : response.headers)
-		{
-			stream << header.first << ": " << header.second << "\r\n";
-		}
-
-		std::stringstream body;
-		body << "<!DOCTYPE html>";
-
-		HtmlTag html("html");
-		if (response.title.length() > 0)
+		output += "<!DOCTYPE html><html>";
+		if (title.length() > 0)
 		{
 			HtmlTag head("head");
-			head.AddChildTag(HtmlTag("title").AddContent(response.title));
-			html.AddChildTag(head);
+			head.AddChildTag(HtmlTag("title").AddContent(title));
+			head.Render(output);
 		}
-		html.AddChildTag(response.content);
-		body << html;
-
-		std::string bodyString(body.str());
-		stream << "Content-Length: " << bodyString.size();
-		stream << "\r\n\r\n";
-		stream << bodyString;
-		return stream;
+		content.Render(output);
+		output += "</html>";
 	}
 } // namespace WebServer
@@ -20,8 +20,8 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
-#include <ostream>
 #include <string>
+#include <utility>
 
 #include "WebServer/Response.h"
 
@@ -35,23 +35,23 @@ namespace WebServer
 			:	HtmlResponse(responseCode, std::to_string(responseCode) + " " + HtmlResponse::responseTexts.at(responseCode), HtmlTag("body"))
 			{}
 
-			HtmlResponse(const HtmlTag body)
-			:	HtmlResponse("", body)
+			HtmlResponse(HtmlTag body)
+			:	HtmlResponse("", std::move(body))
 			{}
 
-			HtmlResponse(const std::string& title, const HtmlTag body)
-			:	HtmlResponse(Response::OK, title, body)
+			HtmlResponse(const std::string& title, HtmlTag body)
+			:	HtmlResponse(Response::OK, title, std::move(body))
 			{}
 
-			HtmlResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body);
+			HtmlResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body);
 			virtual ~HtmlResponse() {};
 			void AddAttribute(const std::string name, const std::string value);
 			void AddChildTag(HtmlTag content);
-			operator std::string();
-
-			friend std::ostream& operator<<(std::ostream& stream, const HtmlResponse& response);
 
 		protected:
+			size_t RenderBodySize() const override;
+			void RenderBody(std::string& output) const override;
+
 			std::string title;
 	};
 } // namespace WebServer
@@ -24,7 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace WebServer
 {
-	HtmlTag HtmlTag::AddAttribute(const std::string& name, const std::string& value)
+	HtmlTag& HtmlTag::AddAttribute(const std::string& name, const std::string& value) &
 	{
 		if (name.size() == 0)
 		{
@@ -34,59 +34,101 @@ namespace WebServer
 		return *this;
 	}
 
-	std::ostream& operator<<(std::ostream& stream, const HtmlTag& tag)
+	bool HtmlTag::IsVoidElement() const
 	{
-		if (tag.name.size() > 0)
+		return childTags.size() == 0 && content.size() == 0 && (
+			name.compare("input") == 0 ||
+			name.compare("link") == 0 ||
+			name.compare("meta") == 0 ||
+			name.compare("br") == 0);
+	}
+
+	size_t HtmlTag::RenderSize() const
+	{
+		size_t size = content.size();
+		if (name.size() > 0)
+		{
+			// <name id="" class=""></name>
+			size += 2 * name.size() + id.size() + 22;
+			for (auto& c : classes)
+			{
+				size += c.size() + 1;
+			}
+			for (auto& attribute : attributes)
+			{
+				size += attribute.first.size() + attribute.second.size() + 4;
+			}
+		}
+		for (auto& child : childTags)
 		{
-			stream << "<" << tag.name;
+			size += child.RenderSize();
+		}
+		return size;
+	}
+
+	void HtmlTag::Render(std::string& output) const
+	{
+		if (name.size() > 0)
+		{
+			output += '<';
+			output += name;
 
-			if (tag.id.size() > 0)
+			if (id.size() > 0)
 			{
-				stream << " id=\"" << tag.id << "\"";
+				output += " id=\"";
+				output += id;
+				output += '"';
 			}
 
-			if (tag.classes.size() > 0)
+			if (classes.size() > 0)
 			{
-				stream << " class=\"";
-				for(auto c : tag.classes)
+				output += " class=\"";
+				for (auto& c : classes)
 				{
-					stream << " " << c;
+					output += ' ';
+					output += c;
 				}
-				stream << "\"";
+				output += '"';
 			}
 
-			for (auto attribute : tag.attributes)
+			for (auto& attribute : attributes)
 			{
-				stream << " " << attribute.first;
+				output += ' ';
+				output += attribute.first;
 				if (attribute.second.size() > 0)
 				{
-					stream << "=" << "\"" << attribute.second << "\"";
+					output += "=\"";
+					output += attribute.second;
+					output += '"';
 				}
 			}
 
-			stream << ">";
+			output += '>';
 
-			if (tag.childTags.size() == 0 && tag.content.size() == 0 && (
-				tag.name.compare("input") == 0 ||
-				tag.name.compare("link") == 0 ||
-				tag.name.compare("meta") == 0 ||
-				tag.name.compare("br") == 0))
+			if (IsVoidElement())
 			{
-				return stream;
+				return;
 			}
 		}
 
-		for (auto child : tag.childTags)
+		for (auto& child : childTags)
 		{
-			stream << child;
+			child.Render(output);
 		}
 
-		stream << tag.content;
+		output += content;
 
-		if (tag.name.size() > 0)
+		if (name.size() > 0)
 		{
-			stream << "</" << tag.name << ">";
+			output += "</";
+			output += name;
+			output += '>';
 		}
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const HtmlTag& tag)
+	{
+		stream << static_cast<std::string>(tag);
 		return stream;
 	}
 } // namespace WebServer
@@ -24,6 +24,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Languages.h"
@@ -42,32 +43,47 @@ namespace WebServer
 			std::string content;
 			std::string id;
 
+			bool IsVoidElement() const;
+
 		public:
 			inline HtmlTag() {}
 			inline HtmlTag(const std::string& name) : name(name) {}
+			inline HtmlTag(const HtmlTag& tag) = default;
+			inline HtmlTag(HtmlTag&& tag) = default;
 			inline virtual ~HtmlTag() {};
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value = "");
+			HtmlTag& operator=(const HtmlTag& tag) = default;
+			HtmlTag& operator=(HtmlTag&& tag) = default;
+
+			// all Add* methods modify the tag in place and return it for chaining
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value = "") &;
 
-			inline virtual HtmlTag AddChildTag(const HtmlTag& child)
+			inline virtual HtmlTag& AddChildTag(const HtmlTag& child) &
 			{
 				this->childTags.push_back(child);
 				return *this;
 			}
 
-			inline virtual HtmlTag AddContent(const std::string& content)
+			// temporaries (also of derived tags) are moved into the tree instead of being copied
+			inline virtual HtmlTag& AddChildTag(HtmlTag&& child) &
+			{
+				this->childTags.push_back(std::move(child));
+				return *this;
+			}
+
+			inline virtual HtmlTag& AddContent(const std::string& content) &
 			{
 				this->content += content;
 				return *this;
 			}
 
 			template<typename... Args>
-			inline HtmlTag AddContent(const Languages::TextSelector text, Args... args)
+			inline HtmlTag& AddContent(const Languages::TextSelector text, Args... args) &
 			{
 				return AddContent(Logger::Logger::Format(Languages::GetText(text), args...));
 			}
 
-			inline virtual HtmlTag AddClass(const std::string& className)
+			inline virtual HtmlTag& AddClass(const std::string& className) &
 			{
 				if (className.length() > 0)
 				{
@@ -76,19 +92,64 @@ namespace WebServer
 				return *this;
 			}
 
-			inline virtual HtmlTag AddId(const std::string& id)
+			inline virtual HtmlTag& AddId(const std::string& id) &
 			{
 				this->id = id;
 				return *this;
 			}
 
+			// called on a temporary the Add* methods return it as rvalue, so a chain
+			// like AddChildTag(HtmlTag("div").AddClass("x")) moves the tag instead of copying it
+			inline HtmlTag&& AddAttribute(const std::string& name, const std::string& value = "") &&
+			{
+				return std::move(AddAttribute(name, value));
+			}
+
+			inline HtmlTag&& AddChildTag(const HtmlTag& child) &&
+			{
+				return std::move(AddChildTag(child));
+			}
+
+			inline HtmlTag&& AddChildTag(HtmlTag&& child) &&
+			{
+				return std::move(AddChildTag(std::move(child)));
+			}
+
+			inline HtmlTag&& AddContent(const std::string& content) &&
+			{
+				return std::move(AddContent(content));
+			}
+
+			template<typename... Args>
+			inline HtmlTag&& AddContent(const Languages::TextSelector text, Args... args) &&
+			{
+				return std::move(AddContent(text, args...));
+			}
+
+			inline HtmlTag&& AddClass(const std::string& className) &&
+			{
+				return std::move(AddClass(className));
+			}
+
+			inline HtmlTag&& AddId(const std::string& id) &&
+			{
+				return std::move(AddId(id));
+			}
+
 			inline virtual size_t ContentSize() const { return content.size(); }
 
+			// upper bound of the size of the rendered tag, used to reserve the output buffer
+			size_t RenderSize() const;
+
+			// appends the rendered tag to output
+			void Render(std::string& output) const;
+
 			inline operator std::string () const
 			{
-				std::stringstream ss;
-				ss << *this;
-				return ss.str();
+				std::string output;
+				output.reserve(RenderSize());
+				Render(output);
+				return output;
 			}
 
 			friend std::ostream& operator<<(std::ostream& stream, const HtmlTag& tag);
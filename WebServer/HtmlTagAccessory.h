@@ -38,7 +38,9 @@ namespace WebServer
 			HtmlTagAccessory(const DataModel::Accessory* accessory);
 			virtual ~HtmlTagAccessory() {}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			using HtmlTag::AddAttribute;
+
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) & override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
@@ -43,13 +43,17 @@ namespace WebServer
 
 			virtual ~HtmlTagButton() {}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			using HtmlTag::AddAttribute;
+
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) & override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
 			}
 
-			virtual HtmlTag AddClass(const std::string& value) override
+			using HtmlTag::AddClass;
+
+			virtual HtmlTag& AddClass(const std::string& value) & override
 			{
 				childTags[0].AddClass(value);
 				return *this;
@@ -49,13 +49,17 @@ namespace WebServer
 
 			virtual ~HtmlTagInputIntegerWithLabel() {}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			using HtmlTag::AddAttribute;
+
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) & override
 			{
 				childTags[1].AddAttribute(name, value);
 				return *this;
 			}
 
-			virtual HtmlTag AddClass(const std::string& _class) override
+			using HtmlTag::AddClass;
+
+			virtual HtmlTag& AddClass(const std::string& _class) & override
 			{
 				childTags[1].AddClass(_class);
 				return *this;
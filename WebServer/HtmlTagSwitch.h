@@ -39,7 +39,9 @@ namespace WebServer
 
 			virtual ~HtmlTagSwitch() {}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			using HtmlTag::AddAttribute;
+
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) & override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
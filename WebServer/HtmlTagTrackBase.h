@@ -32,7 +32,9 @@ namespace WebServer
 	class HtmlTagTrackBase : public HtmlTagLayoutItem
 	{
 		public:
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			using HtmlTag::AddAttribute;
+
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) & override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
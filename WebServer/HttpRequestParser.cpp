@@ -0,0 +1,315 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <strings.h>		// strncasecmp
+
+#include "WebServer/HttpRequestParser.h"
+
+using std::map;
+using std::string;
+
+namespace WebServer
+{
+	const size_t HttpRequestParser::BufferSize;
+	const size_t HttpRequestParser::MaxNrOfHeaders;
+
+	HttpRequestParser::HttpRequestParser()
+	:	used(0),
+		parsed(0),
+		state(StateRequestLine),
+		bodyOffset(0),
+		contentLength(0),
+		formBody(false)
+	{
+		headers.reserve(MaxNrOfHeaders);
+	}
+
+	HttpRequestParser::Result HttpRequestParser::Parse()
+	{
+		while (true)
+		{
+			Slice line;
+			switch (state)
+			{
+				case StateRequestLine:
+					if (NextLine(line) == false)
+					{
+						break;
+					}
+					if (line.length == 0)
+					{
+						// empty lines before a request have to be ignored
+						continue;
+					}
+					state = ParseRequestLine(line) ? StateHeaders : StateError;
+					continue;
+
+				case StateHeaders:
+					if (NextLine(line) == false)
+					{
+						break;
+					}
+					if (line.length == 0)
+					{
+						state = EndOfHeaders() ? StateBody : StateError;
+						continue;
+					}
+					if (ParseHeader(line) == false)
+					{
+						state = StateError;
+					}
+					continue;
+
+				case StateBody:
+					if (used - bodyOffset < contentLength)
+					{
+						return ResultIncomplete;
+					}
+					state = StateComplete;
+					return ResultComplete;
+
+				case StateComplete:
+					return ResultComplete;
+
+				case StateError:
+				default:
+					return ResultError;
+			}
+
+			// no complete line available
+			if (used == BufferSize)
+			{
+				state = StateError;
+				return ResultError;
+			}
+			return ResultIncomplete;
+		}
+	}
+
+	void HttpRequestParser::Next()
+	{
+		const size_t consumed = state == StateComplete ? bodyOffset + contentLength : used;
+		used -= consumed;
+		memmove(buffer, buffer + consumed, used);
+		parsed = 0;
+		state = StateRequestLine;
+		method.clear();
+		target = Slice();
+		protocol = Slice();
+		headers.clear();
+		bodyOffset = 0;
+		contentLength = 0;
+		formBody = false;
+	}
+
+	string HttpRequestParser::GetPath() const
+	{
+		const char* question = static_cast<const char*>(memchr(buffer + target.offset, '?', target.length));
+		const size_t length = question == nullptr ? target.length : question - (buffer + target.offset);
+		return Decode(target.offset, length, false);
+	}
+
+	void HttpRequestParser::GetHeaders(map<string,string>& headersOut) const
+	{
+		for (auto& header : headers)
+		{
+			headersOut[ToString(header.name)] = ToString(header.value);
+		}
+	}
+
+	void HttpRequestParser::GetArguments(map<string,string>& arguments) const
+	{
+		const char* question = static_cast<const char*>(memchr(buffer + target.offset, '?', target.length));
+		if (question != nullptr)
+		{
+			const size_t offset = question + 1 - buffer;
+			ParseUrlEncoded(Slice(offset, target.offset + target.length - offset), false, arguments);
+		}
+		if (formBody)
+		{
+			ParseUrlEncoded(Slice(bodyOffset, contentLength), true, arguments);
+		}
+	}
+
+	bool HttpRequestParser::NextLine(Slice& line)
+	{
+		const char* newLine = static_cast<const char*>(memchr(buffer + parsed, '\n', used - parsed));
+		if (newLine == nullptr)
+		{
+			return false;
+		}
+		line.offset = parsed;
+		line.length = newLine - (buffer + parsed);
+		if (line.length > 0 && buffer[line.offset + line.length - 1] == '\r')
+		{
+			--line.length;
+		}
+		parsed = newLine + 1 - buffer;
+		return true;
+	}
+
+	bool HttpRequestParser::ParseRequestLine(const Slice& line)
+	{
+		const char* start = buffer + line.offset;
+		const char* end = start + line.length;
+		const char* space1 = static_cast<const char*>(memchr(start, ' ', line.length));
+		if (space1 == nullptr || space1 == start)
+		{
+			return false;
+		}
+		const char* space2 = static_cast<const char*>(memchr(space1 + 1, ' ', end - space1 - 1));
+		if (space2 == nullptr || space2 == space1 + 1)
+		{
+			return false;
+		}
+
+		method.assign(start, space1);
+		std::transform(method.begin(), method.end(), method.begin(), ::toupper);
+		target = Slice(space1 + 1 - buffer, space2 - space1 - 1);
+		protocol = Slice(space2 + 1 - buffer, end - space2 - 1);
+		return protocol.length > 7 && strncmp(buffer + protocol.offset, "HTTP/1.", 7) == 0;
+	}
+
+	bool HttpRequestParser::ParseHeader(const Slice& line)
+	{
+		if (headers.size() >= MaxNrOfHeaders)
+		{
+			return false;
+		}
+		const char* start = buffer + line.offset;
+		const char* colon = static_cast<const char*>(memchr(start, ':', line.length));
+		if (colon == nullptr || colon == start)
+		{
+			return false;
+		}
+		const char* valueStart = colon + 1;
+		const char* valueEnd = start + line.length;
+		while (valueStart < valueEnd && (*valueStart == ' ' || *valueStart == '\t'))
+		{
+			++valueStart;
+		}
+		while (valueEnd > valueStart && (valueEnd[-1] == ' ' || valueEnd[-1] == '\t'))
+		{
+			--valueEnd;
+		}
+		Header header;
+		header.name = Slice(line.offset, colon - start);
+		header.value = Slice(valueStart - buffer, valueEnd - valueStart);
+		headers.push_back(header);
+		return true;
+	}
+
+	bool HttpRequestParser::EndOfHeaders()
+	{
+		bodyOffset = parsed;
+		for (auto& header : headers)
+		{
+			if (EqualsIgnoreCase(header.name, "Transfer-Encoding"))
+			{
+				// chunked bodies are not supported
+				return false;
+			}
+			if (EqualsIgnoreCase(header.name, "Content-Type"))
+			{
+				static const char FormType[] = "application/x-www-form-urlencoded";
+				formBody = header.value.length >= sizeof(FormType) - 1
+					&& strncasecmp(buffer + header.value.offset, FormType, sizeof(FormType) - 1) == 0;
+				continue;
+			}
+			if (EqualsIgnoreCase(header.name, "Content-Length") == false)
+			{
+				continue;
+			}
+			contentLength = 0;
+			for (size_t i = 0; i < header.value.length; ++i)
+			{
+				const char c = buffer[header.value.offset + i];
+				if (c < '0' || c > '9' || contentLength > BufferSize)
+				{
+					return false;
+				}
+				contentLength = contentLength * 10 + (c - '0');
+			}
+		}
+		return contentLength <= BufferSize - bodyOffset;
+	}
+
+	bool HttpRequestParser::EqualsIgnoreCase(const Slice& slice, const char* text) const
+	{
+		return strlen(text) == slice.length && strncasecmp(buffer + slice.offset, text, slice.length) == 0;
+	}
+
+	void HttpRequestParser::ParseUrlEncoded(const Slice& slice, const bool plusIsSpace, map<string,string>& arguments) const
+	{
+		size_t position = slice.offset;
+		const size_t end = slice.offset + slice.length;
+		while (position < end)
+		{
+			const char* ampersand = static_cast<const char*>(memchr(buffer + position, '&', end - position));
+			const size_t argumentEnd = ampersand == nullptr ? end : ampersand - buffer;
+			if (argumentEnd > position)
+			{
+				const char* equal = static_cast<const char*>(memchr(buffer + position, '=', argumentEnd - position));
+				const size_t keyEnd = equal == nullptr ? argumentEnd : equal - buffer;
+				const size_t valueStart = equal == nullptr ? argumentEnd : keyEnd + 1;
+				arguments[Decode(position, keyEnd - position, plusIsSpace)] = Decode(valueStart, argumentEnd - valueStart, plusIsSpace);
+			}
+			position = argumentEnd + 1;
+		}
+	}
+
+	string HttpRequestParser::Decode(const size_t offset, const size_t length, const bool plusIsSpace) const
+	{
+		string out;
+		out.reserve(length);
+		const char* in = buffer + offset;
+		for (size_t i = 0; i < length; ++i)
+		{
+			const char c = in[i];
+			if (c == '%' && i + 2 < length)
+			{
+				out += static_cast<char>(ConvertHexToInt(in[i + 1]) * 16 + ConvertHexToInt(in[i + 2]));
+				i += 2;
+				continue;
+			}
+			out += (plusIsSpace && c == '+') ? ' ' : c;
+		}
+		return out;
+	}
+
+	char HttpRequestParser::ConvertHexToInt(const char c)
+	{
+		if (c >= '0' && c <= '9')
+		{
+			return c - '0';
+		}
+		if (c >= 'a' && c <= 'f')
+		{
+			return c - 'a' + 10;
+		}
+		if (c >= 'A' && c <= 'F')
+		{
+			return c - 'A' + 10;
+		}
+		return 0;
+	}
+} // namespace WebServer
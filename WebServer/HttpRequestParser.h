@@ -0,0 +1,133 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace WebServer
+{
+	// Incremental parser of HTTP/1.1 requests. The request is parsed in place in
+	// the buffer of the parser and only the lines received since the last call
+	// are looked at. Data of pipelined requests is kept for the next request.
+	class HttpRequestParser
+	{
+		public:
+			enum Result : unsigned char
+			{
+				ResultIncomplete,
+				ResultComplete,
+				ResultError
+			};
+
+			// maximum size of header and body of one request
+			static const size_t BufferSize = 64 * 1024;
+			static const size_t MaxNrOfHeaders = 64;
+
+			HttpRequestParser(const HttpRequestParser&) = delete;
+			HttpRequestParser& operator=(const HttpRequestParser&) = delete;
+
+			HttpRequestParser();
+
+			// received data has to be written here and committed with Received
+			inline char* FreeSpace() { return buffer + used; }
+			inline size_t FreeSpaceSize() const { return BufferSize - used; }
+			inline void Received(const size_t size) { used += size; }
+
+			// no data of a next request has been received yet
+			inline bool IsEmpty() const { return used == 0; }
+
+			Result Parse();
+
+			// drops the complete request and moves the pipelined data to the front
+			void Next();
+
+			const std::string& GetMethod() const { return method; }
+			std::string GetTarget() const { return ToString(target); }
+			std::string GetPath() const;
+			std::string GetProtocol() const { return ToString(protocol); }
+
+			void GetHeaders(std::map<std::string,std::string>& headers) const;
+
+			// arguments of the query and of an url encoded form body
+			void GetArguments(std::map<std::string,std::string>& arguments) const;
+
+		private:
+			enum State : unsigned char
+			{
+				StateRequestLine,
+				StateHeaders,
+				StateBody,
+				StateComplete,
+				StateError
+			};
+
+			// part of the buffer
+			struct Slice
+			{
+				Slice()
+				:	offset(0),
+					length(0)
+				{}
+
+				Slice(const size_t offset, const size_t length)
+				:	offset(offset),
+					length(length)
+				{}
+
+				size_t offset;
+				size_t length;
+			};
+
+			struct Header
+			{
+				Slice name;
+				Slice value;
+			};
+
+			bool NextLine(Slice& line);
+			bool ParseRequestLine(const Slice& line);
+			bool ParseHeader(const Slice& line);
+			bool EndOfHeaders();
+			bool EqualsIgnoreCase(const Slice& slice, const char* text) const;
+			void ParseUrlEncoded(const Slice& slice, const bool plusIsSpace, std::map<std::string,std::string>& arguments) const;
+			std::string Decode(const size_t offset, const size_t length, const bool plusIsSpace) const;
+			static char ConvertHexToInt(const char c);
+
+			inline std::string ToString(const Slice& slice) const
+			{
+				return std::string(buffer + slice.offset, slice.length);
+			}
+
+			char buffer[BufferSize];
+			size_t used;
+			size_t parsed;
+			State state;
+			std::string method;
+			Slice target;
+			Slice protocol;
+			std::vector<Header> headers;
+			size_t bodyOffset;
+			size_t contentLength;
+			bool formBody;
+	};
+} // namespace WebServer
@@ -18,7 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
+#include <string>
 
 #include "WebServer/Response.h"
 
@@ -26,6 +26,8 @@ namespace WebServer
 {
 	const Response::responseCodeMap Response::responseTexts = {
 		{ Response::OK, "OK" },
+		{ Response::NotModified, "Not Modified" },
+		{ Response::BadRequest, "Bad Request" },
 		{ Response::NotFound, "Not found"},
 		{ Response::NotImplemented, "Not Implemented"}
 	};
@@ -35,22 +37,37 @@ namespace WebServer
 		headers[key] = value;
 	}
 
-	Response::operator std::string()
+	std::string Response::Render() const
 	{
-		std::stringstream reply;
-		reply << *this;
-		return reply.str();
+		std::string output;
+		output.reserve(RenderBodySize() + 512);
+		output += "HTTP/1.1 ";
+		output += std::to_string(responseCode);
+		output += ' ';
+		output += responseTexts.at(responseCode);
+		output += "\r\n";
+		for (auto& header : headers)
+		{
+			output += header.first;
+			output += ": ";
+			output += header.second;
+			output += "\r\n";
+		}
+		const size_t headerEnd = output.size();
+		output += "\r\n";
+		const size_t bodyStart = output.size();
+		RenderBody(output);
+		const size_t bodySize = output.size() - bodyStart;
+		if (bodySize > 0 && headers.count("Content-Length") == 0)
+		{
+			output.insert(headerEnd, "Content-Length: " + std::to_string(bodySize) + "\r\n");
+		}
+		return output;
 	}
 
 	std::ostream& operator<<(std::ostream& stream, const Response& response)
 	{
-		stream << "HTTP/1.1 " << response.responseCode << " " << Response::responseTexts.at(response.responseCode) << "\r\n";
-		for(auto header : response.headers)
-		{
-			stream << header.first << ": " << header.second << "\r\n";
-		}
-		stream << "\r\n";
-		stream << response.content;
+		stream << response.Render();
 		return stream;
 	}
 } // namespace WebServer
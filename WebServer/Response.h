@@ -23,6 +23,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <map>
 #include <ostream>
 #include <string>
+#include <utility>
 
 #include "WebServer/HtmlTag.h"
 
@@ -34,15 +35,21 @@ namespace WebServer
 			enum ResponseCode : unsigned short
 			{
 				OK = 200,
+				NotModified = 304,
+				BadRequest = 400,
 				NotFound = 404,
 				NotImplemented = 501
 			};
 
 			Response() : responseCode(OK) {}
-			Response(const ResponseCode responseCode, const HtmlTag& content) : responseCode(responseCode), content(content) {}
+			Response(const ResponseCode responseCode, HtmlTag content) : responseCode(responseCode), content(std::move(content)) {}
 			virtual ~Response() {};
 			void AddHeader(const std::string& key, const std::string& value);
-			operator std::string();
+
+			// renders header and body into one buffer
+			// Content-Length is added if the body is not empty and the header is not set yet
+			std::string Render() const;
+			operator std::string() const { return Render(); }
 
 			friend std::ostream& operator<<(std::ostream& stream, const Response& response);
 
@@ -53,6 +60,10 @@ namespace WebServer
 
 			std::map<const std::string,std::string> headers;
 			HtmlTag content;
+
+		protected:
+			virtual size_t RenderBodySize() const { return content.RenderSize(); }
+			virtual void RenderBody(std::string& output) const { content.Render(output); }
 	};
 } // namespace WebServer
 
@@ -80,7 +80,10 @@ namespace WebServer
 	WebClient::~WebClient()
 	{
 		run = false;
-		clientThread.join();
+		if (clientThread.joinable())
+		{
+			clientThread.join();
+		}
 		connection->Terminate();
 	}
 
@@ -96,602 +99,258 @@ namespace WebServer
 	void WebClient::WorkerImpl()
 	{
 		run = true;
-		bool keepalive = true;
-
-		while (run && keepalive)
-		{
-			char buffer_in[4096];
-			memset(buffer_in, 0, sizeof(buffer_in));
-
-			size_t pos = 0;
-			string s;
-			while (pos < sizeof(buffer_in) - 1 && s.find("\n\n") == string::npos && run)
-			{
-				size_t ret = connection->Receive(buffer_in + pos, sizeof(buffer_in) - 1 - pos, 0);
-				if (ret == static_cast<size_t>(-1))
-				{
-					if (errno != ETIMEDOUT)
-					{
-						return;
-					}
-					if (run == false)
-					{
-						return;
-					}
-					continue;
-				}
-				pos += ret;
-				s = string(buffer_in);
-				Utils::Utils::ReplaceString(s, string("\r\n"), string("\n"));
-				Utils::Utils::ReplaceString(s, string("\r"), string("\n"));
+		while (run && HandleRequest())
+		{
+		}
+	}
+
+	const WebClient::Command WebClient::commands[] =
+	{
+		{ "accessoryaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleAccessoryAskDelete(arguments); } },
+		{ "accessorydelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleAccessoryDelete(arguments); } },
+		{ "accessoryedit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleAccessoryEdit(arguments); } },
+		{ "accessoryget", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleAccessoryGet(arguments); } },
+		{ "accessorylist", [](WebClient& client, const Arguments&, const Headers&) { client.HandleAccessoryList(); } },
+		{ "accessoryrelease", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleAccessoryRelease(arguments); } },
+		{ "accessorysave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleAccessorySave(arguments); } },
+		{ "accessorystate", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleAccessoryState(arguments); } },
+		{ "booster", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleBooster(arguments); } },
+		{ "clusteraskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.cluster.HandleClusterAskDelete(arguments); } },
+		{ "clusterdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.cluster.HandleClusterDelete(arguments); } },
+		{ "clusteredit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.cluster.HandleClusterEdit(arguments); } },
+		{ "clusterlist", [](WebClient& client, const Arguments&, const Headers&) { client.cluster.HandleClusterList(); } },
+		{ "clustersave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.cluster.HandleClusterSave(arguments); } },
+		{ "controlarguments", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleControlArguments(arguments); } },
+		{ "controlaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleControlAskDelete(arguments); } },
+		{ "controldelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleControlDelete(arguments); } },
+		{ "controledit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleControlEdit(arguments); } },
+		{ "controllist", [](WebClient& client, const Arguments&, const Headers&) { client.HandleControlList(); } },
+		{ "controlsave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleControlSave(arguments); } },
+		{ "feedbackadd", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbackAdd(arguments); } },
+		{ "feedbackaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbackAskDelete(arguments); } },
+		{ "feedbackdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbackDelete(arguments); } },
+		{ "feedbackedit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbackEdit(arguments); } },
+		{ "feedbackget", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbackGet(arguments); } },
+		{ "feedbacklist", [](WebClient& client, const Arguments&, const Headers&) { client.HandleFeedbackList(); } },
+		{ "feedbacksave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbackSave(arguments); } },
+		{ "feedbacksoftrack", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbacksOfTrack(arguments); } },
+		{ "feedbackstate", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleFeedbackState(arguments); } },
+		{ "getcvfields", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleCvFields(arguments); } },
+		{ "layeraskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLayerAskDelete(arguments); } },
+		{ "layerdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLayerDelete(arguments); } },
+		{ "layeredit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLayerEdit(arguments); } },
+		{ "layerlist", [](WebClient& client, const Arguments&, const Headers&) { client.HandleLayerList(); } },
+		{ "layersave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLayerSave(arguments); } },
+		{ "layerselector", [](WebClient& client, const Arguments&, const Headers&) { client.HandleLayerSelector(); } },
+		{ "layout", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLayout(arguments); } },
+		{ "loco", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLoco(arguments); } },
+		{ "locoaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoAskDelete(arguments); } },
+		{ "locodelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoDelete(arguments); } },
+		{ "locoedit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoEdit(arguments); } },
+		{ "locofunction", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoFunction(arguments); } },
+		{ "locolist", [](WebClient& client, const Arguments&, const Headers&) { client.HandleLocoList(); } },
+		{ "locoorientation", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoOrientation(arguments); } },
+		{ "locorelease", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoRelease(arguments); } },
+		{ "locosave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoSave(arguments); } },
+		{ "locoselector", [](WebClient& client, const Arguments&, const Headers&) { client.HandleLocoSelector(); } },
+		{ "locospeed", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleLocoSpeed(arguments); } },
+		{ "program", [](WebClient& client, const Arguments&, const Headers&) { client.HandleProgram(); } },
+		{ "programmodeselector", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleProgramModeSelector(arguments); } },
+		{ "programread", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleProgramRead(arguments); } },
+		{ "programwrite", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleProgramWrite(arguments); } },
+		{ "protocol", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleProtocol(arguments); } },
+		{ "quit", [](WebClient& client, const Arguments&, const Headers&) { client.HandleQuit(); } },
+		{ "relationadd", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRelationAdd(arguments); } },
+		{ "relationobject", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRelationObject(arguments); } },
+		{ "routeaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRouteAskDelete(arguments); } },
+		{ "routedelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRouteDelete(arguments); } },
+		{ "routeedit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRouteEdit(arguments); } },
+		{ "routeexecute", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRouteExecute(arguments); } },
+		{ "routeget", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRouteGet(arguments); } },
+		{ "routelist", [](WebClient& client, const Arguments&, const Headers&) { client.HandleRouteList(); } },
+		{ "routerelease", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRouteRelease(arguments); } },
+		{ "routesave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleRouteSave(arguments); } },
+		{ "settingsedit", [](WebClient& client, const Arguments&, const Headers&) { client.HandleSettingsEdit(); } },
+		{ "settingssave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSettingsSave(arguments); } },
+		{ "signalaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.signal.HandleSignalAskDelete(arguments); } },
+		{ "signaldelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.signal.HandleSignalDelete(arguments); } },
+		{ "signaledit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.signal.HandleSignalEdit(arguments); } },
+		{ "signalget", [](WebClient& client, const Arguments& arguments, const Headers&) { client.signal.HandleSignalGet(arguments); } },
+		{ "signallist", [](WebClient& client, const Arguments&, const Headers&) { client.signal.HandleSignalList(); } },
+		{ "signalrelease", [](WebClient& client, const Arguments& arguments, const Headers&) { client.signal.HandleSignalRelease(arguments); } },
+		{ "signalsave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.signal.HandleSignalSave(arguments); } },
+		{ "signalstate", [](WebClient& client, const Arguments& arguments, const Headers&) { client.signal.HandleSignalState(arguments); } },
+		{ "slaveadd", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSlaveAdd(arguments); } },
+		{ "startall", [](WebClient& client, const Arguments&, const Headers&) { client.manager.LocoStartAll(); } },
+		{ "statistics", [](WebClient& client, const Arguments&, const Headers&) { client.HandleStatistics(); } },
+		{ "stopall", [](WebClient& client, const Arguments&, const Headers&) { client.manager.LocoStopAll(); } },
+		{ "stopallimmediately", [](WebClient& client, const Arguments&, const Headers&) { client.manager.StopAllLocosImmediately(ControlTypeWebserver); } },
+		{ "switchaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchAskDelete(arguments); } },
+		{ "switchdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchDelete(arguments); } },
+		{ "switchedit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchEdit(arguments); } },
+		{ "switchget", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchGet(arguments); } },
+		{ "switchlist", [](WebClient& client, const Arguments&, const Headers&) { client.HandleSwitchList(); } },
+		{ "switchrelease", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchRelease(arguments); } },
+		{ "switchsave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchSave(arguments); } },
+		{ "switchstate", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchState(arguments); } },
+		{ "switchstates", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleSwitchStates(arguments); } },
+		{ "timestamp", [](WebClient& client, const Arguments& arguments, const Headers&) { client.HandleTimestamp(arguments); } },
+		{ "trackaskdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackAskDelete(arguments); } },
+		{ "trackblock", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackBlock(arguments); } },
+		{ "trackdelete", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackDelete(arguments); } },
+		{ "trackedit", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackEdit(arguments); } },
+		{ "trackget", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackGet(arguments); } },
+		{ "tracklist", [](WebClient& client, const Arguments&, const Headers&) { client.track.HandleTrackList(); } },
+		{ "trackorientation", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackOrientation(arguments); } },
+		{ "trackrelease", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackRelease(arguments); } },
+		{ "tracksave", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackSave(arguments); } },
+		{ "tracksetloco", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackSetLoco(arguments); } },
+		{ "trackstartloco", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackStartLoco(arguments); } },
+		{ "trackstoploco", [](WebClient& client, const Arguments& arguments, const Headers&) { client.track.HandleTrackStopLoco(arguments); } },
+		{ "updater", [](WebClient& client, const Arguments&, const Headers& headers) { client.HandleUpdater(headers); } }
+	};
+
+	const unsigned int WebClient::RequestTimeoutMs;
+
+	const size_t WebClient::NrOfCommands = sizeof(WebClient::commands) / sizeof(WebClient::commands[0]);
+
+	const unsigned int WebClient::LatencyBucketLimitsMs[WebClient::NrOfLatencyBuckets - 1] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+
+	WebClient::CommandStatistics WebClient::statistics[sizeof(WebClient::commands) / sizeof(WebClient::commands[0])];
+
+	size_t WebClient::FindCommand(const string& name)
+	{
+		size_t low = 0;
+		size_t high = NrOfCommands;
+		while (low < high)
+		{
+			const size_t middle = (low + high) / 2;
+			const int compare = strcmp(commands[middle].name, name.c_str());
+			if (compare == 0)
+			{
+				return middle;
+			}
+			if (compare < 0)
+			{
+				low = middle + 1;
 			}
-
-			deque<string> lines;
-			Utils::Utils::SplitString(s, string("\n"), lines);
-
-			if (lines.size() <= 1)
+			else
 			{
-				return;
+				high = middle;
 			}
+		}
+		return NrOfCommands;
+	}
 
-			string method;
-			string uri;
-			string protocol;
-			map<string, string> arguments;
-			map<string, string> headers;
-			InterpretClientRequest(lines, method, uri, protocol, arguments, headers);
-			keepalive = (Utils::Utils::GetStringMapEntry(headers, "Connection", "close").compare("keep-alive") == 0);
-			logger->Info(Languages::TextHttpConnectionRequest, id, method, uri);
-
-			// if method is not implemented
-			if ((method.compare("GET") != 0) && (method.compare("HEAD") != 0))
-			{
-				logger->Info(Languages::TextHttpConnectionNotImplemented, id, method);
-				HtmlResponseNotImplemented response(method);
-				connection->Send(response);
-				return;
-			}
+	void WebClient::CountCommand(const size_t command, const std::chrono::steady_clock::duration duration)
+	{
+		const unsigned int durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+		unsigned char bucket = 0;
+		while (bucket < NrOfLatencyBuckets - 1 && durationMs >= LatencyBucketLimitsMs[bucket])
+		{
+			++bucket;
+		}
+		CommandStatistics& commandStatistics = statistics[command];
+		++commandStatistics.requests;
+		++commandStatistics.latency[bucket];
+	}
 
-			// handle requests
-			if (arguments["cmd"].compare("quit") == 0)
+	bool WebClient::HandleRequest()
+	{
+		HttpRequestParser::Result result = parser.Parse();
+		while (result == HttpRequestParser::ResultIncomplete && run)
+		{
+			if (parser.IsEmpty())
 			{
-				ReplyHtmlWithHeaderAndParagraph(Languages::TextStoppingRailControl);
-				stopRailControlWebserver();
+				requestDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(RequestTimeoutMs);
 			}
-			else if (arguments["cmd"].compare("booster") == 0)
+			// in reactor mode the I/O thread only reads what is there, the reactor calls again when more data arrives
+			const int ret = connection->Receive(parser.FreeSpace(), parser.FreeSpaceSize(), ownThread ? 0 : MSG_DONTWAIT);
+			if (ret < 0)
 			{
-				bool on = Utils::Utils::GetBoolMapEntry(arguments, "on");
-				if (on)
+				if (errno != ETIMEDOUT)
 				{
-					ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOn);
-					manager.Booster(ControlTypeWebserver, BoosterStateGo);
+					return false;
 				}
-				else
+				if (ownThread)
 				{
-					ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOff);
-					manager.Booster(ControlTypeWebserver, BoosterStateStop);
+					continue;
 				}
+				if (parser.IsEmpty() == false && std::chrono::steady_clock::now() >= requestDeadline)
+				{
+					logger->Info(Languages::TextHttpConnectionRequestTimeout, id);
+					return false;
+				}
+				return run;
 			}
-			else if (arguments["cmd"].compare("layeredit") == 0)
-			{
-				HandleLayerEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("layersave") == 0)
-			{
-				HandleLayerSave(arguments);
-			}
-			else if (arguments["cmd"].compare("layerlist") == 0)
-			{
-				HandleLayerList();
-			}
-			else if (arguments["cmd"].compare("layeraskdelete") == 0)
-			{
-				HandleLayerAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("layerdelete") == 0)
-			{
-				HandleLayerDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("controledit") == 0)
-			{
-				HandleControlEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("controlsave") == 0)
-			{
-				HandleControlSave(arguments);
-			}
-			else if (arguments["cmd"].compare("controllist") == 0)
-			{
-				HandleControlList();
-			}
-			else if (arguments["cmd"].compare("controlaskdelete") == 0)
-			{
-				HandleControlAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("controldelete") == 0)
-			{
-				HandleControlDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("loco") == 0)
-			{
-				HandleLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("locospeed") == 0)
-			{
-				HandleLocoSpeed(arguments);
-			}
-			else if (arguments["cmd"].compare("locoorientation") == 0)
-			{
-				HandleLocoOrientation(arguments);
-			}
-			else if (arguments["cmd"].compare("locofunction") == 0)
-			{
-				HandleLocoFunction(arguments);
-			}
-			else if (arguments["cmd"].compare("locoedit") == 0)
-			{
-				HandleLocoEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("locosave") == 0)
-			{
-				HandleLocoSave(arguments);
-			}
-			else if (arguments["cmd"].compare("locolist") == 0)
-			{
-				HandleLocoList();
-			}
-			else if (arguments["cmd"].compare("locoaskdelete") == 0)
-			{
-				HandleLocoAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("locodelete") == 0)
-			{
-				HandleLocoDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("locorelease") == 0)
-			{
-				HandleLocoRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryedit") == 0)
-			{
-				HandleAccessoryEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorysave") == 0)
-			{
-				HandleAccessorySave(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorystate") == 0)
-			{
-				HandleAccessoryState(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorylist") == 0)
-			{
-				HandleAccessoryList();
-			}
-			else if (arguments["cmd"].compare("accessoryaskdelete") == 0)
-			{
-				HandleAccessoryAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorydelete") == 0)
-			{
-				HandleAccessoryDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryget") == 0)
-			{
-				HandleAccessoryGet(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryrelease") == 0)
-			{
-				HandleAccessoryRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("switchedit") == 0)
-			{
-				HandleSwitchEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("switchsave") == 0)
-			{
-				HandleSwitchSave(arguments);
-			}
-			else if (arguments["cmd"].compare("switchstate") == 0)
-			{
-				HandleSwitchState(arguments);
-			}
-			else if (arguments["cmd"].compare("switchstates") == 0)
-			{
-				HandleSwitchStates(arguments);
-			}
-			else if (arguments["cmd"].compare("switchlist") == 0)
-			{
-				HandleSwitchList();
-			}
-			else if (arguments["cmd"].compare("switchaskdelete") == 0)
-			{
-				HandleSwitchAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("switchdelete") == 0)
-			{
-				HandleSwitchDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("switchget") == 0)
-			{
-				HandleSwitchGet(arguments);
-			}
-			else if (arguments["cmd"].compare("switchrelease") == 0)
-			{
-				HandleSwitchRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("signaledit") == 0)
-			{
-				signal.HandleSignalEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("signalsave") == 0)
-			{
-				signal.HandleSignalSave(arguments);
-			}
-			else if (arguments["cmd"].compare("signalstate") == 0)
-			{
-				signal.HandleSignalState(arguments);
-			}
-			else if (arguments["cmd"].compare("signallist") == 0)
-			{
-				signal.HandleSignalList();
-			}
-			else if (arguments["cmd"].compare("signalaskdelete") == 0)
-			{
-				signal.HandleSignalAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("signaldelete") == 0)
-			{
-				signal.HandleSignalDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("signalget") == 0)
-			{
-				signal.HandleSignalGet(arguments);
-			}
-			else if (arguments["cmd"].compare("signalrelease") == 0)
-			{
-				signal.HandleSignalRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("routeedit") == 0)
-			{
-				HandleRouteEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("routesave") == 0)
-			{
-				HandleRouteSave(arguments);
-			}
-			else if (arguments["cmd"].compare("routelist") == 0)
-			{
-				HandleRouteList();
-			}
-			else if (arguments["cmd"].compare("routeaskdelete") == 0)
-			{
-				HandleRouteAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("routedelete") == 0)
-			{
-				HandleRouteDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("routeget") == 0)
-			{
-				HandleRouteGet(arguments);
-			}
-			else if (arguments["cmd"].compare("routeexecute") == 0)
-			{
-				HandleRouteExecute(arguments);
-			}
-			else if (arguments["cmd"].compare("routerelease") == 0)
-			{
-				HandleRouteRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("trackedit") == 0)
-			{
-				track.HandleTrackEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("tracksave") == 0)
-			{
-				track.HandleTrackSave(arguments);
-			}
-			else if (arguments["cmd"].compare("tracklist") == 0)
-			{
-				track.HandleTrackList();
-			}
-			else if (arguments["cmd"].compare("trackaskdelete") == 0)
-			{
-				track.HandleTrackAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("trackdelete") == 0)
-			{
-				track.HandleTrackDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("trackget") == 0)
-			{
-				track.HandleTrackGet(arguments);
-			}
-			else if (arguments["cmd"].compare("tracksetloco") == 0)
-			{
-				track.HandleTrackSetLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackrelease") == 0)
-			{
-				track.HandleTrackRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("trackstartloco") == 0)
-			{
-				track.HandleTrackStartLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackstoploco") == 0)
-			{
-				track.HandleTrackStopLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackblock") == 0)
-			{
-				track.HandleTrackBlock(arguments);
-			}
-			else if (arguments["cmd"].compare("trackorientation") == 0)
-			{
-				track.HandleTrackOrientation(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackedit") == 0)
-			{
-				HandleFeedbackEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacksave") == 0)
-			{
-				HandleFeedbackSave(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackstate") == 0)
-			{
-				HandleFeedbackState(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacklist") == 0)
-			{
-				HandleFeedbackList();
-			}
-			else if (arguments["cmd"].compare("feedbackaskdelete") == 0)
-			{
-				HandleFeedbackAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackdelete") == 0)
-			{
-				HandleFeedbackDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackget") == 0)
-			{
-				HandleFeedbackGet(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacksoftrack") == 0)
-			{
-				HandleFeedbacksOfTrack(arguments);
-			}
-			else if (arguments["cmd"].compare("protocol") == 0)
-			{
-				HandleProtocol(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackadd") == 0)
-			{
-				HandleFeedbackAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("relationadd") == 0)
-			{
-				HandleRelationAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("relationobject") == 0)
-			{
-				HandleRelationObject(arguments);
-			}
-			else if (arguments["cmd"].compare("layout") == 0)
-			{
-				HandleLayout(arguments);
-			}
-			else if (arguments["cmd"].compare("locoselector") == 0)
-			{
-				HandleLocoSelector();
-			}
-			else if (arguments["cmd"].compare("layerselector") == 0)
-			{
-				HandleLayerSelector();
-			}
-			else if (arguments["cmd"].compare("stopallimmediately") == 0)
-			{
-				manager.StopAllLocosImmediately(ControlTypeWebserver);
-			}
-			else if (arguments["cmd"].compare("startall") == 0)
-			{
-				manager.LocoStartAll();
-			}
-			else if (arguments["cmd"].compare("stopall") == 0)
-			{
-				manager.LocoStopAll();
-			}
-			else if (arguments["cmd"].compare("settingsedit") == 0)
-			{
-				HandleSettingsEdit();
-			}
-			else if (arguments["cmd"].compare("settingssave") == 0)
-			{
-				HandleSettingsSave(arguments);
-			}
-			else if (arguments["cmd"].compare("slaveadd") == 0)
-			{
-				HandleSlaveAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("timestamp") == 0)
-			{
-				HandleTimestamp(arguments);
-			}
-			else if (arguments["cmd"].compare("controlarguments") == 0)
-			{
-				HandleControlArguments(arguments);
-			}
-			else if (arguments["cmd"].compare("program") == 0)
-			{
-				HandleProgram();
-			}
-			else if (arguments["cmd"].compare("programmodeselector") == 0)
-			{
-				HandleProgramModeSelector(arguments);
-			}
-			else if (arguments["cmd"].compare("programread") == 0)
-			{
-				HandleProgramRead(arguments);
-			}
-			else if (arguments["cmd"].compare("programwrite") == 0)
-			{
-				HandleProgramWrite(arguments);
-			}
-			else if (arguments["cmd"].compare("getcvfields") == 0)
-			{
-				HandleCvFields(arguments);
-			}
-			else if (arguments["cmd"].compare("clusterlist") == 0)
-			{
-				cluster.HandleClusterList();
-			}
-			else if (arguments["cmd"].compare("clusteredit") == 0)
-			{
-				cluster.HandleClusterEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("clustersave") == 0)
-			{
-				cluster.HandleClusterSave(arguments);
-			}
-			else if (arguments["cmd"].compare("clusteraskdelete") == 0)
-			{
-				cluster.HandleClusterAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("clusterdelete") == 0)
-			{
-				cluster.HandleClusterDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("updater") == 0)
-			{
-				HandleUpdater(headers);
-			}
-			else if (uri.compare("/") == 0)
-			{
-				PrintMainHTML();
-			}
-			else
-			{
-				DeliverFile(uri);
-			}
+			parser.Received(ret);
+			result = parser.Parse();
 		}
-	}
 
-	char WebClient::ConvertHexToInt(char c)
-	{
-		if (c >= 'a')
-		{
-			c -= 'a' - 10;
-		}
-		else if (c >= 'A')
-		{
-			c -= 'A' - 10;
-		}
-		else if (c >= '0')
+		// pipelined requests that are already received are handled without waiting
+		bool keepalive = true;
+		while (result == HttpRequestParser::ResultComplete && keepalive && updater == false)
 		{
-			c -= '0';
+			keepalive = HandleParsedRequest();
+			parser.Next();
+			result = parser.Parse();
 		}
 
-		if (c > 15)
+		if (result == HttpRequestParser::ResultError)
 		{
-			return 0;
+			logger->Info(Languages::TextHttpConnectionBadRequest, id);
+			connection->Send(Response(Response::BadRequest, HtmlTag()));
+			return false;
 		}
-
-		return c;
+		return keepalive && run;
 	}
 
-	void WebClient::UrlDecode(string& argumentValue)
+	bool WebClient::HandleParsedRequest()
 	{
-		// decode %20 and similar
-		while (true)
+		const string& method = parser.GetMethod();
+		map<string, string> headers;
+		parser.GetHeaders(headers);
+		const bool keepalive = (Utils::Utils::GetStringMapEntry(headers, "Connection", "close").compare("keep-alive") == 0);
+		logger->Info(Languages::TextHttpConnectionRequest, id, method, parser.GetTarget());
+
+		// if method is not implemented
+		headOnly = method.compare("HEAD") == 0;
+		if ((method.compare("GET") != 0) && (method.compare("POST") != 0) && (headOnly == false))
 		{
-			size_t pos = argumentValue.find('%');
-			if (pos == string::npos || pos + 3 > argumentValue.length())
-			{
-				break;
-			}
-			char c = ConvertHexToInt(argumentValue[pos + 1]) * 16 + ConvertHexToInt(argumentValue[pos + 2]);
-			argumentValue.replace(pos, 3, 1, c);
+			logger->Info(Languages::TextHttpConnectionNotImplemented, id, method);
+			HtmlResponseNotImplemented response(method);
+			connection->Send(response);
+			return false;
 		}
-	}
 
-	void WebClient::InterpretClientRequest(const deque<string>& lines, string& method, string& uri, string& protocol, map<string,string>& arguments, map<string,string>& headers)
-	{
-		if (lines.size() == 0)
+		map<string, string> arguments;
+		parser.GetArguments(arguments);
+		const string uri = parser.GetPath();
+
+		// handle requests
+		auto cmd = arguments.find("cmd");
+		const size_t command = cmd == arguments.end() ? NrOfCommands : FindCommand(cmd->second);
+		if (command < NrOfCommands)
 		{
-			return;
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			commands[command].handler(*this, arguments, headers);
+			CountCommand(command, std::chrono::steady_clock::now() - start);
 		}
-
-		for (auto line : lines)
+		else if (uri.compare("/") == 0)
 		{
-			if (line.find("HTTP/1.") == string::npos)
-			{
-				deque<string> list;
-				Utils::Utils::SplitString(line, string(": "), list);
-				if (list.size() == 2)
-				{
-					headers[list[0]] = list[1];
-				}
-				continue;
-			}
-
-			deque<string> list;
-			Utils::Utils::SplitString(line, string(" "), list);
-			if (list.size() != 3)
-			{
-				continue;
-			}
-
-			method = list[0];
-			// transform method to uppercase
-			std::transform(method.begin(), method.end(), method.begin(), ::toupper);
-
-			// if method == HEAD set membervariable
-			headOnly = method.compare("HEAD") == 0;
-
-			// set uri and protocol
-			uri = list[1];
-			UrlDecode(uri);
-			protocol = list[2];
-
-			// read GET-arguments from uri
-			deque<string> uriParts;
-			Utils::Utils::SplitString(uri, "?", uriParts);
-			if (uriParts.size() != 2)
-			{
-				continue;
-			}
-
-			deque<string> argumentStrings;
-			Utils::Utils::SplitString(uriParts[1], "&", argumentStrings);
-			for (auto argument : argumentStrings)
-			{
-				if (argument.length() == 0)
-				{
-					continue;
-				}
-				string key;
-				string value;
-				Utils::Utils::SplitString(argument, "=", key, value);
-				arguments[key] = value;
-			}
+			PrintMainHTML();
 		}
+		else
+		{
+			DeliverFile(uri, headers);
+		}
+		return keepalive;
 	}
 
-	void WebClient::DeliverFile(const string& virtualFile)
+	void WebClient::DeliverFile(const string& virtualFile, const map<string,string>& headers)
 	{
-		std::stringstream ss;
-		char workingDir[128];
-		if (getcwd(workingDir, sizeof(workingDir)))
-		{
-			ss << workingDir << "/html" << virtualFile;
-		}
-		string sFile = ss.str();
-		const char* realFile = sFile.c_str();
-		FILE* f = fopen(realFile, "r");
-		if (f == nullptr)
+		std::shared_ptr<const FileCache::File> file = server.GetFileCache().Get(virtualFile);
+		if (file == nullptr)
 		{
 			HtmlResponseNotFound response(virtualFile);
 			connection->Send(response);
@@ -699,70 +358,55 @@ namespace WebServer
 			return;
 		}
 
-		DeliverFileInternal(f, realFile, virtualFile);
-		fclose(f);
-	}
+		Response response;
+		response.AddHeader("Cache-Control", "no-cache");
+		response.AddHeader("ETag", file->etag);
+		response.AddHeader("Last-Modified", file->lastModified);
 
-	void WebClient::DeliverFileInternal(FILE* f, const char* realFile, const string& virtualFile)
-	{
-		struct stat s;
-		int rc = stat(realFile, &s);
-		if (rc != 0)
+		const string ifNoneMatch = Utils::Utils::GetStringMapEntry(headers, "If-None-Match");
+		const bool notModified = ifNoneMatch.size() > 0
+			? ifNoneMatch.find(file->etag) != string::npos
+			: Utils::Utils::GetStringMapEntry(headers, "If-Modified-Since").compare(file->lastModified) == 0;
+		if (notModified)
 		{
+			response.responseCode = Response::NotModified;
+			connection->Send(response);
 			return;
 		}
 
-		size_t length = virtualFile.length();
-		const char* contentType = nullptr;
-		if (length > 4 && virtualFile[length - 4] == '.')
+		if (file->contentType != nullptr)
 		{
-			if (virtualFile[length - 3] == 'i' && virtualFile[length - 2] == 'c' && virtualFile[length - 1] == 'o')
-			{
-				contentType = "image/x-icon";
-			}
-			else if (virtualFile[length - 3] == 'c' && virtualFile[length - 2] == 's' && virtualFile[length - 1] == 's')
-			{
-				contentType = "text/css";
-			}
-			else if (virtualFile[length - 3] == 'p' && virtualFile[length - 2] == 'n' && virtualFile[length - 1] == 'g')
-			{
-				contentType = "image/png";
-			}
-			else if (virtualFile[length - 3] == 't' && virtualFile[length - 2] == 't' && virtualFile[length - 1] == 'f')
-			{
-				contentType = "application/x-font-ttf";
-			}
+			response.AddHeader("Content-Type", file->contentType);
 		}
-		else if (length > 3 && virtualFile[length - 3] == '.' && virtualFile[length - 2] == 'j' && virtualFile[length - 1] == 's')
+		if (file->cached == false)
 		{
-			contentType = "application/javascript";
+			response.AddHeader("Content-Length", to_string(file->size));
+			connection->Send(response);
+			if (headOnly == false)
+			{
+				connection->SendFile(file->path, file->size);
+			}
+			return;
 		}
 
-		Response response;
-		response.AddHeader("Cache-Control", "no-cache, must-revalidate");
-		response.AddHeader("Pragma", "no-cache");
-		response.AddHeader("Expires", "Sun, 12 Feb 2016 00:00:00 GMT");
-		response.AddHeader("Content-Length", to_string(s.st_size));
-		if (contentType != nullptr)
+		const bool gzip = file->gzipContent.size() > 0
+			&& Utils::Utils::GetStringMapEntry(headers, "Accept-Encoding").find("gzip") != string::npos;
+		const string& content = gzip ? file->gzipContent : file->content;
+		if (file->gzipContent.size() > 0)
 		{
-			response.AddHeader("Content-Type", contentType);
+			response.AddHeader("Vary", "Accept-Encoding");
 		}
-		connection->Send(response);
-
-		if (headOnly == true)
+		if (gzip)
 		{
-			return;
+			response.AddHeader("Content-Encoding", "gzip");
 		}
-
-		char* buffer = static_cast<char*>(malloc(s.st_size));
-		if (buffer == nullptr)
+		response.AddHeader("Content-Length", to_string(content.size()));
+		string reply = response;
+		if (headOnly == false)
 		{
-			return;
+			reply.append(content);
 		}
-
-		size_t r = fread(buffer, 1, s.st_size, f);
-		connection->Send(buffer, r, 0);
-		free(buffer);
+		connection->Send(reply);
 	}
 
 	HtmlTag WebClient::HtmlTagControlArgument(const unsigned char argNr, const ArgumentType type, const string& value)
@@ -2074,12 +1718,12 @@ namespace WebServer
 			{
 				row.AddChildTag(HtmlTag("td").AddChildTag(HtmlTagButtonCommandWide(Languages::TextRelease, "locorelease_" + locoIdString, locoArgument, "hideElement('b_locorelease_" + locoIdString + "');")));
 			}
-			table.AddChildTag(row);
+			table.AddChildTag(std::move(row));
 		}
-		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(table));
+		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(std::move(table)));
 		content.AddChildTag(HtmlTagButtonCancel());
 		content.AddChildTag(HtmlTagButtonPopupWide(Languages::TextNew, "locoedit_0"));
-		ReplyHtmlWithHeader(content);
+		ReplyHtmlWithHeader(std::move(content));
 	}
 
 	void WebClient::HandleLocoAskDelete(const map<string, string>& arguments)
@@ -2156,7 +1800,7 @@ namespace WebServer
 
 				content.AddChildTag(HtmlTagFeedbackOnControlLayer(feedback.second));
 			}
-			ReplyHtmlWithHeader(content);
+			ReplyHtmlWithHeader(std::move(content));
 			return;
 		}
 
@@ -2220,7 +1864,7 @@ namespace WebServer
 			content.AddChildTag(HtmlTagSignal(manager, signal.second));
 		}
 
-		ReplyHtmlWithHeader(content);
+		ReplyHtmlWithHeader(std::move(content));
 	}
 
 	HtmlTag WebClient::HtmlTagControl(const std::map<ControlID,string>& controls, const ControlID controlID, const string& objectType, const ObjectID objectID)
@@ -3131,6 +2775,7 @@ namespace WebServer
 			}
 		}
 		bool inverted = false;
+		DataModel::FeedbackDebounceTime debounceTime = DataModel::DefaultFeedbackDebounceTime;
 		if (feedbackID > FeedbackNone)
 		{
 			const DataModel::Feedback* feedback = manager.GetFeedback(feedbackID);
@@ -3140,6 +2785,7 @@ namespace WebServer
 				controlId = feedback->GetControlID();
 				pin = feedback->GetPin();
 				inverted = feedback->GetInverted();
+				debounceTime = feedback->GetDebounceTime();
 				visible = feedback->GetVisible();
 				posx = feedback->GetPosX();
 				posy = feedback->GetPosY();
@@ -3166,6 +2812,7 @@ namespace WebServer
 		mainContent.AddChildTag(HtmlTagControlFeedback(controlId, "feedback", feedbackID));
 		mainContent.AddChildTag(HtmlTagInputIntegerWithLabel("pin", Languages::TextPin, pin, 1, 4096));
 		mainContent.AddChildTag(HtmlTagInputCheckboxWithLabel("inverted", Languages::TextInverted, "true", inverted));
+		mainContent.AddChildTag(HtmlTagInputIntegerWithLabel("debouncetime", Languages::TextDebounceTime, debounceTime, 0, DataModel::MaxFeedbackDebounceTime));
 		formContent.AddChildTag(mainContent);
 
 		formContent.AddChildTag(HtmlTagTabPosition(posx, posy, posz, visible));
@@ -3183,12 +2830,17 @@ namespace WebServer
 		ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
 		FeedbackPin pin = static_cast<FeedbackPin>(Utils::Utils::GetIntegerMapEntry(arguments, "pin", FeedbackPinNone));
 		bool inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted");
+		int debounceTime = Utils::Utils::GetIntegerMapEntry(arguments, "debouncetime", DataModel::DefaultFeedbackDebounceTime);
+		if (debounceTime < 0 || debounceTime > DataModel::MaxFeedbackDebounceTime)
+		{
+			debounceTime = DataModel::DefaultFeedbackDebounceTime;
+		}
 		DataModel::LayoutItem::Visible visible = static_cast<Visible>(Utils::Utils::GetBoolMapEntry(arguments, "visible", DataModel::LayoutItem::VisibleNo));
 		LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
 		LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
 		LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
 		string result;
-		if (manager.FeedbackSave(feedbackID, name, visible, posX, posY, posZ, controlId, pin, inverted, result) == FeedbackNone)
+		if (manager.FeedbackSave(feedbackID, name, visible, posX, posY, posZ, controlId, pin, inverted, static_cast<DataModel::FeedbackDebounceTime>(debounceTime), result) == FeedbackNone)
 		{
 			ReplyResponse(ResponseError, result);
 			return;
@@ -3691,25 +3343,23 @@ namespace WebServer
 		}
 
 		unsigned int updateID = Utils::Utils::GetIntegerMapEntry(headers, "Last-Event-ID", 1);
+		if (ownThread == false)
+		{
+			// the update sender of the webserver takes over the connection
+			updater = true;
+			updaterID = updateID;
+			return;
+		}
+
 		while(run)
 		{
-			string s;
-			bool ok = server.NextUpdate(updateID, s);
+			string reply;
+			bool ok = server.NextUpdates(updateID, reply, run);
 			if (ok == false)
 			{
-				// FIXME: use signaling instead of sleep
-				Utils::Utils::SleepForMilliseconds(100);
-				continue;
+				return;
 			}
 
-			string reply("id: ");
-			reply += to_string(updateID);
-			reply += "\r\n";
-			reply += s;
-			reply += "\r\n\r\n";
-
-			++updateID;
-
 			ret = connection->Send(reply);
 			if (ret < 0)
 			{
@@ -3718,9 +3368,105 @@ namespace WebServer
 		}
 	}
 
-	void WebClient::ReplyHtmlWithHeader(const HtmlTag& tag)
+	void WebClient::HandleQuit()
+	{
+		ReplyHtmlWithHeaderAndParagraph(Languages::TextStoppingRailControl);
+		stopRailControlWebserver();
+	}
+
+	void WebClient::HandleBooster(const map<string, string>& arguments)
+	{
+		bool on = Utils::Utils::GetBoolMapEntry(arguments, "on");
+		if (on)
+		{
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOn);
+			manager.Booster(ControlTypeWebserver, BoosterStateGo);
+		}
+		else
+		{
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOff);
+			manager.Booster(ControlTypeWebserver, BoosterStateStop);
+		}
+	}
+
+	void WebClient::HandleStatistics()
+	{
+		HtmlTag content;
+		content.AddChildTag(HtmlTag("h1").AddContent(Languages::TextCommandStatistics));
+		HtmlTag table("table");
+		HtmlTag header("tr");
+		header.AddChildTag(HtmlTag("th").AddContent(Languages::TextCommand));
+		header.AddChildTag(HtmlTag("th").AddContent(Languages::TextRequests));
+		for (unsigned char bucket = 0; bucket < NrOfLatencyBuckets - 1; ++bucket)
+		{
+			header.AddChildTag(HtmlTag("th").AddContent("&lt;" + to_string(LatencyBucketLimitsMs[bucket]) + "ms"));
+		}
+		header.AddChildTag(HtmlTag("th").AddContent("&ge;" + to_string(LatencyBucketLimitsMs[NrOfLatencyBuckets - 2]) + "ms"));
+		table.AddChildTag(std::move(header));
+		for (size_t command = 0; command < NrOfCommands; ++command)
+		{
+			const CommandStatistics& commandStatistics = statistics[command];
+			const unsigned int requests = commandStatistics.requests;
+			if (requests == 0)
+			{
+				continue;
+			}
+			HtmlTag row("tr");
+			row.AddChildTag(HtmlTag("td").AddContent(commands[command].name));
+			row.AddChildTag(HtmlTag("td").AddContent(to_string(requests)));
+			for (unsigned char bucket = 0; bucket < NrOfLatencyBuckets; ++bucket)
+			{
+				row.AddChildTag(HtmlTag("td").AddContent(to_string(commandStatistics.latency[bucket])));
+			}
+			table.AddChildTag(std::move(row));
+		}
+
+		HtmlTag queueTable("table");
+		HtmlTag queueHeader("tr");
+		queueHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextControl));
+		queueHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextQueuedCommands));
+		queueHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextMaxQueuedCommands));
+		queueHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextExecutedCommands));
+		queueHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextCoalescedCommands));
+		queueTable.AddChildTag(std::move(queueHeader));
+		for (auto& controlQueue : manager.ControlQueueStatistics())
+		{
+			HtmlTag row("tr");
+			row.AddChildTag(HtmlTag("td").AddContent(manager.GetControlName(controlQueue.first)));
+			row.AddChildTag(HtmlTag("td").AddContent(to_string(controlQueue.second.depth)));
+			row.AddChildTag(HtmlTag("td").AddContent(to_string(controlQueue.second.maxDepth)));
+			row.AddChildTag(HtmlTag("td").AddContent(to_string(controlQueue.second.executed)));
+			row.AddChildTag(HtmlTag("td").AddContent(to_string(controlQueue.second.coalesced)));
+			queueTable.AddChildTag(std::move(row));
+		}
+
+		HtmlTag controlTable("table");
+		HtmlTag controlHeader("tr");
+		controlHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextControl));
+		controlHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextName));
+		controlHeader.AddChildTag(HtmlTag("th").AddContent(Languages::TextValue));
+		controlTable.AddChildTag(std::move(controlHeader));
+		for (auto& control : manager.ControlStatistics())
+		{
+			const string& controlName = manager.GetControlName(control.first);
+			for (auto& counter : control.second)
+			{
+				HtmlTag row("tr");
+				row.AddChildTag(HtmlTag("td").AddContent(controlName));
+				row.AddChildTag(HtmlTag("td").AddContent(Languages::GetText(counter.first)));
+				row.AddChildTag(HtmlTag("td").AddContent(to_string(counter.second)));
+				controlTable.AddChildTag(std::move(row));
+			}
+		}
+
+		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(std::move(table)).AddChildTag(std::move(queueTable)).AddChildTag(std::move(controlTable)));
+		content.AddChildTag(HtmlTagButtonCancel());
+		ReplyHtmlWithHeader(std::move(content));
+	}
+
+	void WebClient::ReplyHtmlWithHeader(HtmlTag tag)
 	{
-		connection->Send(HtmlResponse(tag));
+		connection->Send(HtmlResponse(std::move(tag)));
 	}
 
 	HtmlTag WebClient::HtmlTagLocoSelector() const
@@ -3838,8 +3584,8 @@ namespace WebServer
 			menuAdd.AddChildTag(HtmlTagButtonPopup("<svg width=\"36\" height=\"36\"><polyline points=\"1,5 35,5\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"1,16 35,16\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"3,3 3,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"6,3 6,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"9,3 9,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"12,3 12,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"15,3 15,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"18,3 18,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"21,3 21,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"24,3 24,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"27,3 27,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"30,3 30,18\" stroke=\"black\" stroke-width=\"1\" /><polyline points=\"33,3 33,18\" stroke=\"black\" stroke-width=\"1\" /><text x=\"3\" y=\"31\" fill=\"black\" >Prog</text></svg>", "program", Languages::TextProgrammer));
 		}
 
-		menu.AddChildTag(menuAdd);
-		body.AddChildTag(menu);
+		menu.AddChildTag(std::move(menuAdd));
+		body.AddChildTag(std::move(menu));
 
 		body.AddChildTag(HtmlTag("div").AddClass("loco_selector").AddId("loco_selector").AddChildTag(HtmlTagLocoSelector()));
 		body.AddChildTag(HtmlTag("div").AddClass("layer_selector").AddId("layer_selector").AddChildTag(HtmlTagLayerSelector()));
@@ -3860,6 +3606,6 @@ namespace WebServer
 			.AddChildTag(HtmlTag("li").AddClass("contextentry").AddContent(Languages::GetText(Languages::TextAddFeedback)).AddAttribute("onClick", "loadPopup('/?cmd=feedbackedit&feedback=0');"))
 			));
 
-		connection->Send(HtmlFullResponse("RailControl", body));
+		connection->Send(HtmlFullResponse("RailControl", std::move(body)));
 	}
 } // namespace WebServer
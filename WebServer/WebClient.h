@@ -20,6 +20,8 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <map>
 #include <string>
@@ -30,6 +32,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/ObjectIdentifier.h"
 #include "Manager.h"
 #include "Network/TcpConnection.h"
+#include "WebServer/HttpRequestParser.h"
 #include "WebServer/HtmlResponse.h"
 #include "WebServer/WebClientCluster.h"
 #include "WebServer/WebClientSignal.h"
@@ -57,34 +60,57 @@ namespace WebServer
 
 			WebClient() = delete;
 
+			// with ownThread == false the requests are handled by the reactor of the webserver
 			inline WebClient(const unsigned int id,
 				Network::TcpConnection* connection,
 				WebServer &webserver,
-				Manager& manager)
+				Manager& manager,
+				const bool ownThread = true)
 			:	logger(Logger::Logger::GetLogger("Webserver")),
 				id(id),
 				connection(connection),
-				run(false),
+				run(!ownThread),
 				server(webserver),
-				clientThread(&WebClient::Worker, this),
 				manager(manager),
 				cluster(manager, *this),
 				track(manager, *this, logger),
 				signal(manager, *this, logger),
 				headOnly(false),
-				buttonID(0)
-			{}
+				buttonID(0),
+				ownThread(ownThread),
+				updater(false),
+				updaterID(0)
+			{
+				if (ownThread)
+				{
+					clientThread = std::thread(&WebClient::Worker, this);
+				}
+			}
 
 			~WebClient();
 
 			void Worker();
 
+			// reads and handles one request, returns true if the connection has to be kept alive
+			bool HandleRequest();
+
+			// reactor mode: a client that does not complete a started request within this time is closed
+			static const unsigned int RequestTimeoutMs = 10000;
+
+			unsigned int GetID() const { return id; }
+
+			Network::TcpConnection* GetConnection() { return connection; }
+
+			// reactor mode: the last request asked for the updates starting with updaterID
+			bool IsUpdater() const { return updater; }
+			unsigned int GetUpdaterID() const { return updaterID; }
+
 			inline void Stop()
 			{
 				run = false;
 			}
 
-			void ReplyHtmlWithHeader(const HtmlTag& tag);
+			void ReplyHtmlWithHeader(HtmlTag tag);
 
 			inline void ReplyResponse(std::string& text)
 			{
@@ -154,11 +180,40 @@ namespace WebServer
 				const bool addDefault = true);
 
 		private:
-			void InterpretClientRequest(const std::deque<std::string>& lines, std::string& method, std::string& uri, std::string& protocol, std::map<std::string,std::string>& arguments, std::map<std::string,std::string>& headers);
+			typedef std::map<std::string,std::string> Arguments;
+			typedef std::map<std::string,std::string> Headers;
+
+			// entry of the dispatch table of the cmd argument
+			struct Command
+			{
+				const char* name;
+				void (*handler)(WebClient& client, const Arguments& arguments, const Headers& headers);
+			};
+
+			static const unsigned char NrOfLatencyBuckets = 11;
+
+			struct CommandStatistics
+			{
+				std::atomic<unsigned int> requests;
+				std::atomic<unsigned int> latency[NrOfLatencyBuckets];
+			};
+
+			// sorted by name, looked up by binary search
+			static const Command commands[];
+			static const size_t NrOfCommands;
+			// upper limits of the latency buckets, the last bucket has no limit
+			static const unsigned int LatencyBucketLimitsMs[NrOfLatencyBuckets - 1];
+			// shared by all clients
+			static CommandStatistics statistics[];
+
+			// returns NrOfCommands if name is not a command
+			static size_t FindCommand(const std::string& name);
+			static void CountCommand(const size_t command, const std::chrono::steady_clock::duration duration);
+
+			bool HandleParsedRequest();
 			void HandleLoco(const std::map<std::string, std::string>& arguments);
 			void PrintMainHTML();
-			void DeliverFile(const std::string& file);
-			void DeliverFileInternal(FILE* f, const char* realFile, const std::string& file);
+			void DeliverFile(const std::string& virtualFile, const std::map<std::string,std::string>& headers);
 			HtmlTag HtmlTagLocoSelector() const;
 			HtmlTag HtmlTagLayerSelector() const;
 			static HtmlTag HtmlTagControlArgument(const unsigned char argNr, const ArgumentType type, const std::string& value);
@@ -304,8 +359,9 @@ namespace WebServer
 			void HandleProgramWrite(const std::map<std::string,std::string>& arguments);
 			void HandleCvFields(const std::map<std::string,std::string>& arguments);
 			void HandleUpdater(const std::map<std::string,std::string>& headers);
-			static void UrlDecode(std::string& argumentValue);
-			static char ConvertHexToInt(char c);
+			void HandleQuit();
+			void HandleBooster(const std::map<std::string,std::string>& arguments);
+			void HandleStatistics();
 			void WorkerImpl();
 
 			Logger::Logger* logger;
@@ -318,8 +374,13 @@ namespace WebServer
 			WebClientCluster cluster;
 			WebClientTrack track;
 			WebClientSignal signal;
+			HttpRequestParser parser;
 			bool headOnly;
 			unsigned int buttonID;
+			const bool ownThread;
+			bool updater;
+			unsigned int updaterID;
+			std::chrono::steady_clock::time_point requestDeadline;
 	};
 
 } // namespace WebServer
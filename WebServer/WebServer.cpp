@@ -48,19 +48,22 @@ using DataModel::TrackBase;
 
 namespace WebServer {
 
-	WebServer::WebServer(Manager& manager, const unsigned short port)
+	const unsigned int WebServer::DefaultMaxUpdates;
+	const unsigned char WebServer::DefaultNrOfIoThreads;
+	const size_t WebServer::MaxUpdateSubscriberBuffer;
+
+	WebServer::WebServer(Manager& manager, const unsigned short port, const unsigned int maxUpdates, const unsigned char nrOfIoThreads)
 	:	ControlInterface(ControlTypeWebserver),
-		Network::TcpServer(port, "WebServer"),
+		Network::TcpServer(port, "WebServer", nrOfIoThreads),
 		run(false),
 		lastClientID(0),
 		manager(manager),
-		updateID(1)
+		maxUpdates(maxUpdates == 0 ? DefaultMaxUpdates : maxUpdates),
+		updates(this->maxUpdates),
+		updateID(0)
 	{
 		Logger::Logger::GetLogger("Webserver")->Info(Languages::TextWebServerStarted);
-		{
-			std::lock_guard<std::mutex> lock(updateMutex);
-			updates[updateID] = GetStatus(Languages::TextRailControlStarted);
-		}
+		AddUpdateInternal(GetStatus(Languages::TextRailControlStarted));
 		run = true;
 	}
 
@@ -70,10 +73,7 @@ namespace WebServer {
 		{
 			return;
 		}
-		{
-			std::lock_guard<std::mutex> lock(updateMutex);
-			updates[++updateID] = GetStatus(Languages::TextStoppingRailControl);
-		}
+		AddUpdateInternal(GetStatus(Languages::TextStoppingRailControl));
 		TerminateTcpServer();
 		Utils::Utils::SleepForSeconds(1);
 		run = false;
@@ -83,6 +83,11 @@ namespace WebServer {
 		{
 			client->Stop();
 		}
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			updateSubscribers.clear();
+			updateAvailable.notify_all();
+		}
 
 		// delete all client memory
 		while (clients.size())
@@ -91,12 +96,69 @@ namespace WebServer {
 			clients.pop_back();
 			delete client;
 		}
+		for (auto reactorClient : reactorClients)
+		{
+			delete reactorClient.second;
+		}
+		reactorClients.clear();
 		Logger::Logger::GetLogger("Webserver")->Info(Languages::TextWebServerStopped);
 	}
 
 	void WebServer::Work(Network::TcpConnection* connection)
 	{
-		clients.push_back(new WebClient(++lastClientID, connection, *this, manager));
+		if (IsReactor() == false)
+		{
+			clients.push_back(new WebClient(++lastClientID, connection, *this, manager));
+			return;
+		}
+
+		WebClient* client = new WebClient(++lastClientID, connection, *this, manager, false);
+		Logger::Logger::GetLogger("Webserver")->Info(Languages::TextHttpConnectionOpen, client->GetID());
+		{
+			std::lock_guard<std::mutex> guard(clientMutex);
+			reactorClients[connection] = client;
+		}
+		Watch(connection);
+	}
+
+	void WebServer::ConnectionReadable(Network::TcpConnection* connection)
+	{
+		WebClient* client;
+		{
+			std::lock_guard<std::mutex> guard(clientMutex);
+			auto it = reactorClients.find(connection);
+			if (it == reactorClients.end())
+			{
+				return;
+			}
+			client = it->second;
+		}
+
+		const bool keepalive = client->HandleRequest();
+		if (client->IsUpdater())
+		{
+			AddUpdateSubscriber(client, client->GetUpdaterID());
+			return;
+		}
+
+		if (keepalive && run)
+		{
+			Watch(connection);
+			return;
+		}
+		CloseClient(client);
+	}
+
+	void WebServer::CloseClient(WebClient* client)
+	{
+		Network::TcpConnection* connection = client->GetConnection();
+		{
+			std::lock_guard<std::mutex> guard(clientMutex);
+			reactorClients.erase(connection);
+		}
+		Logger::Logger::GetLogger("Webserver")->Info(Languages::TextHttpConnectionClose, client->GetID());
+		delete client;
+		CloseConnection(connection);
 	}
 
 	void WebServer::Booster(__attribute__((unused)) const ControlType controlType, const BoosterState status)
@@ -164,6 +226,37 @@ namespace WebServer {
 		AddUpdate(command.str(), state ? Languages::TextFeedbackStateIsOn : Languages::TextFeedbackStateIsOff, name);
 	}
 
+	void WebServer::FeedbackStates(const vector<DataModel::Feedback::StateChange>& changes)
+	{
+		if (changes.size() == 1)
+		{
+			FeedbackState(changes[0].name, changes[0].feedbackID, changes[0].state);
+			return;
+		}
+
+		// one update for all feedbacks, the states are sent as comma separated lists of IDs
+		string on;
+		string off;
+		string names;
+		for (auto& change : changes)
+		{
+			string& ids = change.state ? on : off;
+			if (ids.size() > 0)
+			{
+				ids += ",";
+			}
+			ids += to_string(change.feedbackID);
+			if (names.size() > 0)
+			{
+				names += ", ";
+			}
+			names += change.name;
+		}
+		stringstream command;
+		command << "feedbacks;on=" << on << ";off=" << off;
+		AddUpdate(command.str(), Languages::TextFeedbackStatesAreOn, names);
+	}
+
 	void WebServer::FeedbackSettings(const FeedbackID feedbackID, const std::string& name)
 	{
 		stringstream command;
@@ -420,29 +513,146 @@ namespace WebServer {
 
 	void WebServer::AddUpdate(const string& command, const string& status)
 	{
-		stringstream ss;
-		ss << "data: command=" << command << ";status=" << status << "\r\n\r\n";
-		std::lock_guard<std::mutex> lock(updateMutex);
-		updates[++updateID] = ss.str();
-		updates.erase(updateID - MaxUpdates);
+		AddUpdateInternal("data: command=" + command + ";status=" + status);
+	}
+
+	void WebServer::AddUpdateInternal(const string& s)
+	{
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			updates[++updateID % maxUpdates] = s;
+			if (updateSubscribers.empty() == false)
+			{
+				unsigned int updateIDSubscribers = updateID;
+				string event;
+				AppendUpdatesUnlocked(updateIDSubscribers, event);
+				for (auto& subscriber : updateSubscribers)
+				{
+					UpdateSubscriber& updateSubscriber = subscriber.second;
+					if (updateSubscriber.output.size() + event.size() > MaxUpdateSubscriberBuffer)
+					{
+						updateSubscriber.overflow = true;
+						updateSubscriber.output.clear();
+					}
+					if (updateSubscriber.overflow == false)
+					{
+						updateSubscriber.output.append(event);
+					}
+					ActivateUpdateSubscriberUnlocked(updateSubscriber);
+				}
+			}
+		}
+		updateAvailable.notify_all();
+	}
+
+	bool WebServer::NextUpdates(unsigned int& updateIDClient, string& s, volatile unsigned char& clientRun)
+	{
+		std::unique_lock<std::mutex> lock(updateMutex);
+		while (updateIDClient > updateID)
+		{
+			if (clientRun == false || run == false)
+			{
+				return false;
+			}
+			updateAvailable.wait(lock);
+		}
+		AppendUpdatesUnlocked(updateIDClient, s);
+		return true;
+	}
+
+	void WebServer::AppendUpdatesUnlocked(unsigned int& updateIDClient, string& s)
+	{
+		if (updateIDClient + maxUpdates <= updateID)
+		{
+			// client is too far behind, the oldest updates are lost
+			updateIDClient = updateID - maxUpdates + 1;
+		}
+
+		for (; updateIDClient <= updateID; ++updateIDClient)
+		{
+			s += "id: ";
+			s += to_string(updateIDClient);
+			s += "\r\n";
+			s += updates[updateIDClient % maxUpdates];
+			s += "\r\n\r\n";
+		}
 	}
 
-	bool WebServer::NextUpdate(unsigned int& updateIDClient, string& s)
+	void WebServer::AddUpdateSubscriber(WebClient* client, const unsigned int updateIDClient)
 	{
+		Network::TcpConnection* connection = client->GetConnection();
 		std::lock_guard<std::mutex> lock(updateMutex);
+		UpdateSubscriber& subscriber = updateSubscribers[connection];
+		subscriber.client = client;
+		unsigned int updateIDSubscriber = updateIDClient;
+		if (updateIDSubscriber <= updateID)
+		{
+			AppendUpdatesUnlocked(updateIDSubscriber, subscriber.output);
+			ActivateUpdateSubscriberUnlocked(subscriber);
+		}
+	}
 
-		if (updateIDClient + MaxUpdates <= updateID)
+	void WebServer::ActivateUpdateSubscriberUnlocked(UpdateSubscriber& subscriber)
+	{
+		if (subscriber.active)
 		{
-			updateIDClient = updateID - MaxUpdates + 1;
+			return;
 		}
+		subscriber.active = true;
+		WatchWritable(subscriber.client->GetConnection());
+	}
 
-		if (updates.count(updateIDClient) == 1)
+	void WebServer::ConnectionWritable(Network::TcpConnection* connection)
+	{
+		std::unique_lock<std::mutex> lock(updateMutex);
+		auto it = updateSubscribers.find(connection);
+		if (it == updateSubscribers.end())
+		{
+			return;
+		}
+		UpdateSubscriber& subscriber = it->second;
+		if (subscriber.sent == subscriber.sending.size())
 		{
-			s = updates.at(updateIDClient);
-			return true;
+			subscriber.sending.clear();
+			subscriber.sending.swap(subscriber.output);
+			subscriber.sent = 0;
 		}
 
-		return false;
+		bool ok = subscriber.overflow == false;
+		if (ok && subscriber.sent < subscriber.sending.size())
+		{
+			// entries of the map are not moved, the subscriber is only erased by the I/O thread owning it
+			const char* data = subscriber.sending.c_str() + subscriber.sent;
+			const size_t length = subscriber.sending.size() - subscriber.sent;
+			lock.unlock();
+			const int ret = connection->Send(data, length, MSG_DONTWAIT);
+			lock.lock();
+			ok = ret >= 0;
+			if (ok)
+			{
+				subscriber.sent += ret;
+			}
+		}
+
+		if (ok == false || run == false)
+		{
+			WebClient* client = subscriber.client;
+			if (subscriber.overflow)
+			{
+				Logger::Logger::GetLogger("Webserver")->Warning(Languages::TextHttpConnectionUpdatesOverflow, client->GetID());
+			}
+			updateSubscribers.erase(it);
+			lock.unlock();
+			CloseClient(client);
+			return;
+		}
+
+		if (subscriber.sent < subscriber.sending.size() || subscriber.output.empty() == false)
+		{
+			WatchWritable(connection);
+			return;
+		}
+		subscriber.active = false;
 	}
 
 } // namespace WebServer
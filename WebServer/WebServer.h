@@ -20,9 +20,11 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "ControlInterface.h"
@@ -30,6 +32,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Logger/Logger.h"
 #include "Manager.h"
 #include "Network/TcpServer.h"
+#include "WebServer/FileCache.h"
 
 namespace WebServer
 {
@@ -39,12 +42,23 @@ namespace WebServer
 	{
 		public:
 			WebServer() = delete;
-			WebServer(Manager& manager, const unsigned short port);
+			WebServer(Manager& manager, const unsigned short port, const unsigned int maxUpdates, const unsigned char nrOfIoThreads);
 			~WebServer();
 
 			void Work(Network::TcpConnection* connection) override;
+			void ConnectionReadable(Network::TcpConnection* connection) override;
+			void ConnectionWritable(Network::TcpConnection* connection) override;
 
-			bool NextUpdate(unsigned int& updateIDClient, std::string& s);
+			static const unsigned int DefaultMaxUpdates = 100;
+			static const unsigned char DefaultNrOfIoThreads = 4;
+			// reactor mode: a subscriber with more unsent updates than this is closed
+			static const size_t MaxUpdateSubscriberBuffer = 256 * 1024;
+
+			// waits until there is at least one update newer than updateIDClient or the client is stopped
+			// all pending updates are returned as one string of events, updateIDClient is the next ID to read
+			bool NextUpdates(unsigned int& updateIDClient, std::string& s, volatile unsigned char& clientRun);
+
+			FileCache& GetFileCache() { return fileCache; }
 
 			const std::string GetName() const override { return "Webserver"; }
 			void AccessoryDelete(const AccessoryID accessoryID, const std::string& name) override;
@@ -54,6 +68,7 @@ namespace WebServer
 			void FeedbackDelete(const FeedbackID feedbackID, const std::string& name) override;
 			void FeedbackSettings(const FeedbackID feedbackID, const std::string& name) override;
 			void FeedbackState(const std::string& name, const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state) override;
+			void FeedbackStates(const std::vector<DataModel::Feedback::StateChange>& changes) override;
 			void LayerDelete(const LayerID layerID, const std::string& name) override;
 			void LayerSettings(const LayerID layerID, const std::string& name) override;
 			void LocoDelete(const LocoID locoID, const std::string& name) override;
@@ -87,11 +102,38 @@ namespace WebServer
 			void ProgramValue(const CvNumber cv, const CvValue value) override;
 
 		private:
+			// reactor mode: updates of one SSE client, written by the I/O threads without blocking
+			struct UpdateSubscriber
+			{
+				UpdateSubscriber()
+				:	client(nullptr),
+					sent(0),
+					active(false),
+					overflow(false)
+				{}
+
+				WebClient* client;
+				// appended by AddUpdateInternal
+				std::string output;
+				// only accessed by the I/O thread while active
+				std::string sending;
+				size_t sent;
+				// armed for writing or being written by an I/O thread
+				bool active;
+				bool overflow;
+			};
+
 			template<typename... Args> void AddUpdate(const std::string& command, const Languages::TextSelector text, Args... args)
 			{
 				AddUpdate(command, Logger::Logger::Format(Languages::GetText(text), args...));
 			}
 			void AddUpdate(const std::string& command, const std::string& status);
+			void AddUpdateInternal(const std::string& s);
+			// reactor mode: the updates for this client are sent by the I/O threads from now on
+			void AddUpdateSubscriber(WebClient* client, const unsigned int updateIDClient);
+			void AppendUpdatesUnlocked(unsigned int& updateIDClient, std::string& s);
+			void ActivateUpdateSubscriberUnlocked(UpdateSubscriber& subscriber);
+			void CloseClient(WebClient* client);
 			std::string GetStatus(Languages::TextSelector status) { return updateStatus + Languages::GetText(status); }
 
 			void TrackBaseState(std::stringstream& command, const DataModel::TrackBase* track);
@@ -99,12 +141,18 @@ namespace WebServer
 			volatile bool run;
 			unsigned int lastClientID;
 			std::vector<WebClient*> clients;
+			std::mutex clientMutex;
+			std::map<Network::TcpConnection*,WebClient*> reactorClients;
 			Manager& manager;
+			FileCache fileCache;
 
-			std::map<unsigned int,std::string> updates;
+			// ring buffer, update with ID n is stored at n % maxUpdates
+			const unsigned int maxUpdates;
+			std::vector<std::string> updates;
 			std::mutex updateMutex;
+			std::condition_variable updateAvailable;
 			unsigned int updateID;
-			const unsigned int MaxUpdates = 10;
+			std::map<Network::TcpConnection*,UpdateSubscriber> updateSubscribers;
 			const std::string updateStatus = "data: status=";
 	};
 } // namespace WebServer
@@ -749,6 +749,25 @@ function updateSignal(signalID)
 	requestUpdateLayoutItem(elementName, url);
 }
 
+function updateFeedbackState(feedbackID, on)
+{
+	var element = document.getElementById('f_' + feedbackID);
+	if (!element)
+	{
+		return;
+	}
+	if (on)
+	{
+		element.classList.remove('feedback_free');
+		element.classList.add('feedback_occupied');
+	}
+	else
+	{
+		element.classList.remove('feedback_occupied');
+		element.classList.add('feedback_free');
+	}
+}
+
 function dataUpdate(event)
 {
 	var status = document.getElementById('status');
@@ -933,22 +952,22 @@ function dataUpdate(event)
 	}
 	else if (command == 'feedback')
 	{
-		elementName = 'f_' + argumentMap.get('feedback');
-		var element = document.getElementById(elementName);
-		if (element && argumentMap.has('state'))
+		if (argumentMap.has('state'))
 		{
-			var state = argumentMap.get('state');
-			if (state == 'on')
-			{
-				element.classList.remove('feedback_free');
-				element.classList.add('feedback_occupied');
-			}
-			else
+			updateFeedbackState(argumentMap.get('feedback'), argumentMap.get('state') == 'on');
+		}
+	}
+	else if (command == 'feedbacks')
+	{
+		['on', 'off'].forEach(function(state) {
+			if (!argumentMap.has(state) || argumentMap.get(state).length == 0)
 			{
-				element.classList.remove('feedback_occupied');
-				element.classList.add('feedback_free');
+				return;
 			}
-		}
+			argumentMap.get(state).split(',').forEach(function(feedbackID) {
+				updateFeedbackState(feedbackID, state == 'on');
+			});
+		});
 	}
 	else if (command == 'feedbacksettings')
 	{
@@ -1317,7 +1336,7 @@ function addResponse(response)
 
 function submitEditForm()
 {
-	var url = '/?';
+	var body = '';
 	var form = document.getElementById('editform');
 	var i = 0;
 	while (true)
@@ -1329,17 +1348,17 @@ function submitEditForm()
 		}
 		if (i > 0)
 		{
-			url += '&';
+			body += '&';
 		}
-		url += formElement.name;
-		url += '=';
+		body += encodeURIComponent(formElement.name);
+		body += '=';
 		if (formElement.type == 'checkbox')
 		{
-			url += formElement.checked;
+			body += formElement.checked;
 		}
 		else
 		{
-			url += formElement.value;
+			body += encodeURIComponent(formElement.value);
 		}
 		++i;
 	}
@@ -1351,8 +1370,9 @@ function submitEditForm()
 		}
 		addResponse(xmlHttp.responseText);
 	}
-	xmlHttp.open('GET', url, true);
-	xmlHttp.send(null);
+	xmlHttp.open('POST', '/', true);
+	xmlHttp.setRequestHeader('Content-Type', 'application/x-www-form-urlencoded');
+	xmlHttp.send(body);
 	return false;
 }
 
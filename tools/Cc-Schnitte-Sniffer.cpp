@@ -49,7 +49,7 @@ int main (int argc, char* argv[])
 
 	logger->Debug("Starting CAN bus sniffer");
 
-	Network::Serial serial(logger, "/dev/ttyUSB0", B500000, 8, 'N', 1);
+	Network::Serial serial(logger, ControlNone, "/dev/ttyUSB0", B500000, 8, 'N', 1);
 
 	do
 	{
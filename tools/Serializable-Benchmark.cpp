@@ -0,0 +1,108 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+
+// Compares the former parsing of serialized objects (SplitString into a map)
+// with DataModel::SerializedArguments. Both read the fields of a typical route.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <string>
+
+#include "DataModel/Serializable.h"
+#include "Utils/Utils.h"
+
+using std::deque;
+using std::map;
+using std::string;
+
+static const char* Fields[] = { "objectID", "delay", "lastused", "counter", "posX", "posY", "posZ", "width", "height",
+	"rotation", "locoID", "lockState", "speed", "feedbackIdReduced", "feedbackIdCreep", "feedbackIdStop", "feedbackIdOver",
+	"pushpull", "mintrainlength", "maxtrainlength", "waitafterrelease" };
+
+static int ParseWithMap(const string& serialized)
+{
+	map<string,string> arguments;
+	deque<string> parts;
+	Utils::Utils::SplitString(serialized, ";", parts);
+	for (auto part : parts)
+	{
+		if (part.length() == 0)
+		{
+			continue;
+		}
+		deque<string> keyValue;
+		Utils::Utils::SplitString(part, "=", keyValue);
+		if (keyValue.size() < 2)
+		{
+			continue;
+		}
+		arguments[keyValue[0]] = keyValue[1];
+	}
+
+	int sum = Utils::Utils::GetBoolMapEntry(arguments, "automode") + Utils::Utils::GetStringMapEntry(arguments, "name").length();
+	for (auto field : Fields)
+	{
+		sum += Utils::Utils::GetIntegerMapEntry(arguments, field);
+	}
+	return sum;
+}
+
+static int ParseWithSlices(const string& serialized)
+{
+	DataModel::SerializedArguments arguments(serialized);
+	int sum = arguments.GetBool("automode") + arguments.GetString("name").length();
+	for (auto field : Fields)
+	{
+		sum += arguments.GetInteger(field);
+	}
+	return sum;
+}
+
+template<class Parse>
+static void Measure(const char* name, const string& serialized, const unsigned int rounds, Parse parse)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	volatile int sum = 0;
+	for (unsigned int i = 0; i < rounds; ++i)
+	{
+		sum += parse(serialized);
+	}
+	const double duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	printf("%-8s %8.0f ns per object (checksum %i)\n", name, duration / rounds, static_cast<int>(sum));
+}
+
+int main (int argc, char* argv[])
+{
+	const unsigned int rounds = argc > 1 ? atoi(argv[1]) : 100000;
+	const string serialized = "objectType=Route;objectID=12;name=Station west to track 3;posX=4;posY=7;posZ=0;"
+		"width=1;height=1;rotation=0;visible=1;locoID=0;lockState=0;delay=250;lastused=1603792800;counter=42;"
+		"automode=1;fromTrack=track_5;fromorientation=1;toTrack=track_9;toorientation=0;speed=2;"
+		"feedbackIdReduced=17;feedbackIdCreep=18;feedbackIdStop=19;feedbackIdOver=20;pushpull=0;"
+		"mintrainlength=0;maxtrainlength=120;waitafterrelease=5";
+
+	printf("%u rounds, %zu bytes per object\n", rounds, serialized.length());
+	Measure("map", serialized, rounds, ParseWithMap);
+	Measure("slices", serialized, rounds, ParseWithSlices);
+	return 0;
+}
@@ -0,0 +1,132 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+// Compares the former unbounded queue behind a mutex with Utils::ThreadSafeQueue
+// on the spsc and on the mpmc ring buffer. Producers hand over integers to one consumer.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "Utils/ThreadSafeQueue.h"
+
+// copy of the former Utils::ThreadSafeQueue
+template<class T>
+class MutexQueue
+{
+	public:
+		MutexQueue()
+		:	run(true)
+		{}
+
+		bool Enqueue(T&& t)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			queue.push(t);
+			cv.notify_all();
+			return true;
+		}
+
+		bool Dequeue(T& t)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (queue.empty())
+			{
+				if (run == false)
+				{
+					return false;
+				}
+				cv.wait_for(lock, std::chrono::seconds(1));
+			}
+			t = queue.front();
+			queue.pop();
+			return true;
+		}
+
+	private:
+		std::queue<T> queue;
+		std::mutex mutex;
+		std::condition_variable cv;
+		volatile bool run;
+};
+
+template<class Queue>
+static void Measure(const char* name, Queue& queue, const unsigned int producers, const unsigned int items)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (unsigned int p = 0; p < producers; ++p)
+	{
+		threads.push_back(std::thread([&queue, items, producers]()
+		{
+			for (unsigned int i = 0; i < items / producers; ++i)
+			{
+				queue.Enqueue(static_cast<unsigned int>(i));
+			}
+		}));
+	}
+
+	unsigned long long sum = 0;
+	for (unsigned int i = 0; i < items / producers * producers; ++i)
+	{
+		unsigned int item;
+		queue.Dequeue(item);
+		sum += item;
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	const double duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	printf("%-6s %u producer(s) %8.1f ns per item (checksum %llu)\n", name, producers, duration / items, sum);
+}
+
+int main (int argc, char* argv[])
+{
+	const unsigned int items = argc > 1 ? atoi(argv[1]) : 1000000;
+	const size_t size = 1024;
+	printf("%u items, queue size %zu\n", items, size);
+	{
+		MutexQueue<unsigned int> queue;
+		Measure("mutex", queue, 1, items);
+	}
+	{
+		Utils::ThreadSafeQueue<unsigned int,Utils::SpscRingBuffer<unsigned int>> queue(size, Utils::QueueOverflowBlock);
+		Measure("spsc", queue, 1, items);
+	}
+	{
+		Utils::ThreadSafeQueue<unsigned int> queue(size, Utils::QueueOverflowBlock);
+		Measure("mpmc", queue, 1, items);
+	}
+	{
+		MutexQueue<unsigned int> queue;
+		Measure("mutex", queue, 4, items);
+	}
+	{
+		Utils::ThreadSafeQueue<unsigned int> queue(size, Utils::QueueOverflowBlock);
+		Measure("mpmc", queue, 4, items);
+	}
+	return 0;
+}